@@ -0,0 +1,728 @@
+import * as fs from "fs/promises";
+import { argv } from "process";
+import { Worker } from "worker_threads";
+import * as path from "path";
+import { SQLite, SQLiteNativeModule, yieldMacrotask, SQLiteBridgeChannel, SQLiteBridgeVFS, SQLiteMemoryFile, SQLiteOpenFlags, SQLiteVFSFile, SQLiteFTS5Token, SQLiteDB, loadRTree, searchVectors, searchVectorIndex, SQLiteVectorMatch } from "../src";
+
+type Suite = (args: BenchArgs) => Promise<void>;
+
+interface BenchArgs {
+	rows: number;
+	flavors: string[];
+	// also write the result table to this markdown file
+	out?: string;
+}
+
+// "native" is the Node addon from `make native`, compared on the same workloads
+function flavorFile(flavor: string): string {
+	if (flavor === "native") {
+		return "./sqlite/sqlite3.node";
+	}
+	return flavor === "default" ? "./sqlite/sqlite3.wasm" : `./sqlite/sqlite3.${flavor}.wasm`;
+}
+
+async function loadFlavor(flavor: string): Promise<SQLite | undefined> {
+	const filename = flavorFile(flavor);
+	if (flavor === "native") {
+		try {
+			await fs.access(filename);
+		} catch (e) {
+			console.error(`skipping ${flavor}: ${filename} not built`);
+			return undefined;
+		}
+		return await SQLite.instantiate(SQLiteNativeModule.load(path.resolve(filename)));
+	}
+	let wasm: Buffer;
+	try {
+		wasm = await fs.readFile(filename);
+	} catch (e) {
+		console.error(`skipping ${flavor}: ${filename} not built`);
+		return undefined;
+	}
+	const module = await WebAssembly.compile(wasm);
+	return await SQLite.instantiate(module);
+}
+
+function time(fn: () => void): number {
+	const start = performance.now();
+	fn();
+	return performance.now() - start;
+}
+
+function timeIO(file: SQLiteVFSFile, size: number, iterations: number): [number, number] {
+	const buf = new Uint8Array(size);
+	const write = time(() => {
+		for (let i = 0; i < iterations; i++) {
+			file.write(buf, i * size);
+		}
+	});
+	const read = time(() => {
+		for (let i = 0; i < iterations; i++) {
+			file.read(buf, i * size);
+		}
+	});
+	return [write * 1000 / iterations, read * 1000 / iterations];
+}
+
+async function printTable(rows: Record<string, string | number>[], args?: BenchArgs): Promise<void> {
+	if (rows.length === 0) {
+		return;
+	}
+	const columns = Object.keys(rows[0]);
+	const cells = rows.map((row) => columns.map((c) => {
+		const v = row[c];
+		if (typeof v === "number") {
+			return Number.isInteger(v) ? String(v) : v.toFixed(1);
+		}
+		return v;
+	}));
+	const widths = columns.map((c, i) => Math.max(c.length, ...cells.map((r) => r[i].length)));
+	const line = (r: string[]) => "| " + r.map((v, i) => v.padEnd(widths[i])).join(" | ") + " |";
+	const lines = [line(columns), "|" + widths.map((w) => "-".repeat(w + 2)).join("|") + "|", ...cells.map(line)];
+	console.log(lines.join("\n"));
+	if (args?.out !== undefined) {
+		await fs.writeFile(args.out, lines.join("\n") + "\n");
+	}
+}
+
+const suites: Record<string, Suite> = {
+	// one row per flavor across typical workloads, written to sqlite/flavors.md by `make bench`
+	async flavors(args) {
+		const { rows, flavors } = args;
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			let size: number;
+			try {
+				size = (await fs.stat(flavorFile(flavor))).size;
+			} catch (e) {
+				console.error(`skipping ${flavor}: ${flavorFile(flavor)} not built`);
+				continue;
+			}
+			const start = performance.now();
+			const sqlite = (await loadFlavor(flavor))!;
+			const load = performance.now() - start;
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE t (id INTEGER PRIMARY KEY, k INTEGER, v TEXT)");
+			const insert = time(() => {
+				db.exec("BEGIN");
+				db.prepare("INSERT INTO t (k, v) VALUES (?, ?)", (stmt) => {
+					for (let i = 0; i < rows; i++) {
+						stmt.bindValues([(i * 7919) % rows, `value ${i}`]);
+						stmt.step();
+						stmt.reset();
+					}
+				});
+				db.exec("COMMIT");
+			});
+			const lookups = Math.max(rows >> 2, 1);
+			const point = time(() => {
+				db.prepare("SELECT v FROM t WHERE id = ?", (stmt) => {
+					for (let i = 0; i < lookups; i++) {
+						stmt.bindValues([(i * 31) % rows + 1]);
+						stmt.step();
+						stmt.columnText(0);
+						stmt.reset();
+					}
+				});
+			});
+			const scan = time(() => db.exec("SELECT k % 100, count(*), sum(length(v)) FROM t GROUP BY 1"));
+			const sort = time(() => db.exec("SELECT count(*) FROM (SELECT v FROM t ORDER BY v)"));
+			const index = time(() => db.exec("CREATE INDEX t_k ON t (k)"));
+			db.close();
+			results.push({
+				flavor,
+				"size KB": Math.round(size / 1024),
+				"load ms": load,
+				[`insert ${rows} ms`]: insert,
+				[`${lookups} lookups ms`]: point,
+				"group by ms": scan,
+				"order by ms": sort,
+				"create index ms": index,
+			});
+		}
+		await printTable(results, args);
+	},
+
+	// CREATE INDEX and ORDER BY go through the external sorter. PRAGMA threads only splits it across
+	// threads where SQLite has a thread backend, which no SQLITE_OS_OTHER flavor has, so both rows
+	// of a flavor should match.
+	async sort(args) {
+		const { rows, flavors } = args;
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			for (const threads of [0, 4]) {
+				const db = sqlite.open(":memory:");
+				db.exec(`PRAGMA threads = ${threads}`);
+				db.exec("CREATE TABLE t (k INTEGER, v TEXT)");
+				db.exec(`
+					WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+					INSERT INTO t SELECT random(), hex(randomblob(8)) FROM s
+				`);
+				const createIndex = time(() => db.exec("CREATE INDEX t_k ON t (k)"));
+				const orderBy = time(() => db.exec("SELECT count(*) FROM (SELECT v FROM t ORDER BY v)"));
+				results.push({ flavor, threads, rows, "create index ms": createIndex, "order by ms": orderBy });
+				db.close();
+			}
+		}
+		await printTable(results, args);
+	},
+
+	// text keys with long shared prefixes, so comparisons, copies and lengths dominate
+	async strings(args) {
+		const { rows, flavors } = args;
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE t (k TEXT, v BLOB)");
+			db.exec(`
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+				INSERT INTO t SELECT printf('%.64c', 'k') || hex(randomblob(8)), randomblob(256) FROM s
+			`);
+			const createIndex = time(() => db.exec("CREATE INDEX t_k ON t (k)"));
+			const lookup = time(() => db.exec(`SELECT count(*) FROM t WHERE k > printf('%.64c', 'k') || '8'`));
+			const length = time(() => db.exec("SELECT sum(length(k)), sum(length(v)) FROM t"));
+			const vacuum = time(() => db.exec("VACUUM"));
+			const text = time(() => {
+				db.prepare("SELECT k FROM t", (stmt) => {
+					while (stmt.step()) {
+						stmt.columnText(0);
+					}
+				});
+			});
+			results.push({
+				flavor,
+				rows,
+				"create index ms": createIndex,
+				"range count ms": lookup,
+				"length ms": length,
+				"vacuum ms": vacuum,
+				"column text ms": text,
+			});
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// event loop lag while a long statement runs, with step() and with stepAsync()
+	async slice(args) {
+		const { rows, flavors } = args;
+		const results: Record<string, string | number>[] = [];
+		const sql = `
+			WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+			SELECT sum(length(hex(randomblob(16)))) FROM s GROUP BY i % 10 ORDER BY 1
+		`;
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			for (const mode of ["step", "stepAsync"]) {
+				const lags: number[] = [];
+				let expected = performance.now() + 1;
+				const timer = setInterval(() => {
+					const now = performance.now();
+					lags.push(Math.max(now - expected, 0));
+					expected = now + 1;
+				}, 1);
+				await yieldMacrotask();
+				const stmt = db.prepare(sql)!;
+				const elapsed = performance.now();
+				if (mode === "step") {
+					while (stmt.step()) {
+						// drain
+					}
+				} else {
+					while (await stmt.stepAsync({ sliceMs: 5 })) {
+						// drain
+					}
+				}
+				const total = performance.now() - elapsed;
+				stmt.finalize();
+				await yieldMacrotask();
+				clearInterval(timer);
+				lags.sort((a, b) => a - b);
+				results.push({
+					flavor,
+					mode,
+					"asyncify": sqlite.asyncify === undefined ? "no" : "yes",
+					"total ms": total,
+					"max lag ms": lags[lags.length - 1] ?? total,
+					"p99 lag ms": lags[Math.floor(lags.length * 0.99)] ?? total,
+				});
+			}
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// a result set as JSON text from sqlite3_ext_stmt_json against row objects and JSON.stringify,
+	// and JSON columns parsed eagerly against SQLiteJSON
+	async json(args) {
+		const { rows, flavors } = args;
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE t (id INTEGER PRIMARY KEY, name TEXT, score REAL, data JSON)");
+			db.exec(`
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+				INSERT INTO t SELECT i, 'name ' || i, i / 7.0, json_object('i', i, 'tags', json_array('a', 'b')) FROM s
+			`);
+			let length = 0;
+			const stringify = time(() => {
+				db.prepare("SELECT * FROM t", (stmt) => {
+					const out: Record<string, unknown>[] = [];
+					const names = Array.from({ length: stmt.columnCount() }, (_, i) => stmt.columnName(i));
+					while (stmt.step()) {
+						const row: Record<string, unknown> = {};
+						const values = stmt.columns(true);
+						names.forEach((name, i) => row[name] = name === "data" ? JSON.parse(values[i] as string) : values[i]);
+						out.push(row);
+					}
+					length = JSON.stringify(out).length;
+				});
+			});
+			const native = time(() => {
+				db.prepare("SELECT * FROM t", (stmt) => {
+					length = stmt.resultJSON().length;
+				});
+			});
+			const lazy = time(() => {
+				db.prepare("SELECT * FROM t", (stmt) => {
+					while (stmt.step()) {
+						stmt.columns(true, true);
+					}
+				});
+			});
+			results.push({
+				flavor,
+				rows,
+				"JSON MB": length / 1e6,
+				"stringify rows ms": stringify,
+				"resultJSON ms": native,
+				"lazy columns ms": lazy,
+			});
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// a join on a skewed key after SQLiteDB.scheduleMaintenance analyzed the tables, flavors with
+	// STAT4 such as full see that one key value covers half of the rows
+	async planner(args) {
+		const { rows } = args;
+		const flavors = args.flavors.length === 1 && args.flavors[0] === "default" ? ["default", "full"] : args.flavors;
+		const results: Record<string, string | number>[] = [];
+		const sql = "SELECT count(*) FROM t JOIN u ON u.id = t.b WHERE t.a = 0 AND t.b = 5";
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			const maintenance = db.scheduleMaintenance({ idleMs: 0, bulkChanges: 0 });
+			db.exec(`
+				CREATE TABLE t (a INTEGER, b INTEGER);
+				CREATE INDEX t_a ON t (a);
+				CREATE INDEX t_b ON t (b);
+				CREATE TABLE u (id INTEGER PRIMARY KEY, v TEXT);
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+				INSERT INTO t SELECT CASE WHEN i % 2 = 0 THEN 0 ELSE i END, i % 1000 FROM s;
+				WITH RECURSIVE s(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM s WHERE i < 999)
+				INSERT INTO u SELECT i, 'v' FROM s;
+			`);
+			const analyze = time(() => maintenance.afterBulkLoad(["t", "u"]));
+			const plan = db.exec(`EXPLAIN QUERY PLAN ${sql}`).map((row) => row[3].value).join("; ");
+			const query = time(() => {
+				for (let i = 0; i < 20; i++) {
+					db.exec(sql);
+				}
+			}) / 20;
+			results.push({ flavor, rows, "analyze ms": analyze, "query ms": query, plan });
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// median, percentile and sqrt aggregates in SQL with the ext/misc bundle against fetching the
+	// rows and computing them in JS, on the full flavor
+	async analytics(args) {
+		const { rows } = args;
+		// the default flavor has no ext/misc functions
+		const flavors = args.flavors.map((flavor) => flavor === "default" ? "full" : flavor);
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE t (g INTEGER, v REAL)");
+			db.exec(`
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+				INSERT INTO t SELECT i % 100, abs(random() % 100000) / 100.0 FROM s
+			`);
+			const inSQL = time(() => db.exec("SELECT g, median(v), percentile(v, 99), sqrt(avg(v * v)) FROM t GROUP BY g"));
+			const inJS = time(() => {
+				const groups = new Map<number, number[]>();
+				db.prepare("SELECT g, v FROM t", (stmt) => {
+					while (stmt.step()) {
+						const g = stmt.columnInt(0);
+						let values = groups.get(g);
+						if (values === undefined) {
+							values = [];
+							groups.set(g, values);
+						}
+						values.push(stmt.columnDouble(1));
+					}
+				});
+				for (const values of groups.values()) {
+					values.sort((a, b) => a - b);
+					const at = (p: number) => {
+						const ix = (values.length - 1) * p;
+						const i = Math.floor(ix);
+						return values[i] + ((values[Math.min(i + 1, values.length - 1)] - values[i]) * (ix - i));
+					};
+					at(0.5);
+					at(0.99);
+					Math.sqrt(values.reduce((sum, v) => sum + v * v, 0) / values.length);
+				}
+			});
+			results.push({ flavor, rows, "SQL ms": inSQL, "fetch and JS ms": inJS });
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// approx_count_distinct and approx_percentile against COUNT(DISTINCT) and the exact median,
+	// and merging per group sketches against scanning the table again, on the full flavor
+	async sketch(args) {
+		const { rows } = args;
+		// the default flavor has no sketch aggregates
+		const flavors = args.flavors.map((flavor) => flavor === "default" ? "full" : flavor);
+		const results: Record<string, string | number>[] = [];
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE t (g INTEGER, k INTEGER, v REAL)");
+			db.exec(`
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < ${rows})
+				INSERT INTO t SELECT i % 100, abs(random() % ${rows}), abs(random() % 100000) / 100.0 FROM s
+			`);
+			const value = (sql: string) => Number(db.exec(sql)[0][0].value);
+			let exactDistinct = 0;
+			let approxDistinct = 0;
+			let exactMedian = 0;
+			let approxMedian = 0;
+			const distinct = time(() => exactDistinct = value("SELECT count(DISTINCT k) FROM t"));
+			const hll = time(() => approxDistinct = value("SELECT approx_count_distinct(k) FROM t"));
+			const median = time(() => exactMedian = value("SELECT median(v) FROM t"));
+			const digest = time(() => approxMedian = value("SELECT approx_percentile(v, 0.5) FROM t"));
+			db.exec("CREATE TABLE rollup AS SELECT g, hll_sketch(k) AS hll, tdigest_sketch(v) AS digest FROM t GROUP BY g");
+			const merge = time(() => db.exec("SELECT hll_count(hll_merge(hll)), tdigest_percentile(tdigest_merge(digest), 0.5) FROM rollup"));
+			results.push({
+				flavor,
+				rows,
+				"count(DISTINCT) ms": distinct,
+				"approx_count_distinct ms": hll,
+				"distinct error %": (Math.abs(approxDistinct - exactDistinct) / exactDistinct * 100).toFixed(2),
+				"median ms": median,
+				"approx_percentile ms": digest,
+				"median error %": (Math.abs(approxMedian - exactMedian) / exactMedian * 100).toFixed(2),
+				"merge 100 sketches ms": merge,
+			});
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// k nearest float32 vectors of 128 dimensions by fetching every row and scoring in JS, with the
+	// vec_topk scan and with a trained vec_ivf index, on the full flavor
+	async vectors(args) {
+		const { rows } = args;
+		// the default flavor has no vector search
+		const flavors = args.flavors.map((flavor) => flavor === "default" ? "full" : flavor);
+		const results: Record<string, string | number>[] = [];
+		const dimensions = 128;
+		const k = 10;
+		let seed = 1;
+		const random = () => (seed = seed * 48271 % 0x7fffffff) / 0x7fffffff - 0.5;
+		// clustered like embeddings tend to be, uniform noise has no structure for the index to find
+		const centers = Array.from({ length: 64 }, () => Float32Array.from({ length: dimensions }, random));
+		const vectors = Array.from({ length: rows }, (_, i) => centers[i % centers.length].map((x) => x + random() / 4));
+		const queries = vectors.slice(0, 20);
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			const lists = Math.max(1, Math.round(Math.sqrt(rows)));
+			db.exec(`CREATE TABLE docs (id INTEGER PRIMARY KEY, embedding BLOB);
+				CREATE VIRTUAL TABLE items USING vec_ivf(dimensions=${dimensions}, lists=${lists})`);
+			db.exec("BEGIN");
+			const insert = time(() => db.prepare("INSERT INTO docs VALUES (?, ?)", (stmt) => {
+				vectors.forEach((vector, i) => {
+					stmt.bindInt(1, i + 1);
+					stmt.bindFloat32Array(2, vector);
+					stmt.step();
+					stmt.reset();
+				});
+			}));
+			const index = time(() => {
+				db.exec("INSERT INTO items(rowid, vector) SELECT id, embedding FROM docs; INSERT INTO items(items) VALUES ('train')");
+			});
+			db.exec("COMMIT");
+			const inJS = time(() => {
+				for (const query of queries.slice(0, 5)) {
+					const scores: { id: number, distance: number }[] = [];
+					db.prepare("SELECT id, embedding FROM docs", (stmt) => {
+						while (stmt.step()) {
+							const vector = stmt.columnFloat32Array(1);
+							let sum = 0;
+							for (let i = 0; i < dimensions; i++) {
+								sum += (vector[i] - query[i]) ** 2;
+							}
+							scores.push({ id: stmt.columnInt(0), distance: Math.sqrt(sum) });
+						}
+					});
+					scores.sort((a, b) => a.distance - b.distance).slice(0, k);
+				}
+			}) / 5;
+			let exact: SQLiteVectorMatch[][] = [];
+			let approximate: SQLiteVectorMatch[][] = [];
+			const scan = time(() => exact = queries.map((query) => searchVectors(db, "docs", "embedding", query, { k }))) / queries.length;
+			const ivf = time(() => approximate = queries.map((query) => searchVectorIndex(db, "items", query, { k }))) / queries.length;
+			let found = 0;
+			exact.forEach((matches, q) => {
+				const ids = new Set(approximate[q].map((m) => m.rowid));
+				found += matches.filter((m) => ids.has(m.rowid)).length;
+			});
+			results.push({
+				flavor,
+				rows,
+				"insert ms": insert,
+				"index and train ms": index,
+				"fetch and JS ms/query": inJS,
+				"vec_topk ms/query": scan,
+				"vec_ivf ms/query": ivf,
+				"vec_ivf recall": (found / (queries.length * k)).toFixed(2),
+			});
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// FTS5 index builds and MATCH queries per tokenizer against a LIKE scan, on the full flavor
+	// with a synthetic corpus of rows documents, for example `fts5 --rows 100000 --flavors full`
+	async fts5(args) {
+		const { rows } = args;
+		// the default flavor has no FTS5
+		const flavors = args.flavors.map((flavor) => flavor === "default" ? "full" : flavor);
+		const results: Record<string, string | number>[] = [];
+		// a skewed vocabulary, so queries hit both common and rare terms
+		const vocabulary = Array.from({ length: 5000 }, (_, i) => `w${(i * 2654435761 % 0xffffff).toString(36)}`);
+		let seed = 1;
+		const random = () => (seed = seed * 48271 % 0x7fffffff) / 0x7fffffff;
+		const word = () => vocabulary[Math.floor(vocabulary.length * random() ** 3)];
+		const corpus = Array.from({ length: rows }, () => Array.from({ length: 24 }, word).join(" "));
+		const bytes = corpus.reduce((n, doc) => n + doc.length, 0);
+		const queries = Array.from({ length: 200 }, () => `${word()} ${word()}`);
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE plain (body TEXT)");
+			db.exec("BEGIN");
+			db.prepare("INSERT INTO plain (body) VALUES (?)", (stmt) => {
+				for (const doc of corpus) {
+					stmt.bindText(1, doc);
+					stmt.step();
+					stmt.reset();
+				}
+			});
+			db.exec("COMMIT");
+			const scans = 10;
+			const like = time(() => {
+				db.prepare("SELECT count(*) FROM plain WHERE body LIKE ? AND body LIKE ?", (stmt) => {
+					for (const query of queries.slice(0, scans)) {
+						const [a, b] = query.split(" ");
+						stmt.bindText(1, `%${a}%`);
+						stmt.bindText(2, `%${b}%`);
+						stmt.step();
+						stmt.reset();
+					}
+				});
+			});
+			db.createTokenizer("js", (text) => {
+				const tokens: SQLiteFTS5Token[] = [];
+				for (const m of text.matchAll(/\w+/g)) {
+					tokens.push({ term: m[0].toLowerCase(), start: m.index!, end: m.index! + m[0].length });
+				}
+				return tokens;
+			});
+			for (const tokenize of ["unicode61", "porter unicode61", "trigram", "js"]) {
+				db.exec("DROP TABLE IF EXISTS docs");
+				db.exec(`CREATE VIRTUAL TABLE docs USING fts5(body, tokenize = '${tokenize}')`);
+				const build = time(() => db.exec("INSERT INTO docs (rowid, body) SELECT rowid, body FROM plain"));
+				const match = time(() => {
+					db.prepare("SELECT count(*) FROM docs WHERE docs MATCH ?", (stmt) => {
+						for (const query of queries) {
+							stmt.bindText(1, query);
+							stmt.step();
+							stmt.reset();
+						}
+					});
+				});
+				results.push({
+					flavor,
+					tokenize,
+					docs: rows,
+					"build docs/s": rows / build * 1000,
+					"build MB/s": bytes / build / 1000,
+					"match q/s": queries.length / match * 1000,
+					"like scan q/s": scans / like * 1000,
+				});
+			}
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// small-box queries on an R*Tree against the min/max table scan, and loadRTree against one
+	// INSERT per row from JS, on the full flavor
+	async rtree(args) {
+		const { rows } = args;
+		// the default flavor has no R*Tree
+		const flavors = args.flavors.map((flavor) => flavor === "default" ? "full" : flavor);
+		const results: Record<string, string | number>[] = [];
+		const boxes = new Float64Array(rows * 5);
+		for (let i = 0; i < rows; i++) {
+			const x = Math.random() * 1000;
+			const y = Math.random() * 1000;
+			boxes.set([i + 1, x, x + Math.random(), y, y + Math.random()], i * 5);
+		}
+		const queries = 1000;
+		const query = "WHERE maxX >= ?1 AND minX <= ?1 + 10 AND maxY >= ?2 AND minY <= ?2 + 10";
+		const run = (db: SQLiteDB, table: string, count: number) => time(() => {
+			db.prepare(`SELECT count(*) FROM ${table} ${query}`, (stmt) => {
+				for (let i = 0; i < count; i++) {
+					stmt.bindDouble(1, Math.random() * 990);
+					stmt.bindDouble(2, Math.random() * 990);
+					stmt.step();
+					stmt.reset();
+				}
+			});
+		}) * 1000 / count;
+		for (const flavor of flavors) {
+			const sqlite = await loadFlavor(flavor);
+			if (sqlite === undefined) {
+				continue;
+			}
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE plain (id INTEGER PRIMARY KEY, minX REAL, maxX REAL, minY REAL, maxY REAL)");
+			db.exec("CREATE VIRTUAL TABLE tree USING rtree(id, minX, maxX, minY, maxY)");
+			db.exec("CREATE VIRTUAL TABLE rows USING rtree(id, minX, maxX, minY, maxY)");
+			const bulk = time(() => loadRTree(db, "tree", boxes, 2));
+			const perRow = time(() => {
+				db.exec("BEGIN");
+				db.prepare("INSERT INTO rows VALUES (?, ?, ?, ?, ?)", (stmt) => {
+					for (let i = 0; i < rows; i++) {
+						stmt.bindInt(1, boxes[i * 5]);
+						for (let j = 1; j < 5; j++) {
+							stmt.bindDouble(j + 1, boxes[i * 5 + j]);
+						}
+						stmt.step();
+						stmt.reset();
+					}
+				});
+				db.exec("COMMIT");
+			});
+			db.exec("INSERT INTO plain SELECT * FROM tree");
+			results.push({
+				flavor,
+				rows,
+				"loadRTree ms": bulk,
+				"insert per row ms": perRow,
+				"scan query us": run(db, "plain", 10),
+				"rtree query us": run(db, "tree", queries),
+			});
+			db.close();
+		}
+		await printTable(results, args);
+	},
+
+	// round trip latency of SQLiteBridgeVFS against calling a file directly
+	async bridge(args) {
+		const iterations = 2000;
+		const channel = SQLiteBridgeChannel.create();
+		const host = new Worker("./scripts/bridge-host.ts", { workerData: { channel: channel.buffer } });
+		await new Promise((resolve) => host.once("message", resolve));
+		const vfs = new SQLiteBridgeVFS(channel.buffer);
+		const results: Record<string, string | number>[] = [];
+		for (const size of [512, 4096, 16384, 65536]) {
+			const direct = timeIO(new SQLiteMemoryFile(), size, iterations);
+			const file = vfs.open(`bench-${size}`, SQLiteOpenFlags.SQLITE_OPEN_MAIN_DB);
+			const bridged = timeIO(file, size, iterations);
+			file.close();
+			results.push({
+				"io size": size,
+				"direct write us": direct[0],
+				"direct read us": direct[1],
+				"bridge write us": bridged[0],
+				"bridge read us": bridged[1],
+				"bridge read MB/s": size / bridged[1],
+			});
+		}
+		await printTable(results, args);
+		await host.terminate();
+	},
+};
+
+function parseArgs(args: string[]): [string, BenchArgs] {
+	const bench: BenchArgs = { rows: 1000000, flavors: ["default"] };
+	let suite = "sort";
+	for (let i = 0; i < args.length; i++) {
+		switch (args[i]) {
+			case "--rows":
+				bench.rows = Number(args[++i]);
+				break;
+			case "--flavors":
+				bench.flavors = args[++i].split(",");
+				break;
+			case "--out":
+				bench.out = args[++i];
+				break;
+			default:
+				suite = args[i];
+		}
+	}
+	return [suite, bench];
+}
+
+async function main() {
+	const [suite, args] = parseArgs(argv.slice(2));
+	if (suites[suite] === undefined) {
+		throw new Error(`unknown suite ${suite}, expected one of ${Object.keys(suites).join(", ")}`);
+	}
+	await suites[suite](args);
+}
+
+main();
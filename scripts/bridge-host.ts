@@ -0,0 +1,48 @@
+import { parentPort, workerData } from "worker_threads";
+import { serveBridge, SQLiteAsyncVFSFile, SQLiteMemoryFile } from "../src";
+
+// Worker that serves SQLiteBridgeVFS from in-memory files behind an async API,
+// used by the bridge tests and benchmarks. delayMs simulates a slow backend.
+interface BridgeHostData {
+	channel: SharedArrayBuffer;
+	delayMs?: number;
+}
+
+const { channel, delayMs } = workerData as BridgeHostData;
+
+const settle = () => new Promise<void>((resolve) => delayMs ? setTimeout(resolve, delayMs) : setImmediate(resolve));
+
+function wrap(file: SQLiteMemoryFile): SQLiteAsyncVFSFile {
+	return {
+		close: async () => {},
+		read: async (buf, offset) => (await settle(), file.read(buf, offset)),
+		write: async (buf, offset) => (await settle(), file.write(buf, offset)),
+		truncate: async (size) => file.truncate(size),
+		sync: async () => {},
+		fileSize: async () => file.fileSize(),
+	};
+}
+
+const files = new Map<string, SQLiteMemoryFile>();
+
+serveBridge(channel, {
+	async open(name) {
+		if (name === null) {
+			return wrap(new SQLiteMemoryFile());
+		}
+		let file = files.get(name);
+		if (file === undefined) {
+			file = new SQLiteMemoryFile();
+			files.set(name, file);
+		}
+		return wrap(file);
+	},
+	async delete(name) {
+		files.delete(name);
+	},
+	async access(name) {
+		return files.has(name);
+	},
+});
+
+parentPort!.postMessage("ready");
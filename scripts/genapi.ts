@@ -12,6 +12,11 @@ export type CFunctionPointer = number;
 export type CFloat = number;
 export type CDouble = number;
 
+// memory64 builds pass pointers and size_t as i64, see src/memory64.ts
+export type CPointer64 = bigint;
+export type CString64 = bigint;
+export type CFunctionPointer64 = bigint;
+
 `;
 
 const exportsPreamble = `
@@ -30,6 +35,23 @@ export interface SQLiteImports {
 const importsPostamble = `}
 `;
 
+const exports64Preamble = `
+export interface SQLiteExports64 extends WebAssembly.Exports {
+`;
+
+const imports64Preamble = `
+export interface SQLiteImports64 {
+`;
+
+const pointerSignaturesPreamble = `
+// Return and argument kinds of every api for the memory64 adapters, "p" for pointers and
+// varargs and "_" for everything else, for example "p:p_" returns a pointer.
+export const pointerSignatures: Record<string, string> = {
+`;
+
+const pointerSignaturesPostamble = `};
+`;
+
 const unimplementedImportsPreamble = `
 export class SQLiteUnimplementedImportError extends Error {
 	constructor(api: string) {
@@ -133,6 +155,7 @@ interface SqliteApiInfo {
 		inferredName: string;
 		typeName?: string;
 		interopTypeName: string;
+		source: string;
 	}[];
 }
 
@@ -161,6 +184,7 @@ function extractApis(header: string): SqliteApiInfo[] {
 				inferredName: getArgName(arg) ?? String.fromCharCode("a".charCodeAt(0) + i),
 				typeName: getArgTypeName(arg),
 				interopTypeName: getArgInteropTypeName(arg),
+				source: arg,
 			})),
 		});
 	}
@@ -171,6 +195,143 @@ function genInterop(api: SqliteApiInfo) {
 	return `${api.name}: (${api.args.map((arg) => `${arg.inferredName}: ${arg.interopTypeName}`).join(", ")}) => ${api.returnInteropType};`
 }
 
+const interop64: Partial<Record<InteropTypeName, string>> = {
+	CPointer: "CPointer64",
+	CString: "CString64",
+	CFunctionPointer: "CFunctionPointer64",
+};
+
+function genInterop64(api: SqliteApiInfo) {
+	const type = (arg: { typeName?: string; interopTypeName: string }) => isPointer(arg) ? interop64[arg.interopTypeName as InteropTypeName] ?? "CPointer64" : arg.interopTypeName;
+	return `${api.name}: (${api.args.map((arg) => `${arg.inferredName}: ${type(arg)}`).join(", ")}) => ${type({ typeName: api.returnType, interopTypeName: api.returnInteropType })};`
+}
+
+// varargs and va_list are passed as a pointer to the argument area
+function isPointer(arg: { typeName?: string; interopTypeName: string }) {
+	return interop64[arg.interopTypeName as InteropTypeName] !== undefined ||
+		arg.typeName === "..." || arg.typeName === "va_list";
+}
+
+function genPointerSignature(api: SqliteApiInfo) {
+	const kind = (arg: { typeName?: string; interopTypeName: string }) => isPointer(arg) ? "p" : "_";
+	return `${api.name}: "${kind({ typeName: api.returnType, interopTypeName: api.returnInteropType })}:${api.args.map(kind).join("")}",`;
+}
+
+const nativePreamble = `/* auto-generated by scripts/genapi.ts, do not edit */
+`;
+
+// arrays of pointers are 4-byte offsets in JS but native pointers in C, and the Windows
+// functions, which the SQLITE_OS_OTHER build never defines
+const nativeSkipped = ["sqlite3_get_table", "sqlite3_free_table", "sqlite3_win32_set_directory", "sqlite3_win32_set_directory8"];
+
+// integer types genapi does not name, passed through an int
+const nativeIntegers = ["unsigned", "unsigned int", "unsigned char", "unsigned long", "char"];
+
+function genNativeArg(arg: SqliteApiInfo["args"][number], i: number): { pre: string; value: string; post: string } | undefined {
+	const raw = arg.typeName ?? "";
+	switch (arg.interopTypeName) {
+		case "CInteger":
+			return { pre: "", value: `arg_i32(env, argv[${i}])`, post: "" };
+		case "CInteger64":
+			return { pre: "", value: `arg_i64(env, argv[${i}])`, post: "" };
+		case "CFloat":
+		case "CDouble":
+			return { pre: "", value: `arg_f64(env, argv[${i}])`, post: "" };
+		case "CString":
+			return { pre: "", value: `arg_pointer(env, argv[${i}])`, post: "" };
+		case "CFunctionPointer": {
+			// the only function pointers JS passes are the SQLITE_STATIC and SQLITE_TRANSIENT constants
+			const type = arg.source.replace(/\(\s*\*\s*[a-zA-Z0-9_]*\s*\)/, "(*)");
+			return { pre: "", value: `(${type})arg_function(env, argv[${i}])`, post: "" };
+		}
+		case "CPointer":
+			if (raw.endsWith("***")) {
+				return undefined;
+			}
+			if (raw.endsWith("**")) {
+				// out-parameter, the offset of a 4-byte slot
+				return {
+					pre: `\tuint32_t slot${i} = arg_u32(env, argv[${i}]);\n\tvoid *out${i} = load_pointer(slot${i});\n`,
+					value: `slot${i} != 0 ? (void *)&out${i} : NULL`,
+					post: `\tstore_pointer(slot${i}, out${i});\n`,
+				};
+			}
+			return { pre: "", value: `arg_pointer(env, argv[${i}])`, post: "" };
+		case "unknown":
+			// type names without a pointer still end with the argument name
+			if (nativeIntegers.includes(arg.name === undefined ? raw : raw.replace(new RegExp(` *\\b${arg.name}$`), ""))) {
+				return { pre: "", value: `arg_i32(env, argv[${i}])`, post: "" };
+			}
+			return undefined;
+	}
+	return undefined;
+}
+
+function genNativeExport(api: SqliteApiInfo): string | undefined {
+	if (nativeSkipped.includes(api.name)) {
+		return undefined;
+	}
+	const args = api.args.map(genNativeArg);
+	if (args.some((arg) => arg === undefined)) {
+		return undefined;
+	}
+	const call = `${api.name}(${args.map((arg) => arg!.value).join(", ")})`;
+	const pre = args.map((arg) => arg!.pre).join("");
+	const post = args.map((arg) => arg!.post).join("");
+	let body: string;
+	switch (api.returnInteropType) {
+		case "void":
+			body = `\t${call};\n${post}\treturn NULL;\n`;
+			break;
+		case "CInteger":
+			body = `\tint r = ${call};\n${post}\treturn ret_i32(env, r);\n`;
+			break;
+		case "CInteger64":
+			body = `\tsqlite3_int64 r = ${call};\n${post}\treturn ret_i64(env, r);\n`;
+			break;
+		case "CFloat":
+		case "CDouble":
+			body = `\tdouble r = ${call};\n${post}\treturn ret_f64(env, r);\n`;
+			break;
+		case "CPointer":
+		case "CString":
+			body = `\tconst void *r = ${call};\n${post}\treturn ret_pointer(env, r);\n`;
+			break;
+		default:
+			return undefined;
+	}
+	const argc = Math.max(api.args.length, 1);
+	return `#pragma weak ${api.name}
+static napi_value export_${api.name}(napi_env env, napi_callback_info info)
+{
+	napi_value argv[${argc}];
+	get_args(env, info, argv, ${argc});
+${pre}${body}}
+`;
+}
+
+// SQLITE_ENABLE_* conditions around declarations, sqlite3.h leaves those APIs out unless defined
+function nativeGuards(header: string): Map<string, string> {
+	const lineGuards: string[] = [];
+	const stack: string[] = [];
+	for (const line of header.split("\n")) {
+		if (/^#\s*if/.test(line)) {
+			stack.push(Array.from(line.matchAll(/SQLITE_ENABLE_[A-Z0-9_]+/g), (m) => `defined(${m[0]})`).join(" && "));
+		} else if (/^#\s*endif/.test(line)) {
+			stack.pop();
+		}
+		lineGuards.push(stack.filter((c) => c !== "").join(" && "));
+	}
+	const guards = new Map<string, string>();
+	for (const match of header.matchAll(/^(?:SQLITE_API|SQLITE_EXTRA_API) [^(;]*?([^ *()]+)\(/mg)) {
+		const guard = lineGuards[header.slice(0, match.index).split("\n").length - 1];
+		if (guard !== "") {
+			guards.set(match[1], guard);
+		}
+	}
+	return guards;
+}
+
 function genPlaceholder(api: SqliteApiInfo) {
 	return `${api.name}: () => { throw new SQLiteUnimplementedImportError("${api.name}") },`;
 }
@@ -197,10 +358,30 @@ async function main() {
 		importsPreamble,
 		...importInterops.map((x) => "\t" + x + "\n"),
 		importsPostamble,
+		exports64Preamble,
+		...exportApis.map(genInterop64).map((x) => "\t" + x + "\n"),
+		exportsPostamble,
+		imports64Preamble,
+		...importApis.map(genInterop64).map((x) => "\t" + x + "\n"),
+		importsPostamble,
+		pointerSignaturesPreamble,
+		...exportApis.concat(importApis).map(genPointerSignature).map((x) => "\t" + x + "\n"),
+		pointerSignaturesPostamble,
 		unimplementedImportsPreamble,
 		...importApis.map(genPlaceholder).map((x) => "\t" + x + "\n"),
 		unimplementedImportsPostamble,
 	]);
+
+	const guards = nativeGuards(sqliteHeader);
+	const guarded = (name: string, code: string) => guards.has(name) ? `#if ${guards.get(name)}\n${code}#endif\n` : code;
+	const nativeExports = exportApis.map((api) => [api.name, genNativeExport(api)] as const).filter(([, c]) => c !== undefined);
+	await fs.writeFile("./sqlite/sqlite3node_exports.h", [
+		nativePreamble,
+		...nativeExports.map(([name, c]) => "\n" + guarded(name, c!)),
+		"\nstatic const struct native_export native_exports[] = {\n",
+		...nativeExports.map(([name]) => guarded(name, `\t{ "${name}", export_${name}, (void *)${name} },\n`)),
+		"};\n",
+	]);
 }
 
 main();
@@ -0,0 +1,39 @@
+import * as fs from "fs/promises";
+import * as path from "path";
+
+// Lists the SQLite exports that src/ calls, for the export allowlist of `make trimmed`.
+
+const preamble = `# auto-generated by scripts/genexports.ts from the exports src/ uses, do not edit
+`;
+
+function blockNames(api: string, name: string): Set<string> {
+	const block = api.match(new RegExp(`export interface ${name} [^{]*{([^]*?)\\n}`))?.[1] ?? "";
+	return new Set(Array.from(block.matchAll(/^\t(sqlite3_[a-z0-9_]+):/mg), (m) => m[1]));
+}
+
+async function main() {
+	const srcDir = "./src";
+	const api = await fs.readFile(path.join(srcDir, "api.ts"), { encoding: "utf-8" });
+	const imports = blockNames(api, "SQLiteImports");
+
+	const used = new Set<string>();
+	for (const filename of (await fs.readdir(srcDir)).sort()) {
+		if (!filename.endsWith(".ts") || filename === "api.ts") {
+			continue;
+		}
+		const source = (await fs.readFile(path.join(srcDir, filename), { encoding: "utf-8" }))
+			.replace(/\/\/.*$/mg, "")
+			.replace(/\/\*[^]*?\*\//g, "");
+		// calls through exports and names looked up as strings, such as optional exports
+		for (const match of source.matchAll(/\.(sqlite3_[a-z0-9_]+)\b|"(sqlite3_[a-z0-9_]+)"/g)) {
+			const name = match[1] ?? match[2];
+			if (!imports.has(name)) {
+				used.add(name);
+			}
+		}
+	}
+
+	await fs.writeFile("./sqlite/exports/core.txt", preamble + Array.from(used).sort().map((name) => name + "\n").join(""));
+}
+
+main();
@@ -0,0 +1,24 @@
+import * as fs from "fs/promises";
+import { argv, cwd, env, exit } from "process";
+import { WASI, WASIOptions } from "wasi";
+import { SQLite } from "../src";
+
+// Runs the sqlite3 shell from `make shell` on Node's WASI, for example
+// `yarn shell` and then `.open --deserialize prod.db`, `.timer on`, `.eqp on` or `.expert`.
+// Files that the shell reads and writes itself are relative to the working directory.
+
+async function main() {
+	const wasi = new WASI({
+		version: "preview1",
+		args: ["sqlite3", ...argv.slice(2)],
+		env,
+		preopens: { ".": cwd() },
+		returnOnExit: true,
+	} as WASIOptions);
+	const module = await WebAssembly.compile(await fs.readFile("./sqlite/sqlite3.shell.wasm"));
+	// main() calls sqlite3_initialize, which registers the JS VFS through the imports
+	const sqlite = await SQLite.instantiate(module, true, { initialize: false, wasi: wasi.wasiImport });
+	exit(wasi.start(sqlite.instance));
+}
+
+main();
@@ -0,0 +1,70 @@
+-- Training run for `make pgo`, replayed through an instrumented native shell.
+-- Mirrors the query mix of the JS API: bulk loads in transactions, point reads by
+-- key, index range scans, joins, GROUP BY and ORDER BY through the sorter, text
+-- functions, updates and deletes.
+
+PRAGMA cache_size = -16384;
+
+CREATE TABLE users (id INTEGER PRIMARY KEY, name TEXT NOT NULL, email TEXT, age INTEGER, score REAL, created INTEGER);
+CREATE TABLE orders (id INTEGER PRIMARY KEY, user_id INTEGER NOT NULL, amount REAL, status TEXT, note BLOB);
+CREATE TABLE tags (order_id INTEGER, tag TEXT, PRIMARY KEY (order_id, tag)) WITHOUT ROWID;
+
+BEGIN;
+WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 200000)
+INSERT INTO users (name, email, age, score, created)
+SELECT 'user ' || i, printf('user%d@example.com', i), i % 90, (i * 7919 % 10007) / 100.0, 1600000000 + i * 37 FROM s;
+WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 500000)
+INSERT INTO orders (user_id, amount, status, note)
+SELECT (i * 104729) % 200000 + 1, (i % 1000) / 10.0, CASE i % 4 WHEN 0 THEN 'open' WHEN 1 THEN 'paid' WHEN 2 THEN 'shipped' ELSE 'closed' END, randomblob(i % 64) FROM s;
+WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 300000)
+INSERT INTO tags SELECT i, 'tag' || (i % 50) FROM s;
+COMMIT;
+
+CREATE INDEX users_email ON users (email);
+CREATE INDEX users_age_score ON users (age, score);
+CREATE INDEX orders_user ON orders (user_id);
+ANALYZE;
+
+-- point reads
+WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 100000)
+SELECT count(*) FROM s JOIN users ON users.id = (s.i * 31) % 200000 + 1;
+WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 50000)
+SELECT count(*) FROM s JOIN users ON users.email = printf('user%d@example.com', s.i * 3);
+
+-- range scans and aggregates
+SELECT age, count(*), avg(score), min(score), max(score) FROM users WHERE age BETWEEN 20 AND 60 GROUP BY age;
+SELECT status, count(*), sum(amount), total(length(note)) FROM orders GROUP BY status;
+SELECT count(*) FROM users WHERE score > 50.0 AND age < 30;
+SELECT count(DISTINCT user_id) FROM orders WHERE amount > 50;
+
+-- joins
+SELECT u.age, count(*), sum(o.amount) FROM users u JOIN orders o ON o.user_id = u.id WHERE u.age < 25 GROUP BY u.age;
+SELECT count(*) FROM orders o JOIN tags t ON t.order_id = o.id WHERE t.tag = 'tag7' AND o.status = 'paid';
+SELECT count(*) FROM users u WHERE EXISTS (SELECT 1 FROM orders o WHERE o.user_id = u.id AND o.amount > 99);
+
+-- sorter
+SELECT count(*) FROM (SELECT name FROM users ORDER BY name);
+SELECT count(*) FROM (SELECT * FROM orders ORDER BY amount DESC, id LIMIT 1000);
+SELECT count(*) FROM (SELECT email, score FROM users ORDER BY score, email);
+
+-- text
+SELECT count(*) FROM users WHERE name LIKE '%99%';
+SELECT count(*) FROM users WHERE email GLOB 'user1*';
+SELECT sum(length(upper(name) || lower(email))), count(DISTINCT substr(email, 1, 6)) FROM users;
+SELECT count(*) FROM users WHERE instr(email, '77') > 0;
+SELECT group_concat(name, ',') IS NOT NULL FROM (SELECT name FROM users LIMIT 5000);
+
+-- window functions
+SELECT count(*) FROM (SELECT id, rank() OVER (PARTITION BY age ORDER BY score DESC) AS r FROM users) WHERE r <= 3;
+
+-- writes
+BEGIN;
+UPDATE users SET score = score + 1 WHERE age % 7 = 0;
+UPDATE orders SET status = 'archived' WHERE id % 10 = 0;
+DELETE FROM orders WHERE amount < 5;
+DELETE FROM tags WHERE tag = 'tag3';
+INSERT INTO users (name, email, age, score, created) SELECT name || ' copy', email || '.copy', age, score, created FROM users WHERE id % 20 = 0;
+COMMIT;
+
+VACUUM;
+SELECT count(*), sum(amount) FROM orders;
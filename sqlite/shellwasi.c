@@ -0,0 +1,41 @@
+/*
+** sqlite/shell.c as a WASI command, see `make shell` and scripts/shell.ts. The
+** shell is linked against the library objects of sqlite3.wasm, so files go
+** through the JS VFS and only the terminal and shell.c's own file I/O use WASI.
+** wasi-libc leaves out processes, users and permissions, the calls below fail
+** with ENOSYS, and sqlite/shellwasi/pwd.h stands in for the missing header.
+** Signals and getrusage() for .timer come from wasi-libc's emulation libraries.
+*/
+#define _WASI_EMULATED_SIGNAL
+#define _WASI_EMULATED_PROCESS_CLOCKS
+#define SQLITE_OMIT_POPEN 1
+
+#include <errno.h>
+#include <sys/types.h>
+
+int system(const char *zCommand);
+int chmod(const char *zPath, mode_t mode);
+pid_t getpid(void);
+
+#include "shell.c"
+
+int system(const char *zCommand)
+{
+	(void)zCommand;
+	errno = ENOSYS;
+	return -1;
+}
+
+int chmod(const char *zPath, mode_t mode)
+{
+	(void)zPath;
+	(void)mode;
+	errno = ENOSYS;
+	return -1;
+}
+
+/* only printed by SQLITE_DEBUG_BREAK */
+pid_t getpid(void)
+{
+	return 1;
+}
@@ -0,0 +1,26 @@
+/*
+** WASI has no users, find_home_dir() in shell.c falls back to $HOME.
+*/
+#ifndef SQLITE_SHELLWASI_PWD_H
+#define SQLITE_SHELLWASI_PWD_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+struct passwd
+{
+	char *pw_dir;
+};
+
+static inline uid_t getuid(void)
+{
+	return 0;
+}
+
+static inline struct passwd *getpwuid(uid_t uid)
+{
+	(void)uid;
+	return NULL;
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+** Bulk memory and SIMD128 versions of the libc primitives on SQLite's hot paths:
+** memcmp in record comparison, memcpy and memset for cells and pages, strlen
+** behind sqlite3Strlen30. wasi-libc ships built for MVP wasm only, so flavors
+** that enable these features link this file as an object and wasm-ld never
+** pulls the scalar versions out of libc.a. Each kernel is only compiled when
+** its feature is enabled. Built with -fno-builtin so the tail loops are not
+** turned back into calls to the functions they implement.
+*/
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __wasm_bulk_memory__
+
+/* below this memory.copy and memory.fill cost more than a plain loop */
+#define BULK_MEMORY_THRESHOLD 32
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t n)
+{
+	if (n >= BULK_MEMORY_THRESHOLD)
+	{
+		return __builtin_memcpy(dst, src, n);
+	}
+	unsigned char *d = dst;
+	const unsigned char *s = src;
+	while (n--)
+	{
+		*d++ = *s++;
+	}
+	return dst;
+}
+
+void *memmove(void *dst, const void *src, size_t n)
+{
+	if (n >= BULK_MEMORY_THRESHOLD)
+	{
+		return __builtin_memmove(dst, src, n);
+	}
+	unsigned char *d = dst;
+	const unsigned char *s = src;
+	if (d < s)
+	{
+		while (n--)
+		{
+			*d++ = *s++;
+		}
+	}
+	else
+	{
+		while (n--)
+		{
+			d[n] = s[n];
+		}
+	}
+	return dst;
+}
+
+void *memset(void *dst, int c, size_t n)
+{
+	if (n >= BULK_MEMORY_THRESHOLD)
+	{
+		return __builtin_memset(dst, c, n);
+	}
+	unsigned char *d = dst;
+	while (n--)
+	{
+		*d++ = (unsigned char)c;
+	}
+	return dst;
+}
+#endif /* __wasm_bulk_memory__ */
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+
+int memcmp(const void *a, const void *b, size_t n)
+{
+	const unsigned char *x = a;
+	const unsigned char *y = b;
+	for (; n >= 16; x += 16, y += 16, n -= 16)
+	{
+		v128_t eq = wasm_i8x16_eq(wasm_v128_load(x), wasm_v128_load(y));
+		if (!wasm_i8x16_all_true(eq))
+		{
+			int i = __builtin_ctz(~wasm_i8x16_bitmask(eq) & 0xffff);
+			return x[i] - y[i];
+		}
+	}
+	for (; n > 0; x++, y++, n--)
+	{
+		if (*x != *y)
+		{
+			return *x - *y;
+		}
+	}
+	return 0;
+}
+
+/*
+** Aligned 16 byte loads never cross a page, so reading the whole block around
+** the terminator cannot run off the end of linear memory.
+*/
+size_t strlen(const char *s)
+{
+	const v128_t zero = wasm_i8x16_splat(0);
+	uintptr_t offset = (uintptr_t)s & 15;
+	const char *p = s - offset;
+	uint32_t mask = wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(p), zero)) >> offset;
+	if (mask != 0)
+	{
+		return __builtin_ctz(mask);
+	}
+	for (;;)
+	{
+		p += 16;
+		mask = wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(p), zero));
+		if (mask != 0)
+		{
+			return (size_t)(p - s) + __builtin_ctz(mask);
+		}
+	}
+}
+#endif /* __wasm_simd128__ */
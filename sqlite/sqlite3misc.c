@@ -0,0 +1,10 @@
+/*
+** Extensions from SQLite's ext/misc, linked into the full flavor. Builds with
+** SQLITE_OMIT_LOAD_EXTENSION cannot load them at runtime, so sqlite3wasm.c
+** registers their init functions with sqlite3_auto_extension when it is
+** compiled with SQLITE_EXT_MISC.
+*/
+#include "ext/misc/decimal.c"
+#include "ext/misc/percentile.c"
+#include "ext/misc/regexp.c"
+#include "ext/misc/series.c"
@@ -0,0 +1,593 @@
+/*
+** Native Node addon with the exports of the wasm build, see src/native.ts.
+**
+** SQLite allocates from a MEMSYS5 heap inside one reserved arena, which is
+** exposed to JS as `memory`. Pointers cross the boundary as 32-bit offsets
+** into the arena, so the TypeScript API treats them like wasm32 addresses.
+** Pointers to static data are copied into the arena, and stack buffers that
+** SQLite passes to the JS-imported VFS are bounced through a scratch area.
+**
+** SQLite's globals live in this shared object, so one thread per process
+** can load the addon.
+*/
+#define NAPI_VERSION 8
+#include <node_api.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "sqlite3wasm.h"
+
+#ifndef SQLITE_NODE_ARENA_SIZE
+#define SQLITE_NODE_ARENA_SIZE (1u << 30)
+#endif
+
+#define SCRATCH_OFFSET 64
+#define SCRATCH_SIZE (1u << 20)
+#define HEAP_OFFSET (SCRATCH_OFFSET + SCRATCH_SIZE)
+#define MAX_STATICS 256
+
+struct native_export
+{
+	const char *name;
+	napi_callback callback;
+	void *symbol;
+};
+
+static unsigned char *arena;
+static napi_env current_env;
+static napi_ref current_imports;
+
+static int in_arena(const void *p)
+{
+	return (const unsigned char *)p >= arena && (const unsigned char *)p < arena + SQLITE_NODE_ARENA_SIZE;
+}
+
+static void *to_pointer(uint32_t offset)
+{
+	return offset == 0 ? NULL : arena + offset;
+}
+
+/*
+** Static strings, such as sqlite3_libversion() or the messages of
+** sqlite3_errstr(), are copied into the arena once per address.
+*/
+static struct
+{
+	const void *address;
+	uint32_t offset;
+} statics[MAX_STATICS];
+static int next_static;
+
+static uint32_t to_offset(const void *p)
+{
+	if (p == NULL)
+	{
+		return 0;
+	}
+	if (in_arena(p))
+	{
+		return (uint32_t)((const unsigned char *)p - arena);
+	}
+	size_t n = strlen(p) + 1;
+	for (int i = 0; i < MAX_STATICS; i++)
+	{
+		if (statics[i].address == p && memcmp(arena + statics[i].offset, p, n) == 0)
+		{
+			return statics[i].offset;
+		}
+	}
+	unsigned char *copy = sqlite3_malloc((int)n);
+	if (copy == NULL)
+	{
+		return 0;
+	}
+	memcpy(copy, p, n);
+	if (statics[next_static].address != NULL)
+	{
+		sqlite3_free(arena + statics[next_static].offset);
+	}
+	statics[next_static].address = p;
+	statics[next_static].offset = (uint32_t)(copy - arena);
+	next_static = (next_static + 1) % MAX_STATICS;
+	return (uint32_t)(copy - arena);
+}
+
+static void *load_pointer(uint32_t slot)
+{
+	uint32_t offset = 0;
+	if (slot != 0)
+	{
+		memcpy(&offset, arena + slot, 4);
+	}
+	return to_pointer(offset);
+}
+
+static void store_pointer(uint32_t slot, const void *p)
+{
+	if (slot != 0)
+	{
+		uint32_t offset = to_offset(p);
+		memcpy(arena + slot, &offset, 4);
+	}
+}
+
+static void get_args(napi_env env, napi_callback_info info, napi_value *argv, size_t argc)
+{
+	size_t n = argc;
+	napi_get_cb_info(env, info, &n, argv, NULL, NULL);
+	for (size_t i = n; i < argc; i++)
+	{
+		napi_get_undefined(env, &argv[i]);
+	}
+}
+
+static sqlite3_int64 arg_i64(napi_env env, napi_value v)
+{
+	napi_valuetype type;
+	napi_typeof(env, v, &type);
+	if (type == napi_bigint)
+	{
+		int64_t r;
+		bool lossless;
+		napi_get_value_bigint_int64(env, v, &r, &lossless);
+		return r;
+	}
+	if (type == napi_boolean)
+	{
+		bool b;
+		napi_get_value_bool(env, v, &b);
+		return b;
+	}
+	double d = 0;
+	napi_get_value_double(env, v, &d);
+	return (sqlite3_int64)d;
+}
+
+static int arg_i32(napi_env env, napi_value v)
+{
+	return (int)arg_i64(env, v);
+}
+
+static uint32_t arg_u32(napi_env env, napi_value v)
+{
+	return (uint32_t)arg_i64(env, v);
+}
+
+static double arg_f64(napi_env env, napi_value v)
+{
+	napi_valuetype type;
+	napi_typeof(env, v, &type);
+	if (type == napi_bigint)
+	{
+		return (double)arg_i64(env, v);
+	}
+	double d = 0;
+	napi_get_value_double(env, v, &d);
+	return d;
+}
+
+static void *arg_pointer(napi_env env, napi_value v)
+{
+	return to_pointer(arg_u32(env, v));
+}
+
+/*
+** Only SQLITE_STATIC (0) and SQLITE_TRANSIENT (-1) are passed from JS.
+*/
+static intptr_t arg_function(napi_env env, napi_value v)
+{
+	return (intptr_t)arg_i32(env, v);
+}
+
+static napi_value ret_i32(napi_env env, int r)
+{
+	napi_value v;
+	napi_create_int32(env, r, &v);
+	return v;
+}
+
+static napi_value ret_u32(napi_env env, uint32_t r)
+{
+	napi_value v;
+	napi_create_uint32(env, r, &v);
+	return v;
+}
+
+static napi_value ret_i64(napi_env env, sqlite3_int64 r)
+{
+	napi_value v;
+	napi_create_bigint_int64(env, r, &v);
+	return v;
+}
+
+static napi_value ret_f64(napi_env env, double r)
+{
+	napi_value v;
+	napi_create_double(env, r, &v);
+	return v;
+}
+
+static napi_value ret_pointer(napi_env env, const void *r)
+{
+	return ret_u32(env, to_offset(r));
+}
+
+#include "sqlite3node_exports.h"
+
+/*
+** Calls the import of the instance that made the current export call. A JS
+** exception stays pending and is rethrown when the export returns.
+*/
+static int call_import(const char *name, size_t argc, napi_value *argv)
+{
+	napi_env env = current_env;
+	napi_value imports, fn, global, result;
+	napi_get_reference_value(env, current_imports, &imports);
+	napi_get_named_property(env, imports, name, &fn);
+	napi_get_global(env, &global);
+	if (napi_call_function(env, global, fn, argc, argv, &result) != napi_ok)
+	{
+		return SQLITE_ERROR;
+	}
+	napi_valuetype type;
+	napi_typeof(env, result, &type);
+	if (type != napi_number)
+	{
+		return SQLITE_OK;
+	}
+	int32_t rc;
+	napi_get_value_int32(env, result, &rc);
+	return rc;
+}
+
+static napi_value int_value(int v)
+{
+	return ret_i32(current_env, v);
+}
+
+static napi_value offset_value(uint32_t v)
+{
+	return ret_u32(current_env, v);
+}
+
+/*
+** Buffers outside of the arena, typically on SQLite's stack, are copied
+** through the scratch area around an import call.
+*/
+struct bounce
+{
+	void *original;
+	uint32_t offset;
+	size_t size;
+};
+
+static size_t scratch_used;
+
+static uint32_t bounce_in(struct bounce *b, const void *p, size_t size, int copy)
+{
+	b->original = NULL;
+	b->size = size;
+	if (p == NULL || in_arena(p))
+	{
+		b->offset = p == NULL ? 0 : (uint32_t)((const unsigned char *)p - arena);
+		return b->offset;
+	}
+	if (scratch_used + size > SCRATCH_SIZE)
+	{
+		b->offset = 0;
+		return 0;
+	}
+	unsigned char *s = arena + SCRATCH_OFFSET + scratch_used;
+	scratch_used += (size + 15) & ~(size_t)15;
+	if (copy)
+	{
+		memcpy(s, p, size);
+	}
+	b->original = (void *)p;
+	b->offset = (uint32_t)(s - arena);
+	return b->offset;
+}
+
+static void bounce_out(struct bounce *b)
+{
+	if (b->original != NULL)
+	{
+		memcpy(b->original, arena + b->offset, b->size);
+	}
+}
+
+static uint32_t string_in(struct bounce *b, const char *z)
+{
+	return bounce_in(b, z, z == NULL ? 0 : strlen(z) + 1, 1);
+}
+
+int sqlite3_ext_os_init(void)
+{
+	return call_import("sqlite3_ext_os_init", 0, NULL);
+}
+
+int sqlite3_ext_os_end(void)
+{
+	return call_import("sqlite3_ext_os_end", 0, NULL);
+}
+
+int sqlite3_ext_exec_callback(int id, int nCols, char **azCols, char **azColNames)
+{
+	uint32_t *columns = sqlite3_malloc(nCols * 8 + 8);
+	if (columns == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	for (int i = 0; i < nCols; i++)
+	{
+		columns[i] = azCols == NULL ? 0 : to_offset(azCols[i]);
+		columns[nCols + i] = to_offset(azColNames[i]);
+	}
+	napi_value argv[4] = { int_value(id), int_value(nCols), offset_value(to_offset(columns)), offset_value(to_offset(columns + nCols)) };
+	int rc = call_import("sqlite3_ext_exec_callback", 4, argv);
+	sqlite3_free(columns);
+	return rc;
+}
+
+int sqlite3_ext_progress_callback(int id)
+{
+	napi_value argv[1] = { int_value(id) };
+	return call_import("sqlite3_ext_progress_callback", 1, argv);
+}
+
+#ifdef SQLITE_ENABLE_FTS5
+int sqlite3_ext_fts5_tokenize(int id, int flags, const char *pText, int nText, int **ppOut)
+{
+	struct bounce text, out;
+	uint32_t offset = 0;
+	scratch_used = 0;
+	bounce_in(&text, pText, nText, 1);
+	bounce_in(&out, &offset, 4, 1);
+	napi_value argv[5] = { int_value(id), int_value(flags), offset_value(text.offset), int_value(nText), offset_value(out.offset) };
+	int rc = call_import("sqlite3_ext_fts5_tokenize", 5, argv);
+	bounce_out(&out);
+	/* the tokens are an sqlite3_malloc() block inside the arena */
+	*ppOut = to_pointer(offset);
+	return rc;
+}
+#endif
+
+int sqlite3_ext_io_close(int vfsId, int fileId)
+{
+	napi_value argv[2] = { int_value(vfsId), int_value(fileId) };
+	return call_import("sqlite3_ext_io_close", 2, argv);
+}
+
+int sqlite3_ext_io_read(int vfsId, int fileId, void *pBuf, int iAmt, int iOfst)
+{
+	struct bounce buf;
+	scratch_used = 0;
+	bounce_in(&buf, pBuf, iAmt, 0);
+	napi_value argv[5] = { int_value(vfsId), int_value(fileId), offset_value(buf.offset), int_value(iAmt), int_value(iOfst) };
+	int rc = call_import("sqlite3_ext_io_read", 5, argv);
+	bounce_out(&buf);
+	return rc;
+}
+
+int sqlite3_ext_io_write(int vfsId, int fileId, const void *pBuf, int iAmt, int iOfst)
+{
+	struct bounce buf;
+	scratch_used = 0;
+	bounce_in(&buf, pBuf, iAmt, 1);
+	napi_value argv[5] = { int_value(vfsId), int_value(fileId), offset_value(buf.offset), int_value(iAmt), int_value(iOfst) };
+	return call_import("sqlite3_ext_io_write", 5, argv);
+}
+
+int sqlite3_ext_io_truncate(int vfsId, int fileId, int size)
+{
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), int_value(size) };
+	return call_import("sqlite3_ext_io_truncate", 3, argv);
+}
+
+int sqlite3_ext_io_sync(int vfsId, int fileId, int flags)
+{
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), int_value(flags) };
+	return call_import("sqlite3_ext_io_sync", 3, argv);
+}
+
+int sqlite3_ext_io_file_size(int vfsId, int fileId, int *pSize)
+{
+	struct bounce size;
+	scratch_used = 0;
+	bounce_in(&size, pSize, 4, 1);
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), offset_value(size.offset) };
+	int rc = call_import("sqlite3_ext_io_file_size", 3, argv);
+	bounce_out(&size);
+	return rc;
+}
+
+int sqlite3_ext_io_lock(int vfsId, int fileId, int locktype)
+{
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), int_value(locktype) };
+	return call_import("sqlite3_ext_io_lock", 3, argv);
+}
+
+int sqlite3_ext_io_unlock(int vfsId, int fileId, int locktype)
+{
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), int_value(locktype) };
+	return call_import("sqlite3_ext_io_unlock", 3, argv);
+}
+
+int sqlite3_ext_io_check_reserved_lock(int vfsId, int fileId, int *pResOut)
+{
+	struct bounce res;
+	scratch_used = 0;
+	bounce_in(&res, pResOut, 4, 1);
+	napi_value argv[3] = { int_value(vfsId), int_value(fileId), offset_value(res.offset) };
+	int rc = call_import("sqlite3_ext_io_check_reserved_lock", 3, argv);
+	bounce_out(&res);
+	return rc;
+}
+
+/*
+** The argument of a file control is opcode specific, only arena pointers are
+** passed on.
+*/
+int sqlite3_ext_io_file_control(int vfsId, int fileId, int op, void *pArg)
+{
+	napi_value argv[4] = { int_value(vfsId), int_value(fileId), int_value(op), offset_value(in_arena(pArg) ? to_offset(pArg) : 0) };
+	return call_import("sqlite3_ext_io_file_control", 4, argv);
+}
+
+int sqlite3_ext_io_sector_size(int vfsId, int fileId)
+{
+	napi_value argv[2] = { int_value(vfsId), int_value(fileId) };
+	return call_import("sqlite3_ext_io_sector_size", 2, argv);
+}
+
+int sqlite3_ext_io_device_characteristics(int vfsId, int fileId)
+{
+	napi_value argv[2] = { int_value(vfsId), int_value(fileId) };
+	return call_import("sqlite3_ext_io_device_characteristics", 2, argv);
+}
+
+int sqlite3_ext_vfs_open(int id, const char *zName, int *pOutfileId, int flags, int *pOutFlags)
+{
+	struct bounce name, fileId, outFlags;
+	scratch_used = 0;
+	string_in(&name, zName);
+	bounce_in(&fileId, pOutfileId, 4, 1);
+	bounce_in(&outFlags, pOutFlags, 4, 1);
+	napi_value argv[5] = { int_value(id), offset_value(name.offset), offset_value(fileId.offset), int_value(flags), offset_value(outFlags.offset) };
+	int rc = call_import("sqlite3_ext_vfs_open", 5, argv);
+	bounce_out(&fileId);
+	bounce_out(&outFlags);
+	return rc;
+}
+
+int sqlite3_ext_vfs_delete(int id, const char *zName, int syncDir)
+{
+	struct bounce name;
+	scratch_used = 0;
+	string_in(&name, zName);
+	napi_value argv[3] = { int_value(id), offset_value(name.offset), int_value(syncDir) };
+	return call_import("sqlite3_ext_vfs_delete", 3, argv);
+}
+
+int sqlite3_ext_vfs_access(int id, const char *zName, int flags, int *pResOut)
+{
+	struct bounce name, res;
+	scratch_used = 0;
+	string_in(&name, zName);
+	bounce_in(&res, pResOut, 4, 1);
+	napi_value argv[4] = { int_value(id), offset_value(name.offset), int_value(flags), offset_value(res.offset) };
+	int rc = call_import("sqlite3_ext_vfs_access", 4, argv);
+	bounce_out(&res);
+	return rc;
+}
+
+int sqlite3_ext_vfs_full_pathname(int id, const char *zName, int nOut, char *zOut)
+{
+	struct bounce name, out;
+	scratch_used = 0;
+	string_in(&name, zName);
+	bounce_in(&out, zOut, nOut, 0);
+	napi_value argv[4] = { int_value(id), offset_value(name.offset), int_value(nOut), offset_value(out.offset) };
+	int rc = call_import("sqlite3_ext_vfs_full_pathname", 4, argv);
+	bounce_out(&out);
+	return rc;
+}
+
+int sqlite3_ext_vfs_randomness(int id, int nByte, char *zOut)
+{
+	struct bounce out;
+	scratch_used = 0;
+	bounce_in(&out, zOut, nByte, 0);
+	napi_value argv[3] = { int_value(id), int_value(nByte), offset_value(out.offset) };
+	int rc = call_import("sqlite3_ext_vfs_randomness", 3, argv);
+	bounce_out(&out);
+	return rc;
+}
+
+int sqlite3_ext_vfs_sleep(int id, int microseconds)
+{
+	napi_value argv[2] = { int_value(id), int_value(microseconds) };
+	return call_import("sqlite3_ext_vfs_sleep", 2, argv);
+}
+
+int sqlite3_ext_vfs_current_time(int id, double *pTimeOut)
+{
+	struct bounce out;
+	scratch_used = 0;
+	bounce_in(&out, pTimeOut, 8, 0);
+	napi_value argv[2] = { int_value(id), offset_value(out.offset) };
+	int rc = call_import("sqlite3_ext_vfs_current_time", 2, argv);
+	bounce_out(&out);
+	return rc;
+}
+
+int sqlite3_ext_vfs_get_last_error(int id, int nByte, char *zOut)
+{
+	struct bounce out;
+	scratch_used = 0;
+	bounce_in(&out, zOut, nByte, 0);
+	napi_value argv[3] = { int_value(id), int_value(nByte), offset_value(out.offset) };
+	int rc = call_import("sqlite3_ext_vfs_get_last_error", 3, argv);
+	bounce_out(&out);
+	return rc;
+}
+
+/*
+** Binds the imports of the instance that is about to call exports, src/native.ts
+** calls it whenever a different instance becomes active.
+*/
+static napi_value set_imports(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	if (current_imports != NULL)
+	{
+		napi_delete_reference(env, current_imports);
+	}
+	napi_create_reference(env, argv[0], 1, &current_imports);
+	current_env = env;
+	return NULL;
+}
+
+static napi_value init(napi_env env, napi_value exports)
+{
+	if (arena != NULL)
+	{
+		napi_throw_error(env, NULL, "sqlite3.node can only be loaded by one thread per process");
+		return NULL;
+	}
+	arena = mmap(NULL, SQLITE_NODE_ARENA_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (arena == MAP_FAILED)
+	{
+		arena = NULL;
+		napi_throw_error(env, NULL, "Cannot reserve the sqlite3.node arena");
+		return NULL;
+	}
+	sqlite3_config(SQLITE_CONFIG_HEAP, arena + HEAP_OFFSET, SQLITE_NODE_ARENA_SIZE - HEAP_OFFSET, 16);
+	current_env = env;
+
+	for (size_t i = 0; i < sizeof(native_exports) / sizeof(native_exports[0]); i++)
+	{
+		/* weak, NULL for APIs left out by the compile options */
+		if (native_exports[i].symbol == NULL)
+		{
+			continue;
+		}
+		napi_value fn;
+		napi_create_function(env, native_exports[i].name, NAPI_AUTO_LENGTH, native_exports[i].callback, NULL, &fn);
+		napi_set_named_property(env, exports, native_exports[i].name, fn);
+	}
+
+	napi_value buffer, memory, fn;
+	napi_create_external_arraybuffer(env, arena, SQLITE_NODE_ARENA_SIZE, NULL, NULL, &buffer);
+	napi_create_object(env, &memory);
+	napi_set_named_property(env, memory, "buffer", buffer);
+	napi_set_named_property(env, exports, "memory", memory);
+	napi_create_function(env, "setImports", NAPI_AUTO_LENGTH, set_imports, NULL, &fn);
+	napi_set_named_property(env, exports, "setImports", fn);
+	return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, init)
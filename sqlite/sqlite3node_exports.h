@@ -0,0 +1,3260 @@
+/* auto-generated by scripts/genapi.ts, do not edit */
+
+#pragma weak sqlite3_libversion
+static napi_value export_sqlite3_libversion(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_libversion();
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_sourceid
+static napi_value export_sqlite3_sourceid(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_sourceid();
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_libversion_number
+static napi_value export_sqlite3_libversion_number(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_libversion_number();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_compileoption_used
+static napi_value export_sqlite3_compileoption_used(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_compileoption_used(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_compileoption_get
+static napi_value export_sqlite3_compileoption_get(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_compileoption_get(arg_i32(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_threadsafe
+static napi_value export_sqlite3_threadsafe(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_threadsafe();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_close
+static napi_value export_sqlite3_close(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_close(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_close_v2
+static napi_value export_sqlite3_close_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_close_v2(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_exec
+static napi_value export_sqlite3_exec(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	int r = sqlite3_exec(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), (int (*)(void*,int,char**,char**))arg_function(env, argv[2]), arg_pointer(env, argv[3]), slot4 != 0 ? (void *)&out4 : NULL);
+	store_pointer(slot4, out4);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_initialize
+static napi_value export_sqlite3_initialize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_initialize();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_shutdown
+static napi_value export_sqlite3_shutdown(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_shutdown();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_os_init
+static napi_value export_sqlite3_os_init(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_os_init();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_os_end
+static napi_value export_sqlite3_os_end(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_os_end();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_extended_result_codes
+static napi_value export_sqlite3_extended_result_codes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_extended_result_codes(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_last_insert_rowid
+static napi_value export_sqlite3_last_insert_rowid(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_last_insert_rowid(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_set_last_insert_rowid
+static napi_value export_sqlite3_set_last_insert_rowid(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_set_last_insert_rowid(arg_pointer(env, argv[0]), arg_i64(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_changes
+static napi_value export_sqlite3_changes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_changes(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_changes64
+static napi_value export_sqlite3_changes64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_changes64(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_total_changes
+static napi_value export_sqlite3_total_changes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_total_changes(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_total_changes64
+static napi_value export_sqlite3_total_changes64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_total_changes64(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_interrupt
+static napi_value export_sqlite3_interrupt(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_interrupt(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_complete
+static napi_value export_sqlite3_complete(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_complete(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_busy_handler
+static napi_value export_sqlite3_busy_handler(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_busy_handler(arg_pointer(env, argv[0]), (int(*)(void*,int))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_busy_timeout
+static napi_value export_sqlite3_busy_timeout(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_busy_timeout(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_malloc
+static napi_value export_sqlite3_malloc(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_malloc(arg_i32(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_malloc64
+static napi_value export_sqlite3_malloc64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_malloc64(arg_i64(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_realloc
+static napi_value export_sqlite3_realloc(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_realloc(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_realloc64
+static napi_value export_sqlite3_realloc64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_realloc64(arg_pointer(env, argv[0]), arg_i64(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_free
+static napi_value export_sqlite3_free(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_free(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_msize
+static napi_value export_sqlite3_msize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_msize(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_memory_used
+static napi_value export_sqlite3_memory_used(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_memory_used();
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_memory_highwater
+static napi_value export_sqlite3_memory_highwater(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_memory_highwater(arg_i32(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_randomness
+static napi_value export_sqlite3_randomness(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_randomness(arg_i32(env, argv[0]), arg_pointer(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_set_authorizer
+static napi_value export_sqlite3_set_authorizer(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_set_authorizer(arg_pointer(env, argv[0]), (int (*)(void*,int,const char*,const char*,const char*,const char*))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_trace_v2
+static napi_value export_sqlite3_trace_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_trace_v2(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), (int(*)(unsigned,void*,void*,void*))arg_function(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_progress_handler
+static napi_value export_sqlite3_progress_handler(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_progress_handler(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), (int(*)(void*))arg_function(env, argv[2]), arg_pointer(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_open
+static napi_value export_sqlite3_open(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3_open(arg_pointer(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL);
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_open_v2
+static napi_value export_sqlite3_open_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3_open_v2(arg_pointer(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL, arg_i32(env, argv[2]), arg_pointer(env, argv[3]));
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_uri_parameter
+static napi_value export_sqlite3_uri_parameter(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_uri_parameter(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_uri_boolean
+static napi_value export_sqlite3_uri_boolean(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_uri_boolean(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_uri_int64
+static napi_value export_sqlite3_uri_int64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3_int64 r = sqlite3_uri_int64(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i64(env, argv[2]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_uri_key
+static napi_value export_sqlite3_uri_key(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_uri_key(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_filename_database
+static napi_value export_sqlite3_filename_database(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_filename_database(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_filename_journal
+static napi_value export_sqlite3_filename_journal(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_filename_journal(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_filename_wal
+static napi_value export_sqlite3_filename_wal(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_filename_wal(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_database_file_object
+static napi_value export_sqlite3_database_file_object(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_database_file_object(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_create_filename
+static napi_value export_sqlite3_create_filename(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	const void *r = sqlite3_create_filename(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]), slot4 != 0 ? (void *)&out4 : NULL);
+	store_pointer(slot4, out4);
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_free_filename
+static napi_value export_sqlite3_free_filename(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_free_filename(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_errcode
+static napi_value export_sqlite3_errcode(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_errcode(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_extended_errcode
+static napi_value export_sqlite3_extended_errcode(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_extended_errcode(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_errmsg
+static napi_value export_sqlite3_errmsg(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_errmsg(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_errstr
+static napi_value export_sqlite3_errstr(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_errstr(arg_i32(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_limit
+static napi_value export_sqlite3_limit(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_limit(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_prepare
+static napi_value export_sqlite3_prepare(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	int r = sqlite3_prepare(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL, slot4 != 0 ? (void *)&out4 : NULL);
+	store_pointer(slot3, out3);
+	store_pointer(slot4, out4);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_prepare_v2
+static napi_value export_sqlite3_prepare_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	int r = sqlite3_prepare_v2(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL, slot4 != 0 ? (void *)&out4 : NULL);
+	store_pointer(slot3, out3);
+	store_pointer(slot4, out4);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_prepare_v3
+static napi_value export_sqlite3_prepare_v3(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	uint32_t slot5 = arg_u32(env, argv[5]);
+	void *out5 = load_pointer(slot5);
+	int r = sqlite3_prepare_v3(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]), slot4 != 0 ? (void *)&out4 : NULL, slot5 != 0 ? (void *)&out5 : NULL);
+	store_pointer(slot4, out4);
+	store_pointer(slot5, out5);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_sql
+static napi_value export_sqlite3_sql(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_sql(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_expanded_sql
+static napi_value export_sqlite3_expanded_sql(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_expanded_sql(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#if defined(SQLITE_ENABLE_NORMALIZE)
+#pragma weak sqlite3_normalized_sql
+static napi_value export_sqlite3_normalized_sql(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_normalized_sql(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+#endif
+
+#pragma weak sqlite3_stmt_readonly
+static napi_value export_sqlite3_stmt_readonly(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_stmt_readonly(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_stmt_isexplain
+static napi_value export_sqlite3_stmt_isexplain(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_stmt_isexplain(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_stmt_busy
+static napi_value export_sqlite3_stmt_busy(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_stmt_busy(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_blob
+static napi_value export_sqlite3_bind_blob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_bind_blob(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_blob64
+static napi_value export_sqlite3_bind_blob64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_bind_blob64(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i64(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_double
+static napi_value export_sqlite3_bind_double(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_double(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_f64(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_int
+static napi_value export_sqlite3_bind_int(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_int(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_int64
+static napi_value export_sqlite3_bind_int64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_int64(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i64(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_null
+static napi_value export_sqlite3_bind_null(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_bind_null(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_text
+static napi_value export_sqlite3_bind_text(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_bind_text(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_text64
+static napi_value export_sqlite3_bind_text64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3_bind_text64(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i64(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]), arg_i32(env, argv[5]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_value
+static napi_value export_sqlite3_bind_value(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_value(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_pointer
+static napi_value export_sqlite3_bind_pointer(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_bind_pointer(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_zeroblob
+static napi_value export_sqlite3_bind_zeroblob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_zeroblob(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_zeroblob64
+static napi_value export_sqlite3_bind_zeroblob64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_bind_zeroblob64(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i64(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_parameter_count
+static napi_value export_sqlite3_bind_parameter_count(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_bind_parameter_count(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_bind_parameter_name
+static napi_value export_sqlite3_bind_parameter_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_bind_parameter_name(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_bind_parameter_index
+static napi_value export_sqlite3_bind_parameter_index(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_bind_parameter_index(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_clear_bindings
+static napi_value export_sqlite3_clear_bindings(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_clear_bindings(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_column_count
+static napi_value export_sqlite3_column_count(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_column_count(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_column_name
+static napi_value export_sqlite3_column_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_name(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_database_name
+static napi_value export_sqlite3_column_database_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_database_name(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_table_name
+static napi_value export_sqlite3_column_table_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_table_name(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_origin_name
+static napi_value export_sqlite3_column_origin_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_origin_name(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_decltype
+static napi_value export_sqlite3_column_decltype(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_decltype(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_step
+static napi_value export_sqlite3_step(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_step(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_data_count
+static napi_value export_sqlite3_data_count(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_data_count(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_column_blob
+static napi_value export_sqlite3_column_blob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_blob(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_double
+static napi_value export_sqlite3_column_double(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	double r = sqlite3_column_double(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_f64(env, r);
+}
+
+#pragma weak sqlite3_column_int
+static napi_value export_sqlite3_column_int(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_column_int(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_column_int64
+static napi_value export_sqlite3_column_int64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_int64 r = sqlite3_column_int64(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_column_text
+static napi_value export_sqlite3_column_text(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_text(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_value
+static napi_value export_sqlite3_column_value(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_column_value(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_column_bytes
+static napi_value export_sqlite3_column_bytes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_column_bytes(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_column_type
+static napi_value export_sqlite3_column_type(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_column_type(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_finalize
+static napi_value export_sqlite3_finalize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_finalize(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_reset
+static napi_value export_sqlite3_reset(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_reset(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_create_function
+static napi_value export_sqlite3_create_function(napi_env env, napi_callback_info info)
+{
+	napi_value argv[8];
+	get_args(env, info, argv, 8);
+	int r = sqlite3_create_function(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]), arg_pointer(env, argv[4]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[5]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[6]), (void (*)(sqlite3_context*))arg_function(env, argv[7]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_create_function_v2
+static napi_value export_sqlite3_create_function_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[9];
+	get_args(env, info, argv, 9);
+	int r = sqlite3_create_function_v2(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]), arg_pointer(env, argv[4]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[5]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[6]), (void (*)(sqlite3_context*))arg_function(env, argv[7]), (void(*)(void*))arg_function(env, argv[8]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_create_window_function
+static napi_value export_sqlite3_create_window_function(napi_env env, napi_callback_info info)
+{
+	napi_value argv[10];
+	get_args(env, info, argv, 10);
+	int r = sqlite3_create_window_function(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]), arg_pointer(env, argv[4]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[5]), (void (*)(sqlite3_context*))arg_function(env, argv[6]), (void (*)(sqlite3_context*))arg_function(env, argv[7]), (void (*)(sqlite3_context*,int,sqlite3_value**))arg_function(env, argv[8]), (void(*)(void*))arg_function(env, argv[9]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_blob
+static napi_value export_sqlite3_value_blob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_value_blob(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_value_double
+static napi_value export_sqlite3_value_double(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	double r = sqlite3_value_double(arg_pointer(env, argv[0]));
+	return ret_f64(env, r);
+}
+
+#pragma weak sqlite3_value_int
+static napi_value export_sqlite3_value_int(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_int(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_int64
+static napi_value export_sqlite3_value_int64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_value_int64(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_value_pointer
+static napi_value export_sqlite3_value_pointer(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_value_pointer(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_value_text
+static napi_value export_sqlite3_value_text(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_value_text(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_value_bytes
+static napi_value export_sqlite3_value_bytes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_bytes(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_type
+static napi_value export_sqlite3_value_type(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_type(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_numeric_type
+static napi_value export_sqlite3_value_numeric_type(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_numeric_type(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_nochange
+static napi_value export_sqlite3_value_nochange(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_nochange(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_frombind
+static napi_value export_sqlite3_value_frombind(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_frombind(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_subtype
+static napi_value export_sqlite3_value_subtype(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_value_subtype(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_value_dup
+static napi_value export_sqlite3_value_dup(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_value_dup(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_value_free
+static napi_value export_sqlite3_value_free(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_value_free(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_aggregate_context
+static napi_value export_sqlite3_aggregate_context(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_aggregate_context(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_user_data
+static napi_value export_sqlite3_user_data(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_user_data(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_context_db_handle
+static napi_value export_sqlite3_context_db_handle(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_context_db_handle(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_get_auxdata
+static napi_value export_sqlite3_get_auxdata(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_get_auxdata(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_set_auxdata
+static napi_value export_sqlite3_set_auxdata(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_set_auxdata(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), (void (*)(void*))arg_function(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_blob
+static napi_value export_sqlite3_result_blob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_result_blob(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_blob64
+static napi_value export_sqlite3_result_blob64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_result_blob64(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i64(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_double
+static napi_value export_sqlite3_result_double(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_double(arg_pointer(env, argv[0]), arg_f64(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_error
+static napi_value export_sqlite3_result_error(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3_result_error(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_error_toobig
+static napi_value export_sqlite3_result_error_toobig(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_result_error_toobig(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_error_nomem
+static napi_value export_sqlite3_result_error_nomem(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_result_error_nomem(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_error_code
+static napi_value export_sqlite3_result_error_code(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_error_code(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_int
+static napi_value export_sqlite3_result_int(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_int(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_int64
+static napi_value export_sqlite3_result_int64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_int64(arg_pointer(env, argv[0]), arg_i64(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_null
+static napi_value export_sqlite3_result_null(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_result_null(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_text
+static napi_value export_sqlite3_result_text(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_result_text(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_text64
+static napi_value export_sqlite3_result_text64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	sqlite3_result_text64(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i64(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]), arg_i32(env, argv[4]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_value
+static napi_value export_sqlite3_result_value(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_value(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_pointer
+static napi_value export_sqlite3_result_pointer(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	sqlite3_result_pointer(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_zeroblob
+static napi_value export_sqlite3_result_zeroblob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_zeroblob(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_result_zeroblob64
+static napi_value export_sqlite3_result_zeroblob64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_result_zeroblob64(arg_pointer(env, argv[0]), arg_i64(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_result_subtype
+static napi_value export_sqlite3_result_subtype(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_result_subtype(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_create_collation
+static napi_value export_sqlite3_create_collation(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_create_collation(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]), (int(*)(void*,int,const void*,int,const void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_create_collation_v2
+static napi_value export_sqlite3_create_collation_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3_create_collation_v2(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]), (int(*)(void*,int,const void*,int,const void*))arg_function(env, argv[4]), (void(*)(void*))arg_function(env, argv[5]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_collation_needed
+static napi_value export_sqlite3_collation_needed(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_collation_needed(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), (void(*)(void*,sqlite3*,int eTextRep,const char*))arg_function(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#if defined(SQLITE_ENABLE_CEROD)
+#pragma weak sqlite3_activate_cerod
+static napi_value export_sqlite3_activate_cerod(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_activate_cerod(arg_pointer(env, argv[0]));
+	return NULL;
+}
+#endif
+
+#pragma weak sqlite3_sleep
+static napi_value export_sqlite3_sleep(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_sleep(arg_i32(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_get_autocommit
+static napi_value export_sqlite3_get_autocommit(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_get_autocommit(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_db_handle
+static napi_value export_sqlite3_db_handle(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_db_handle(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_db_filename
+static napi_value export_sqlite3_db_filename(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_db_filename(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_db_readonly
+static napi_value export_sqlite3_db_readonly(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_db_readonly(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_txn_state
+static napi_value export_sqlite3_txn_state(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_txn_state(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_next_stmt
+static napi_value export_sqlite3_next_stmt(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_next_stmt(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_commit_hook
+static napi_value export_sqlite3_commit_hook(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	const void *r = sqlite3_commit_hook(arg_pointer(env, argv[0]), (int(*)(void*))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_rollback_hook
+static napi_value export_sqlite3_rollback_hook(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	const void *r = sqlite3_rollback_hook(arg_pointer(env, argv[0]), (void(*)(void *))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_autovacuum_pages
+static napi_value export_sqlite3_autovacuum_pages(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_autovacuum_pages(arg_pointer(env, argv[0]), (unsigned int(*)(void*,const char*,unsigned int,unsigned int,unsigned int))arg_function(env, argv[1]), arg_pointer(env, argv[2]), (void(*)(void*))arg_function(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_update_hook
+static napi_value export_sqlite3_update_hook(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	const void *r = sqlite3_update_hook(arg_pointer(env, argv[0]), (void(*)(void *,int ,char const *,char const *,sqlite3_int64))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_enable_shared_cache
+static napi_value export_sqlite3_enable_shared_cache(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_enable_shared_cache(arg_i32(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_release_memory
+static napi_value export_sqlite3_release_memory(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_release_memory(arg_i32(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_db_release_memory
+static napi_value export_sqlite3_db_release_memory(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_db_release_memory(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_soft_heap_limit64
+static napi_value export_sqlite3_soft_heap_limit64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_soft_heap_limit64(arg_i64(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_hard_heap_limit64
+static napi_value export_sqlite3_hard_heap_limit64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3_hard_heap_limit64(arg_i64(env, argv[0]));
+	return ret_i64(env, r);
+}
+
+#pragma weak sqlite3_table_column_metadata
+static napi_value export_sqlite3_table_column_metadata(napi_env env, napi_callback_info info)
+{
+	napi_value argv[9];
+	get_args(env, info, argv, 9);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	uint32_t slot5 = arg_u32(env, argv[5]);
+	void *out5 = load_pointer(slot5);
+	int r = sqlite3_table_column_metadata(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), slot4 != 0 ? (void *)&out4 : NULL, slot5 != 0 ? (void *)&out5 : NULL, arg_pointer(env, argv[6]), arg_pointer(env, argv[7]), arg_pointer(env, argv[8]));
+	store_pointer(slot4, out4);
+	store_pointer(slot5, out5);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_load_extension
+static napi_value export_sqlite3_load_extension(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	int r = sqlite3_load_extension(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL);
+	store_pointer(slot3, out3);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_enable_load_extension
+static napi_value export_sqlite3_enable_load_extension(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_enable_load_extension(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_auto_extension
+static napi_value export_sqlite3_auto_extension(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_auto_extension((void(*)(void))arg_function(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_cancel_auto_extension
+static napi_value export_sqlite3_cancel_auto_extension(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_cancel_auto_extension((void(*)(void))arg_function(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_reset_auto_extension
+static napi_value export_sqlite3_reset_auto_extension(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_reset_auto_extension();
+	return NULL;
+}
+
+#pragma weak sqlite3_create_module
+static napi_value export_sqlite3_create_module(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_create_module(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_create_module_v2
+static napi_value export_sqlite3_create_module_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_create_module_v2(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), (void(*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_drop_modules
+static napi_value export_sqlite3_drop_modules(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3_drop_modules(arg_pointer(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL);
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_declare_vtab
+static napi_value export_sqlite3_declare_vtab(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_declare_vtab(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_overload_function
+static napi_value export_sqlite3_overload_function(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_overload_function(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_open
+static napi_value export_sqlite3_blob_open(napi_env env, napi_callback_info info)
+{
+	napi_value argv[7];
+	get_args(env, info, argv, 7);
+	uint32_t slot6 = arg_u32(env, argv[6]);
+	void *out6 = load_pointer(slot6);
+	int r = sqlite3_blob_open(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), arg_i64(env, argv[4]), arg_i32(env, argv[5]), slot6 != 0 ? (void *)&out6 : NULL);
+	store_pointer(slot6, out6);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_reopen
+static napi_value export_sqlite3_blob_reopen(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_blob_reopen(arg_pointer(env, argv[0]), arg_i64(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_close
+static napi_value export_sqlite3_blob_close(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_blob_close(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_bytes
+static napi_value export_sqlite3_blob_bytes(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_blob_bytes(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_read
+static napi_value export_sqlite3_blob_read(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_blob_read(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_blob_write
+static napi_value export_sqlite3_blob_write(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_blob_write(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_vfs_find
+static napi_value export_sqlite3_vfs_find(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_vfs_find(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_vfs_register
+static napi_value export_sqlite3_vfs_register(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_vfs_register(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_vfs_unregister
+static napi_value export_sqlite3_vfs_unregister(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_vfs_unregister(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_mutex_alloc
+static napi_value export_sqlite3_mutex_alloc(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_mutex_alloc(arg_i32(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_mutex_free
+static napi_value export_sqlite3_mutex_free(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_mutex_free(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_mutex_enter
+static napi_value export_sqlite3_mutex_enter(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_mutex_enter(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_mutex_try
+static napi_value export_sqlite3_mutex_try(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_mutex_try(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_mutex_leave
+static napi_value export_sqlite3_mutex_leave(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_mutex_leave(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_mutex_held
+static napi_value export_sqlite3_mutex_held(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_mutex_held(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_mutex_notheld
+static napi_value export_sqlite3_mutex_notheld(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_mutex_notheld(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_db_mutex
+static napi_value export_sqlite3_db_mutex(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_db_mutex(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_file_control
+static napi_value export_sqlite3_file_control(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_file_control(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_keyword_count
+static napi_value export_sqlite3_keyword_count(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_keyword_count();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_keyword_name
+static napi_value export_sqlite3_keyword_name(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3_keyword_name(arg_i32(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL, arg_pointer(env, argv[2]));
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_keyword_check
+static napi_value export_sqlite3_keyword_check(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_keyword_check(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_str_new
+static napi_value export_sqlite3_str_new(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_str_new(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_str_finish
+static napi_value export_sqlite3_str_finish(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_str_finish(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_str_append
+static napi_value export_sqlite3_str_append(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3_str_append(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return NULL;
+}
+
+#pragma weak sqlite3_str_appendall
+static napi_value export_sqlite3_str_appendall(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	sqlite3_str_appendall(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return NULL;
+}
+
+#pragma weak sqlite3_str_appendchar
+static napi_value export_sqlite3_str_appendchar(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3_str_appendchar(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return NULL;
+}
+
+#pragma weak sqlite3_str_reset
+static napi_value export_sqlite3_str_reset(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_str_reset(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_str_errcode
+static napi_value export_sqlite3_str_errcode(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_str_errcode(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_str_length
+static napi_value export_sqlite3_str_length(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_str_length(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_str_value
+static napi_value export_sqlite3_str_value(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	const void *r = sqlite3_str_value(arg_pointer(env, argv[0]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_status
+static napi_value export_sqlite3_status(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_status(arg_i32(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_status64
+static napi_value export_sqlite3_status64(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_status64(arg_i32(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_db_status
+static napi_value export_sqlite3_db_status(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_db_status(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), arg_i32(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_stmt_status
+static napi_value export_sqlite3_stmt_status(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_stmt_status(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_backup_init
+static napi_value export_sqlite3_backup_init(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	const void *r = sqlite3_backup_init(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_backup_step
+static napi_value export_sqlite3_backup_step(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_backup_step(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_backup_finish
+static napi_value export_sqlite3_backup_finish(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_backup_finish(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_backup_remaining
+static napi_value export_sqlite3_backup_remaining(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_backup_remaining(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_backup_pagecount
+static napi_value export_sqlite3_backup_pagecount(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_backup_pagecount(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_unlock_notify
+static napi_value export_sqlite3_unlock_notify(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_unlock_notify(arg_pointer(env, argv[0]), (void (*)(void **apArg, int nArg))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_stricmp
+static napi_value export_sqlite3_stricmp(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_stricmp(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_strnicmp
+static napi_value export_sqlite3_strnicmp(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_strnicmp(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_strglob
+static napi_value export_sqlite3_strglob(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_strglob(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_strlike
+static napi_value export_sqlite3_strlike(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_strlike(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_wal_hook
+static napi_value export_sqlite3_wal_hook(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	const void *r = sqlite3_wal_hook(arg_pointer(env, argv[0]), (int(*)(void *,sqlite3*,const char*,int))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_wal_autocheckpoint
+static napi_value export_sqlite3_wal_autocheckpoint(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_wal_autocheckpoint(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_wal_checkpoint
+static napi_value export_sqlite3_wal_checkpoint(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_wal_checkpoint(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_wal_checkpoint_v2
+static napi_value export_sqlite3_wal_checkpoint_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_wal_checkpoint_v2(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]), arg_pointer(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_vtab_on_conflict
+static napi_value export_sqlite3_vtab_on_conflict(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_vtab_on_conflict(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_vtab_nochange
+static napi_value export_sqlite3_vtab_nochange(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_vtab_nochange(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_vtab_collation
+static napi_value export_sqlite3_vtab_collation(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	const void *r = sqlite3_vtab_collation(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_stmt_scanstatus
+static napi_value export_sqlite3_stmt_scanstatus(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_stmt_scanstatus(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_stmt_scanstatus_reset
+static napi_value export_sqlite3_stmt_scanstatus_reset(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_stmt_scanstatus_reset(arg_pointer(env, argv[0]));
+	return NULL;
+}
+
+#pragma weak sqlite3_db_cacheflush
+static napi_value export_sqlite3_db_cacheflush(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_db_cacheflush(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_hook
+static napi_value export_sqlite3_preupdate_hook(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	const void *r = sqlite3_preupdate_hook(arg_pointer(env, argv[0]), (void(*)(    void *pCtx,                       sqlite3 *db,                      int op,                           char const *zDb,                  char const *zName,                sqlite3_int64 iKey1,              sqlite3_int64 iKey2             ))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_pointer(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_old
+static napi_value export_sqlite3_preupdate_old(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3_preupdate_old(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_count
+static napi_value export_sqlite3_preupdate_count(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_preupdate_count(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_depth
+static napi_value export_sqlite3_preupdate_depth(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_preupdate_depth(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_new
+static napi_value export_sqlite3_preupdate_new(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3_preupdate_new(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+#pragma weak sqlite3_preupdate_blobwrite
+static napi_value export_sqlite3_preupdate_blobwrite(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_preupdate_blobwrite(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#pragma weak sqlite3_system_errno
+static napi_value export_sqlite3_system_errno(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_system_errno(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_snapshot_get
+static napi_value export_sqlite3_snapshot_get(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3_snapshot_get(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_snapshot_open
+static napi_value export_sqlite3_snapshot_open(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_snapshot_open(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_snapshot_cmp
+static napi_value export_sqlite3_snapshot_cmp(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_snapshot_cmp(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_snapshot_recover
+static napi_value export_sqlite3_snapshot_recover(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3_snapshot_recover(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_serialize
+static napi_value export_sqlite3_serialize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	const void *r = sqlite3_serialize(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_pointer(env, r);
+}
+
+#pragma weak sqlite3_deserialize
+static napi_value export_sqlite3_deserialize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3_deserialize(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), arg_i64(env, argv[3]), arg_i64(env, argv[4]), arg_i32(env, argv[5]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_rtree_geometry_callback
+static napi_value export_sqlite3_rtree_geometry_callback(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_rtree_geometry_callback(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), (int (*)(sqlite3_rtree_geometry*, int, sqlite3_rtree_dbl*,int*))arg_function(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_rtree_query_callback
+static napi_value export_sqlite3_rtree_query_callback(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_rtree_query_callback(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), (int (*)(sqlite3_rtree_query_info*))arg_function(env, argv[2]), arg_pointer(env, argv[3]), (void (*)(void*))arg_function(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_create
+static napi_value export_sqlite3session_create(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3session_create(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_delete
+static napi_value export_sqlite3session_delete(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3session_delete(arg_pointer(env, argv[0]));
+	return NULL;
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_object_config
+static napi_value export_sqlite3session_object_config(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3session_object_config(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_enable
+static napi_value export_sqlite3session_enable(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3session_enable(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_indirect
+static napi_value export_sqlite3session_indirect(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3session_indirect(arg_pointer(env, argv[0]), arg_i32(env, argv[1]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_attach
+static napi_value export_sqlite3session_attach(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3session_attach(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_table_filter
+static napi_value export_sqlite3session_table_filter(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3session_table_filter(arg_pointer(env, argv[0]), (int(*)(    void *pCtx,                       const char *zTab                ))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return NULL;
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_changeset
+static napi_value export_sqlite3session_changeset(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3session_changeset(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_changeset_size
+static napi_value export_sqlite3session_changeset_size(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3session_changeset_size(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_diff
+static napi_value export_sqlite3session_diff(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	int r = sqlite3session_diff(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL);
+	store_pointer(slot3, out3);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_patchset
+static napi_value export_sqlite3session_patchset(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3session_patchset(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_isempty
+static napi_value export_sqlite3session_isempty(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3session_isempty(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_memory_used
+static napi_value export_sqlite3session_memory_used(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3_int64 r = sqlite3session_memory_used(arg_pointer(env, argv[0]));
+	return ret_i64(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_start
+static napi_value export_sqlite3changeset_start(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3changeset_start(slot0 != 0 ? (void *)&out0 : NULL, arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_start_v2
+static napi_value export_sqlite3changeset_start_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3changeset_start_v2(slot0 != 0 ? (void *)&out0 : NULL, arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_next
+static napi_value export_sqlite3changeset_next(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3changeset_next(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_op
+static napi_value export_sqlite3changeset_op(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3changeset_op(arg_pointer(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL, arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), arg_pointer(env, argv[4]));
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_pk
+static napi_value export_sqlite3changeset_pk(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot1 = arg_u32(env, argv[1]);
+	void *out1 = load_pointer(slot1);
+	int r = sqlite3changeset_pk(arg_pointer(env, argv[0]), slot1 != 0 ? (void *)&out1 : NULL, arg_pointer(env, argv[2]));
+	store_pointer(slot1, out1);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_old
+static napi_value export_sqlite3changeset_old(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3changeset_old(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_new
+static napi_value export_sqlite3changeset_new(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3changeset_new(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_conflict
+static napi_value export_sqlite3changeset_conflict(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3changeset_conflict(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_fk_conflicts
+static napi_value export_sqlite3changeset_fk_conflicts(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3changeset_fk_conflicts(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_finalize
+static napi_value export_sqlite3changeset_finalize(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3changeset_finalize(arg_pointer(env, argv[0]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_invert
+static napi_value export_sqlite3changeset_invert(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	int r = sqlite3changeset_invert(arg_i32(env, argv[0]), arg_pointer(env, argv[1]), arg_pointer(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL);
+	store_pointer(slot3, out3);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_concat
+static napi_value export_sqlite3changeset_concat(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	uint32_t slot5 = arg_u32(env, argv[5]);
+	void *out5 = load_pointer(slot5);
+	int r = sqlite3changeset_concat(arg_i32(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_pointer(env, argv[3]), arg_pointer(env, argv[4]), slot5 != 0 ? (void *)&out5 : NULL);
+	store_pointer(slot5, out5);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_new
+static napi_value export_sqlite3changegroup_new(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3changegroup_new(slot0 != 0 ? (void *)&out0 : NULL);
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_add
+static napi_value export_sqlite3changegroup_add(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3changegroup_add(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_output
+static napi_value export_sqlite3changegroup_output(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3changegroup_output(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL);
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_delete
+static napi_value export_sqlite3changegroup_delete(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3changegroup_delete(arg_pointer(env, argv[0]));
+	return NULL;
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_apply
+static napi_value export_sqlite3changeset_apply(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3changeset_apply(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), (int(*)(    void *pCtx,                       const char *zTab                ))arg_function(env, argv[3]), (int(*)(    void *pCtx,                       int eConflict,                    sqlite3_changeset_iter *p       ))arg_function(env, argv[4]), arg_pointer(env, argv[5]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_apply_v2
+static napi_value export_sqlite3changeset_apply_v2(napi_env env, napi_callback_info info)
+{
+	napi_value argv[9];
+	get_args(env, info, argv, 9);
+	uint32_t slot6 = arg_u32(env, argv[6]);
+	void *out6 = load_pointer(slot6);
+	int r = sqlite3changeset_apply_v2(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), (int(*)(    void *pCtx,                       const char *zTab                ))arg_function(env, argv[3]), (int(*)(    void *pCtx,                       int eConflict,                    sqlite3_changeset_iter *p       ))arg_function(env, argv[4]), arg_pointer(env, argv[5]), slot6 != 0 ? (void *)&out6 : NULL, arg_pointer(env, argv[7]), arg_i32(env, argv[8]));
+	store_pointer(slot6, out6);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3rebaser_create
+static napi_value export_sqlite3rebaser_create(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3rebaser_create(slot0 != 0 ? (void *)&out0 : NULL);
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3rebaser_configure
+static napi_value export_sqlite3rebaser_configure(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3rebaser_configure(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3rebaser_rebase
+static napi_value export_sqlite3rebaser_rebase(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	uint32_t slot4 = arg_u32(env, argv[4]);
+	void *out4 = load_pointer(slot4);
+	int r = sqlite3rebaser_rebase(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_pointer(env, argv[3]), slot4 != 0 ? (void *)&out4 : NULL);
+	store_pointer(slot4, out4);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3rebaser_delete
+static napi_value export_sqlite3rebaser_delete(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	sqlite3rebaser_delete(arg_pointer(env, argv[0]));
+	return NULL;
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_apply_strm
+static napi_value export_sqlite3changeset_apply_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3changeset_apply_strm(arg_pointer(env, argv[0]), (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]), (int(*)(    void *pCtx,                       const char *zTab                ))arg_function(env, argv[3]), (int(*)(    void *pCtx,                       int eConflict,                    sqlite3_changeset_iter *p       ))arg_function(env, argv[4]), arg_pointer(env, argv[5]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_apply_v2_strm
+static napi_value export_sqlite3changeset_apply_v2_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[9];
+	get_args(env, info, argv, 9);
+	uint32_t slot6 = arg_u32(env, argv[6]);
+	void *out6 = load_pointer(slot6);
+	int r = sqlite3changeset_apply_v2_strm(arg_pointer(env, argv[0]), (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]), (int(*)(    void *pCtx,                       const char *zTab                ))arg_function(env, argv[3]), (int(*)(    void *pCtx,                       int eConflict,                    sqlite3_changeset_iter *p       ))arg_function(env, argv[4]), arg_pointer(env, argv[5]), slot6 != 0 ? (void *)&out6 : NULL, arg_pointer(env, argv[7]), arg_i32(env, argv[8]));
+	store_pointer(slot6, out6);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_concat_strm
+static napi_value export_sqlite3changeset_concat_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[6];
+	get_args(env, info, argv, 6);
+	int r = sqlite3changeset_concat_strm((int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[0]), arg_pointer(env, argv[1]), (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[2]), arg_pointer(env, argv[3]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[4]), arg_pointer(env, argv[5]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_invert_strm
+static napi_value export_sqlite3changeset_invert_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3changeset_invert_strm((int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[0]), arg_pointer(env, argv[1]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[2]), arg_pointer(env, argv[3]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_start_strm
+static napi_value export_sqlite3changeset_start_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3changeset_start_strm(slot0 != 0 ? (void *)&out0 : NULL, (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changeset_start_v2_strm
+static napi_value export_sqlite3changeset_start_v2_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot0 = arg_u32(env, argv[0]);
+	void *out0 = load_pointer(slot0);
+	int r = sqlite3changeset_start_v2_strm(slot0 != 0 ? (void *)&out0 : NULL, (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	store_pointer(slot0, out0);
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_changeset_strm
+static napi_value export_sqlite3session_changeset_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3session_changeset_strm(arg_pointer(env, argv[0]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_patchset_strm
+static napi_value export_sqlite3session_patchset_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3session_patchset_strm(arg_pointer(env, argv[0]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_add_strm
+static napi_value export_sqlite3changegroup_add_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3changegroup_add_strm(arg_pointer(env, argv[0]), (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3changegroup_output_strm
+static napi_value export_sqlite3changegroup_output_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3changegroup_output_strm(arg_pointer(env, argv[0]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3rebaser_rebase_strm
+static napi_value export_sqlite3rebaser_rebase_strm(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3rebaser_rebase_strm(arg_pointer(env, argv[0]), (int (*)(void *pIn, void *pData, int *pnData))arg_function(env, argv[1]), arg_pointer(env, argv[2]), (int (*)(void *pOut, const void *pData, int nData))arg_function(env, argv[3]), arg_pointer(env, argv[4]));
+	return ret_i32(env, r);
+}
+#endif
+
+#if defined(SQLITE_ENABLE_SESSION)
+#pragma weak sqlite3session_config
+static napi_value export_sqlite3session_config(napi_env env, napi_callback_info info)
+{
+	napi_value argv[2];
+	get_args(env, info, argv, 2);
+	int r = sqlite3session_config(arg_i32(env, argv[0]), arg_pointer(env, argv[1]));
+	return ret_i32(env, r);
+}
+#endif
+
+#pragma weak sqlite3_ext_init
+static napi_value export_sqlite3_ext_init(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_ext_init();
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_vfs_register
+static napi_value export_sqlite3_ext_vfs_register(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_ext_vfs_register(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_vfs_unregister
+static napi_value export_sqlite3_ext_vfs_unregister(napi_env env, napi_callback_info info)
+{
+	napi_value argv[1];
+	get_args(env, info, argv, 1);
+	int r = sqlite3_ext_vfs_unregister(arg_i32(env, argv[0]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_exec
+static napi_value export_sqlite3_ext_exec(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot3 = arg_u32(env, argv[3]);
+	void *out3 = load_pointer(slot3);
+	int r = sqlite3_ext_exec(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), slot3 != 0 ? (void *)&out3 : NULL);
+	store_pointer(slot3, out3);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_progress_handler
+static napi_value export_sqlite3_ext_progress_handler(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	sqlite3_ext_progress_handler(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_i32(env, argv[2]));
+	return NULL;
+}
+
+#pragma weak sqlite3_ext_bind_blob_free
+static napi_value export_sqlite3_ext_bind_blob_free(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	int r = sqlite3_ext_bind_blob_free(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), arg_pointer(env, argv[2]), arg_i32(env, argv[3]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_stmt_json
+static napi_value export_sqlite3_ext_stmt_json(napi_env env, napi_callback_info info)
+{
+	napi_value argv[4];
+	get_args(env, info, argv, 4);
+	uint32_t slot2 = arg_u32(env, argv[2]);
+	void *out2 = load_pointer(slot2);
+	int r = sqlite3_ext_stmt_json(arg_pointer(env, argv[0]), arg_i32(env, argv[1]), slot2 != 0 ? (void *)&out2 : NULL, arg_pointer(env, argv[3]));
+	store_pointer(slot2, out2);
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_fts5_tokenizer_register
+static napi_value export_sqlite3_ext_fts5_tokenizer_register(napi_env env, napi_callback_info info)
+{
+	napi_value argv[3];
+	get_args(env, info, argv, 3);
+	int r = sqlite3_ext_fts5_tokenizer_register(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]));
+	return ret_i32(env, r);
+}
+
+#pragma weak sqlite3_ext_rtree_load
+static napi_value export_sqlite3_ext_rtree_load(napi_env env, napi_callback_info info)
+{
+	napi_value argv[5];
+	get_args(env, info, argv, 5);
+	int r = sqlite3_ext_rtree_load(arg_pointer(env, argv[0]), arg_pointer(env, argv[1]), arg_i32(env, argv[2]), arg_i32(env, argv[3]), arg_pointer(env, argv[4]));
+	return ret_i32(env, r);
+}
+
+static const struct native_export native_exports[] = {
+	{ "sqlite3_libversion", export_sqlite3_libversion, (void *)sqlite3_libversion },
+	{ "sqlite3_sourceid", export_sqlite3_sourceid, (void *)sqlite3_sourceid },
+	{ "sqlite3_libversion_number", export_sqlite3_libversion_number, (void *)sqlite3_libversion_number },
+	{ "sqlite3_compileoption_used", export_sqlite3_compileoption_used, (void *)sqlite3_compileoption_used },
+	{ "sqlite3_compileoption_get", export_sqlite3_compileoption_get, (void *)sqlite3_compileoption_get },
+	{ "sqlite3_threadsafe", export_sqlite3_threadsafe, (void *)sqlite3_threadsafe },
+	{ "sqlite3_close", export_sqlite3_close, (void *)sqlite3_close },
+	{ "sqlite3_close_v2", export_sqlite3_close_v2, (void *)sqlite3_close_v2 },
+	{ "sqlite3_exec", export_sqlite3_exec, (void *)sqlite3_exec },
+	{ "sqlite3_initialize", export_sqlite3_initialize, (void *)sqlite3_initialize },
+	{ "sqlite3_shutdown", export_sqlite3_shutdown, (void *)sqlite3_shutdown },
+	{ "sqlite3_os_init", export_sqlite3_os_init, (void *)sqlite3_os_init },
+	{ "sqlite3_os_end", export_sqlite3_os_end, (void *)sqlite3_os_end },
+	{ "sqlite3_extended_result_codes", export_sqlite3_extended_result_codes, (void *)sqlite3_extended_result_codes },
+	{ "sqlite3_last_insert_rowid", export_sqlite3_last_insert_rowid, (void *)sqlite3_last_insert_rowid },
+	{ "sqlite3_set_last_insert_rowid", export_sqlite3_set_last_insert_rowid, (void *)sqlite3_set_last_insert_rowid },
+	{ "sqlite3_changes", export_sqlite3_changes, (void *)sqlite3_changes },
+	{ "sqlite3_changes64", export_sqlite3_changes64, (void *)sqlite3_changes64 },
+	{ "sqlite3_total_changes", export_sqlite3_total_changes, (void *)sqlite3_total_changes },
+	{ "sqlite3_total_changes64", export_sqlite3_total_changes64, (void *)sqlite3_total_changes64 },
+	{ "sqlite3_interrupt", export_sqlite3_interrupt, (void *)sqlite3_interrupt },
+	{ "sqlite3_complete", export_sqlite3_complete, (void *)sqlite3_complete },
+	{ "sqlite3_busy_handler", export_sqlite3_busy_handler, (void *)sqlite3_busy_handler },
+	{ "sqlite3_busy_timeout", export_sqlite3_busy_timeout, (void *)sqlite3_busy_timeout },
+	{ "sqlite3_malloc", export_sqlite3_malloc, (void *)sqlite3_malloc },
+	{ "sqlite3_malloc64", export_sqlite3_malloc64, (void *)sqlite3_malloc64 },
+	{ "sqlite3_realloc", export_sqlite3_realloc, (void *)sqlite3_realloc },
+	{ "sqlite3_realloc64", export_sqlite3_realloc64, (void *)sqlite3_realloc64 },
+	{ "sqlite3_free", export_sqlite3_free, (void *)sqlite3_free },
+	{ "sqlite3_msize", export_sqlite3_msize, (void *)sqlite3_msize },
+	{ "sqlite3_memory_used", export_sqlite3_memory_used, (void *)sqlite3_memory_used },
+	{ "sqlite3_memory_highwater", export_sqlite3_memory_highwater, (void *)sqlite3_memory_highwater },
+	{ "sqlite3_randomness", export_sqlite3_randomness, (void *)sqlite3_randomness },
+	{ "sqlite3_set_authorizer", export_sqlite3_set_authorizer, (void *)sqlite3_set_authorizer },
+	{ "sqlite3_trace_v2", export_sqlite3_trace_v2, (void *)sqlite3_trace_v2 },
+	{ "sqlite3_progress_handler", export_sqlite3_progress_handler, (void *)sqlite3_progress_handler },
+	{ "sqlite3_open", export_sqlite3_open, (void *)sqlite3_open },
+	{ "sqlite3_open_v2", export_sqlite3_open_v2, (void *)sqlite3_open_v2 },
+	{ "sqlite3_uri_parameter", export_sqlite3_uri_parameter, (void *)sqlite3_uri_parameter },
+	{ "sqlite3_uri_boolean", export_sqlite3_uri_boolean, (void *)sqlite3_uri_boolean },
+	{ "sqlite3_uri_int64", export_sqlite3_uri_int64, (void *)sqlite3_uri_int64 },
+	{ "sqlite3_uri_key", export_sqlite3_uri_key, (void *)sqlite3_uri_key },
+	{ "sqlite3_filename_database", export_sqlite3_filename_database, (void *)sqlite3_filename_database },
+	{ "sqlite3_filename_journal", export_sqlite3_filename_journal, (void *)sqlite3_filename_journal },
+	{ "sqlite3_filename_wal", export_sqlite3_filename_wal, (void *)sqlite3_filename_wal },
+	{ "sqlite3_database_file_object", export_sqlite3_database_file_object, (void *)sqlite3_database_file_object },
+	{ "sqlite3_create_filename", export_sqlite3_create_filename, (void *)sqlite3_create_filename },
+	{ "sqlite3_free_filename", export_sqlite3_free_filename, (void *)sqlite3_free_filename },
+	{ "sqlite3_errcode", export_sqlite3_errcode, (void *)sqlite3_errcode },
+	{ "sqlite3_extended_errcode", export_sqlite3_extended_errcode, (void *)sqlite3_extended_errcode },
+	{ "sqlite3_errmsg", export_sqlite3_errmsg, (void *)sqlite3_errmsg },
+	{ "sqlite3_errstr", export_sqlite3_errstr, (void *)sqlite3_errstr },
+	{ "sqlite3_limit", export_sqlite3_limit, (void *)sqlite3_limit },
+	{ "sqlite3_prepare", export_sqlite3_prepare, (void *)sqlite3_prepare },
+	{ "sqlite3_prepare_v2", export_sqlite3_prepare_v2, (void *)sqlite3_prepare_v2 },
+	{ "sqlite3_prepare_v3", export_sqlite3_prepare_v3, (void *)sqlite3_prepare_v3 },
+	{ "sqlite3_sql", export_sqlite3_sql, (void *)sqlite3_sql },
+	{ "sqlite3_expanded_sql", export_sqlite3_expanded_sql, (void *)sqlite3_expanded_sql },
+#if defined(SQLITE_ENABLE_NORMALIZE)
+	{ "sqlite3_normalized_sql", export_sqlite3_normalized_sql, (void *)sqlite3_normalized_sql },
+#endif
+	{ "sqlite3_stmt_readonly", export_sqlite3_stmt_readonly, (void *)sqlite3_stmt_readonly },
+	{ "sqlite3_stmt_isexplain", export_sqlite3_stmt_isexplain, (void *)sqlite3_stmt_isexplain },
+	{ "sqlite3_stmt_busy", export_sqlite3_stmt_busy, (void *)sqlite3_stmt_busy },
+	{ "sqlite3_bind_blob", export_sqlite3_bind_blob, (void *)sqlite3_bind_blob },
+	{ "sqlite3_bind_blob64", export_sqlite3_bind_blob64, (void *)sqlite3_bind_blob64 },
+	{ "sqlite3_bind_double", export_sqlite3_bind_double, (void *)sqlite3_bind_double },
+	{ "sqlite3_bind_int", export_sqlite3_bind_int, (void *)sqlite3_bind_int },
+	{ "sqlite3_bind_int64", export_sqlite3_bind_int64, (void *)sqlite3_bind_int64 },
+	{ "sqlite3_bind_null", export_sqlite3_bind_null, (void *)sqlite3_bind_null },
+	{ "sqlite3_bind_text", export_sqlite3_bind_text, (void *)sqlite3_bind_text },
+	{ "sqlite3_bind_text64", export_sqlite3_bind_text64, (void *)sqlite3_bind_text64 },
+	{ "sqlite3_bind_value", export_sqlite3_bind_value, (void *)sqlite3_bind_value },
+	{ "sqlite3_bind_pointer", export_sqlite3_bind_pointer, (void *)sqlite3_bind_pointer },
+	{ "sqlite3_bind_zeroblob", export_sqlite3_bind_zeroblob, (void *)sqlite3_bind_zeroblob },
+	{ "sqlite3_bind_zeroblob64", export_sqlite3_bind_zeroblob64, (void *)sqlite3_bind_zeroblob64 },
+	{ "sqlite3_bind_parameter_count", export_sqlite3_bind_parameter_count, (void *)sqlite3_bind_parameter_count },
+	{ "sqlite3_bind_parameter_name", export_sqlite3_bind_parameter_name, (void *)sqlite3_bind_parameter_name },
+	{ "sqlite3_bind_parameter_index", export_sqlite3_bind_parameter_index, (void *)sqlite3_bind_parameter_index },
+	{ "sqlite3_clear_bindings", export_sqlite3_clear_bindings, (void *)sqlite3_clear_bindings },
+	{ "sqlite3_column_count", export_sqlite3_column_count, (void *)sqlite3_column_count },
+	{ "sqlite3_column_name", export_sqlite3_column_name, (void *)sqlite3_column_name },
+	{ "sqlite3_column_database_name", export_sqlite3_column_database_name, (void *)sqlite3_column_database_name },
+	{ "sqlite3_column_table_name", export_sqlite3_column_table_name, (void *)sqlite3_column_table_name },
+	{ "sqlite3_column_origin_name", export_sqlite3_column_origin_name, (void *)sqlite3_column_origin_name },
+	{ "sqlite3_column_decltype", export_sqlite3_column_decltype, (void *)sqlite3_column_decltype },
+	{ "sqlite3_step", export_sqlite3_step, (void *)sqlite3_step },
+	{ "sqlite3_data_count", export_sqlite3_data_count, (void *)sqlite3_data_count },
+	{ "sqlite3_column_blob", export_sqlite3_column_blob, (void *)sqlite3_column_blob },
+	{ "sqlite3_column_double", export_sqlite3_column_double, (void *)sqlite3_column_double },
+	{ "sqlite3_column_int", export_sqlite3_column_int, (void *)sqlite3_column_int },
+	{ "sqlite3_column_int64", export_sqlite3_column_int64, (void *)sqlite3_column_int64 },
+	{ "sqlite3_column_text", export_sqlite3_column_text, (void *)sqlite3_column_text },
+	{ "sqlite3_column_value", export_sqlite3_column_value, (void *)sqlite3_column_value },
+	{ "sqlite3_column_bytes", export_sqlite3_column_bytes, (void *)sqlite3_column_bytes },
+	{ "sqlite3_column_type", export_sqlite3_column_type, (void *)sqlite3_column_type },
+	{ "sqlite3_finalize", export_sqlite3_finalize, (void *)sqlite3_finalize },
+	{ "sqlite3_reset", export_sqlite3_reset, (void *)sqlite3_reset },
+	{ "sqlite3_create_function", export_sqlite3_create_function, (void *)sqlite3_create_function },
+	{ "sqlite3_create_function_v2", export_sqlite3_create_function_v2, (void *)sqlite3_create_function_v2 },
+	{ "sqlite3_create_window_function", export_sqlite3_create_window_function, (void *)sqlite3_create_window_function },
+	{ "sqlite3_value_blob", export_sqlite3_value_blob, (void *)sqlite3_value_blob },
+	{ "sqlite3_value_double", export_sqlite3_value_double, (void *)sqlite3_value_double },
+	{ "sqlite3_value_int", export_sqlite3_value_int, (void *)sqlite3_value_int },
+	{ "sqlite3_value_int64", export_sqlite3_value_int64, (void *)sqlite3_value_int64 },
+	{ "sqlite3_value_pointer", export_sqlite3_value_pointer, (void *)sqlite3_value_pointer },
+	{ "sqlite3_value_text", export_sqlite3_value_text, (void *)sqlite3_value_text },
+	{ "sqlite3_value_bytes", export_sqlite3_value_bytes, (void *)sqlite3_value_bytes },
+	{ "sqlite3_value_type", export_sqlite3_value_type, (void *)sqlite3_value_type },
+	{ "sqlite3_value_numeric_type", export_sqlite3_value_numeric_type, (void *)sqlite3_value_numeric_type },
+	{ "sqlite3_value_nochange", export_sqlite3_value_nochange, (void *)sqlite3_value_nochange },
+	{ "sqlite3_value_frombind", export_sqlite3_value_frombind, (void *)sqlite3_value_frombind },
+	{ "sqlite3_value_subtype", export_sqlite3_value_subtype, (void *)sqlite3_value_subtype },
+	{ "sqlite3_value_dup", export_sqlite3_value_dup, (void *)sqlite3_value_dup },
+	{ "sqlite3_value_free", export_sqlite3_value_free, (void *)sqlite3_value_free },
+	{ "sqlite3_aggregate_context", export_sqlite3_aggregate_context, (void *)sqlite3_aggregate_context },
+	{ "sqlite3_user_data", export_sqlite3_user_data, (void *)sqlite3_user_data },
+	{ "sqlite3_context_db_handle", export_sqlite3_context_db_handle, (void *)sqlite3_context_db_handle },
+	{ "sqlite3_get_auxdata", export_sqlite3_get_auxdata, (void *)sqlite3_get_auxdata },
+	{ "sqlite3_set_auxdata", export_sqlite3_set_auxdata, (void *)sqlite3_set_auxdata },
+	{ "sqlite3_result_blob", export_sqlite3_result_blob, (void *)sqlite3_result_blob },
+	{ "sqlite3_result_blob64", export_sqlite3_result_blob64, (void *)sqlite3_result_blob64 },
+	{ "sqlite3_result_double", export_sqlite3_result_double, (void *)sqlite3_result_double },
+	{ "sqlite3_result_error", export_sqlite3_result_error, (void *)sqlite3_result_error },
+	{ "sqlite3_result_error_toobig", export_sqlite3_result_error_toobig, (void *)sqlite3_result_error_toobig },
+	{ "sqlite3_result_error_nomem", export_sqlite3_result_error_nomem, (void *)sqlite3_result_error_nomem },
+	{ "sqlite3_result_error_code", export_sqlite3_result_error_code, (void *)sqlite3_result_error_code },
+	{ "sqlite3_result_int", export_sqlite3_result_int, (void *)sqlite3_result_int },
+	{ "sqlite3_result_int64", export_sqlite3_result_int64, (void *)sqlite3_result_int64 },
+	{ "sqlite3_result_null", export_sqlite3_result_null, (void *)sqlite3_result_null },
+	{ "sqlite3_result_text", export_sqlite3_result_text, (void *)sqlite3_result_text },
+	{ "sqlite3_result_text64", export_sqlite3_result_text64, (void *)sqlite3_result_text64 },
+	{ "sqlite3_result_value", export_sqlite3_result_value, (void *)sqlite3_result_value },
+	{ "sqlite3_result_pointer", export_sqlite3_result_pointer, (void *)sqlite3_result_pointer },
+	{ "sqlite3_result_zeroblob", export_sqlite3_result_zeroblob, (void *)sqlite3_result_zeroblob },
+	{ "sqlite3_result_zeroblob64", export_sqlite3_result_zeroblob64, (void *)sqlite3_result_zeroblob64 },
+	{ "sqlite3_result_subtype", export_sqlite3_result_subtype, (void *)sqlite3_result_subtype },
+	{ "sqlite3_create_collation", export_sqlite3_create_collation, (void *)sqlite3_create_collation },
+	{ "sqlite3_create_collation_v2", export_sqlite3_create_collation_v2, (void *)sqlite3_create_collation_v2 },
+	{ "sqlite3_collation_needed", export_sqlite3_collation_needed, (void *)sqlite3_collation_needed },
+#if defined(SQLITE_ENABLE_CEROD)
+	{ "sqlite3_activate_cerod", export_sqlite3_activate_cerod, (void *)sqlite3_activate_cerod },
+#endif
+	{ "sqlite3_sleep", export_sqlite3_sleep, (void *)sqlite3_sleep },
+	{ "sqlite3_get_autocommit", export_sqlite3_get_autocommit, (void *)sqlite3_get_autocommit },
+	{ "sqlite3_db_handle", export_sqlite3_db_handle, (void *)sqlite3_db_handle },
+	{ "sqlite3_db_filename", export_sqlite3_db_filename, (void *)sqlite3_db_filename },
+	{ "sqlite3_db_readonly", export_sqlite3_db_readonly, (void *)sqlite3_db_readonly },
+	{ "sqlite3_txn_state", export_sqlite3_txn_state, (void *)sqlite3_txn_state },
+	{ "sqlite3_next_stmt", export_sqlite3_next_stmt, (void *)sqlite3_next_stmt },
+	{ "sqlite3_commit_hook", export_sqlite3_commit_hook, (void *)sqlite3_commit_hook },
+	{ "sqlite3_rollback_hook", export_sqlite3_rollback_hook, (void *)sqlite3_rollback_hook },
+	{ "sqlite3_autovacuum_pages", export_sqlite3_autovacuum_pages, (void *)sqlite3_autovacuum_pages },
+	{ "sqlite3_update_hook", export_sqlite3_update_hook, (void *)sqlite3_update_hook },
+	{ "sqlite3_enable_shared_cache", export_sqlite3_enable_shared_cache, (void *)sqlite3_enable_shared_cache },
+	{ "sqlite3_release_memory", export_sqlite3_release_memory, (void *)sqlite3_release_memory },
+	{ "sqlite3_db_release_memory", export_sqlite3_db_release_memory, (void *)sqlite3_db_release_memory },
+	{ "sqlite3_soft_heap_limit64", export_sqlite3_soft_heap_limit64, (void *)sqlite3_soft_heap_limit64 },
+	{ "sqlite3_hard_heap_limit64", export_sqlite3_hard_heap_limit64, (void *)sqlite3_hard_heap_limit64 },
+	{ "sqlite3_table_column_metadata", export_sqlite3_table_column_metadata, (void *)sqlite3_table_column_metadata },
+	{ "sqlite3_load_extension", export_sqlite3_load_extension, (void *)sqlite3_load_extension },
+	{ "sqlite3_enable_load_extension", export_sqlite3_enable_load_extension, (void *)sqlite3_enable_load_extension },
+	{ "sqlite3_auto_extension", export_sqlite3_auto_extension, (void *)sqlite3_auto_extension },
+	{ "sqlite3_cancel_auto_extension", export_sqlite3_cancel_auto_extension, (void *)sqlite3_cancel_auto_extension },
+	{ "sqlite3_reset_auto_extension", export_sqlite3_reset_auto_extension, (void *)sqlite3_reset_auto_extension },
+	{ "sqlite3_create_module", export_sqlite3_create_module, (void *)sqlite3_create_module },
+	{ "sqlite3_create_module_v2", export_sqlite3_create_module_v2, (void *)sqlite3_create_module_v2 },
+	{ "sqlite3_drop_modules", export_sqlite3_drop_modules, (void *)sqlite3_drop_modules },
+	{ "sqlite3_declare_vtab", export_sqlite3_declare_vtab, (void *)sqlite3_declare_vtab },
+	{ "sqlite3_overload_function", export_sqlite3_overload_function, (void *)sqlite3_overload_function },
+	{ "sqlite3_blob_open", export_sqlite3_blob_open, (void *)sqlite3_blob_open },
+	{ "sqlite3_blob_reopen", export_sqlite3_blob_reopen, (void *)sqlite3_blob_reopen },
+	{ "sqlite3_blob_close", export_sqlite3_blob_close, (void *)sqlite3_blob_close },
+	{ "sqlite3_blob_bytes", export_sqlite3_blob_bytes, (void *)sqlite3_blob_bytes },
+	{ "sqlite3_blob_read", export_sqlite3_blob_read, (void *)sqlite3_blob_read },
+	{ "sqlite3_blob_write", export_sqlite3_blob_write, (void *)sqlite3_blob_write },
+	{ "sqlite3_vfs_find", export_sqlite3_vfs_find, (void *)sqlite3_vfs_find },
+	{ "sqlite3_vfs_register", export_sqlite3_vfs_register, (void *)sqlite3_vfs_register },
+	{ "sqlite3_vfs_unregister", export_sqlite3_vfs_unregister, (void *)sqlite3_vfs_unregister },
+	{ "sqlite3_mutex_alloc", export_sqlite3_mutex_alloc, (void *)sqlite3_mutex_alloc },
+	{ "sqlite3_mutex_free", export_sqlite3_mutex_free, (void *)sqlite3_mutex_free },
+	{ "sqlite3_mutex_enter", export_sqlite3_mutex_enter, (void *)sqlite3_mutex_enter },
+	{ "sqlite3_mutex_try", export_sqlite3_mutex_try, (void *)sqlite3_mutex_try },
+	{ "sqlite3_mutex_leave", export_sqlite3_mutex_leave, (void *)sqlite3_mutex_leave },
+	{ "sqlite3_mutex_held", export_sqlite3_mutex_held, (void *)sqlite3_mutex_held },
+	{ "sqlite3_mutex_notheld", export_sqlite3_mutex_notheld, (void *)sqlite3_mutex_notheld },
+	{ "sqlite3_db_mutex", export_sqlite3_db_mutex, (void *)sqlite3_db_mutex },
+	{ "sqlite3_file_control", export_sqlite3_file_control, (void *)sqlite3_file_control },
+	{ "sqlite3_keyword_count", export_sqlite3_keyword_count, (void *)sqlite3_keyword_count },
+	{ "sqlite3_keyword_name", export_sqlite3_keyword_name, (void *)sqlite3_keyword_name },
+	{ "sqlite3_keyword_check", export_sqlite3_keyword_check, (void *)sqlite3_keyword_check },
+	{ "sqlite3_str_new", export_sqlite3_str_new, (void *)sqlite3_str_new },
+	{ "sqlite3_str_finish", export_sqlite3_str_finish, (void *)sqlite3_str_finish },
+	{ "sqlite3_str_append", export_sqlite3_str_append, (void *)sqlite3_str_append },
+	{ "sqlite3_str_appendall", export_sqlite3_str_appendall, (void *)sqlite3_str_appendall },
+	{ "sqlite3_str_appendchar", export_sqlite3_str_appendchar, (void *)sqlite3_str_appendchar },
+	{ "sqlite3_str_reset", export_sqlite3_str_reset, (void *)sqlite3_str_reset },
+	{ "sqlite3_str_errcode", export_sqlite3_str_errcode, (void *)sqlite3_str_errcode },
+	{ "sqlite3_str_length", export_sqlite3_str_length, (void *)sqlite3_str_length },
+	{ "sqlite3_str_value", export_sqlite3_str_value, (void *)sqlite3_str_value },
+	{ "sqlite3_status", export_sqlite3_status, (void *)sqlite3_status },
+	{ "sqlite3_status64", export_sqlite3_status64, (void *)sqlite3_status64 },
+	{ "sqlite3_db_status", export_sqlite3_db_status, (void *)sqlite3_db_status },
+	{ "sqlite3_stmt_status", export_sqlite3_stmt_status, (void *)sqlite3_stmt_status },
+	{ "sqlite3_backup_init", export_sqlite3_backup_init, (void *)sqlite3_backup_init },
+	{ "sqlite3_backup_step", export_sqlite3_backup_step, (void *)sqlite3_backup_step },
+	{ "sqlite3_backup_finish", export_sqlite3_backup_finish, (void *)sqlite3_backup_finish },
+	{ "sqlite3_backup_remaining", export_sqlite3_backup_remaining, (void *)sqlite3_backup_remaining },
+	{ "sqlite3_backup_pagecount", export_sqlite3_backup_pagecount, (void *)sqlite3_backup_pagecount },
+	{ "sqlite3_unlock_notify", export_sqlite3_unlock_notify, (void *)sqlite3_unlock_notify },
+	{ "sqlite3_stricmp", export_sqlite3_stricmp, (void *)sqlite3_stricmp },
+	{ "sqlite3_strnicmp", export_sqlite3_strnicmp, (void *)sqlite3_strnicmp },
+	{ "sqlite3_strglob", export_sqlite3_strglob, (void *)sqlite3_strglob },
+	{ "sqlite3_strlike", export_sqlite3_strlike, (void *)sqlite3_strlike },
+	{ "sqlite3_wal_hook", export_sqlite3_wal_hook, (void *)sqlite3_wal_hook },
+	{ "sqlite3_wal_autocheckpoint", export_sqlite3_wal_autocheckpoint, (void *)sqlite3_wal_autocheckpoint },
+	{ "sqlite3_wal_checkpoint", export_sqlite3_wal_checkpoint, (void *)sqlite3_wal_checkpoint },
+	{ "sqlite3_wal_checkpoint_v2", export_sqlite3_wal_checkpoint_v2, (void *)sqlite3_wal_checkpoint_v2 },
+	{ "sqlite3_vtab_on_conflict", export_sqlite3_vtab_on_conflict, (void *)sqlite3_vtab_on_conflict },
+	{ "sqlite3_vtab_nochange", export_sqlite3_vtab_nochange, (void *)sqlite3_vtab_nochange },
+	{ "sqlite3_vtab_collation", export_sqlite3_vtab_collation, (void *)sqlite3_vtab_collation },
+	{ "sqlite3_stmt_scanstatus", export_sqlite3_stmt_scanstatus, (void *)sqlite3_stmt_scanstatus },
+	{ "sqlite3_stmt_scanstatus_reset", export_sqlite3_stmt_scanstatus_reset, (void *)sqlite3_stmt_scanstatus_reset },
+	{ "sqlite3_db_cacheflush", export_sqlite3_db_cacheflush, (void *)sqlite3_db_cacheflush },
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_hook", export_sqlite3_preupdate_hook, (void *)sqlite3_preupdate_hook },
+#endif
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_old", export_sqlite3_preupdate_old, (void *)sqlite3_preupdate_old },
+#endif
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_count", export_sqlite3_preupdate_count, (void *)sqlite3_preupdate_count },
+#endif
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_depth", export_sqlite3_preupdate_depth, (void *)sqlite3_preupdate_depth },
+#endif
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_new", export_sqlite3_preupdate_new, (void *)sqlite3_preupdate_new },
+#endif
+#if defined(SQLITE_ENABLE_PREUPDATE_HOOK)
+	{ "sqlite3_preupdate_blobwrite", export_sqlite3_preupdate_blobwrite, (void *)sqlite3_preupdate_blobwrite },
+#endif
+	{ "sqlite3_system_errno", export_sqlite3_system_errno, (void *)sqlite3_system_errno },
+	{ "sqlite3_snapshot_get", export_sqlite3_snapshot_get, (void *)sqlite3_snapshot_get },
+	{ "sqlite3_snapshot_open", export_sqlite3_snapshot_open, (void *)sqlite3_snapshot_open },
+	{ "sqlite3_snapshot_cmp", export_sqlite3_snapshot_cmp, (void *)sqlite3_snapshot_cmp },
+	{ "sqlite3_snapshot_recover", export_sqlite3_snapshot_recover, (void *)sqlite3_snapshot_recover },
+	{ "sqlite3_serialize", export_sqlite3_serialize, (void *)sqlite3_serialize },
+	{ "sqlite3_deserialize", export_sqlite3_deserialize, (void *)sqlite3_deserialize },
+	{ "sqlite3_rtree_geometry_callback", export_sqlite3_rtree_geometry_callback, (void *)sqlite3_rtree_geometry_callback },
+	{ "sqlite3_rtree_query_callback", export_sqlite3_rtree_query_callback, (void *)sqlite3_rtree_query_callback },
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_create", export_sqlite3session_create, (void *)sqlite3session_create },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_delete", export_sqlite3session_delete, (void *)sqlite3session_delete },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_object_config", export_sqlite3session_object_config, (void *)sqlite3session_object_config },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_enable", export_sqlite3session_enable, (void *)sqlite3session_enable },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_indirect", export_sqlite3session_indirect, (void *)sqlite3session_indirect },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_attach", export_sqlite3session_attach, (void *)sqlite3session_attach },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_table_filter", export_sqlite3session_table_filter, (void *)sqlite3session_table_filter },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_changeset", export_sqlite3session_changeset, (void *)sqlite3session_changeset },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_changeset_size", export_sqlite3session_changeset_size, (void *)sqlite3session_changeset_size },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_diff", export_sqlite3session_diff, (void *)sqlite3session_diff },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_patchset", export_sqlite3session_patchset, (void *)sqlite3session_patchset },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_isempty", export_sqlite3session_isempty, (void *)sqlite3session_isempty },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_memory_used", export_sqlite3session_memory_used, (void *)sqlite3session_memory_used },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_start", export_sqlite3changeset_start, (void *)sqlite3changeset_start },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_start_v2", export_sqlite3changeset_start_v2, (void *)sqlite3changeset_start_v2 },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_next", export_sqlite3changeset_next, (void *)sqlite3changeset_next },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_op", export_sqlite3changeset_op, (void *)sqlite3changeset_op },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_pk", export_sqlite3changeset_pk, (void *)sqlite3changeset_pk },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_old", export_sqlite3changeset_old, (void *)sqlite3changeset_old },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_new", export_sqlite3changeset_new, (void *)sqlite3changeset_new },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_conflict", export_sqlite3changeset_conflict, (void *)sqlite3changeset_conflict },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_fk_conflicts", export_sqlite3changeset_fk_conflicts, (void *)sqlite3changeset_fk_conflicts },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_finalize", export_sqlite3changeset_finalize, (void *)sqlite3changeset_finalize },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_invert", export_sqlite3changeset_invert, (void *)sqlite3changeset_invert },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_concat", export_sqlite3changeset_concat, (void *)sqlite3changeset_concat },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_new", export_sqlite3changegroup_new, (void *)sqlite3changegroup_new },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_add", export_sqlite3changegroup_add, (void *)sqlite3changegroup_add },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_output", export_sqlite3changegroup_output, (void *)sqlite3changegroup_output },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_delete", export_sqlite3changegroup_delete, (void *)sqlite3changegroup_delete },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_apply", export_sqlite3changeset_apply, (void *)sqlite3changeset_apply },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_apply_v2", export_sqlite3changeset_apply_v2, (void *)sqlite3changeset_apply_v2 },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3rebaser_create", export_sqlite3rebaser_create, (void *)sqlite3rebaser_create },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3rebaser_configure", export_sqlite3rebaser_configure, (void *)sqlite3rebaser_configure },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3rebaser_rebase", export_sqlite3rebaser_rebase, (void *)sqlite3rebaser_rebase },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3rebaser_delete", export_sqlite3rebaser_delete, (void *)sqlite3rebaser_delete },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_apply_strm", export_sqlite3changeset_apply_strm, (void *)sqlite3changeset_apply_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_apply_v2_strm", export_sqlite3changeset_apply_v2_strm, (void *)sqlite3changeset_apply_v2_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_concat_strm", export_sqlite3changeset_concat_strm, (void *)sqlite3changeset_concat_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_invert_strm", export_sqlite3changeset_invert_strm, (void *)sqlite3changeset_invert_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_start_strm", export_sqlite3changeset_start_strm, (void *)sqlite3changeset_start_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changeset_start_v2_strm", export_sqlite3changeset_start_v2_strm, (void *)sqlite3changeset_start_v2_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_changeset_strm", export_sqlite3session_changeset_strm, (void *)sqlite3session_changeset_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_patchset_strm", export_sqlite3session_patchset_strm, (void *)sqlite3session_patchset_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_add_strm", export_sqlite3changegroup_add_strm, (void *)sqlite3changegroup_add_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3changegroup_output_strm", export_sqlite3changegroup_output_strm, (void *)sqlite3changegroup_output_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3rebaser_rebase_strm", export_sqlite3rebaser_rebase_strm, (void *)sqlite3rebaser_rebase_strm },
+#endif
+#if defined(SQLITE_ENABLE_SESSION)
+	{ "sqlite3session_config", export_sqlite3session_config, (void *)sqlite3session_config },
+#endif
+	{ "sqlite3_ext_init", export_sqlite3_ext_init, (void *)sqlite3_ext_init },
+	{ "sqlite3_ext_vfs_register", export_sqlite3_ext_vfs_register, (void *)sqlite3_ext_vfs_register },
+	{ "sqlite3_ext_vfs_unregister", export_sqlite3_ext_vfs_unregister, (void *)sqlite3_ext_vfs_unregister },
+	{ "sqlite3_ext_exec", export_sqlite3_ext_exec, (void *)sqlite3_ext_exec },
+	{ "sqlite3_ext_progress_handler", export_sqlite3_ext_progress_handler, (void *)sqlite3_ext_progress_handler },
+	{ "sqlite3_ext_bind_blob_free", export_sqlite3_ext_bind_blob_free, (void *)sqlite3_ext_bind_blob_free },
+	{ "sqlite3_ext_stmt_json", export_sqlite3_ext_stmt_json, (void *)sqlite3_ext_stmt_json },
+	{ "sqlite3_ext_fts5_tokenizer_register", export_sqlite3_ext_fts5_tokenizer_register, (void *)sqlite3_ext_fts5_tokenizer_register },
+	{ "sqlite3_ext_rtree_load", export_sqlite3_ext_rtree_load, (void *)sqlite3_ext_rtree_load },
+};
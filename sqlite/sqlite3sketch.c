@@ -0,0 +1,1169 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sqlite3wasm.h"
+
+/*
+** Approximate aggregates with mergeable states, linked into the full flavor
+** and registered for every connection by sqlite3_ext_init.
+**
+**   approx_count_distinct(X [, P])      HyperLogLog with 2^P registers
+**   approx_percentile(X, Q [, C])       t-digest with compression C
+**   approx_top_k(X, K)                  count-min sketch with K * 4 candidates
+**
+** Each one also comes as a sketch aggregate that returns its state as a BLOB,
+** a merge aggregate over such BLOBs, and a scalar that reads the result out
+** of one, so partial states can be kept in rollup tables and combined across
+** shards and time windows:
+**
+**   hll_sketch(X [, P])      hll_merge(S)      hll_count(S)
+**   tdigest_sketch(X [, C])  tdigest_merge(S)  tdigest_percentile(S, Q)
+**   topk_sketch(X, K)        topk_merge(S)     topk_values(S [, K])
+**
+** States are stored in the byte order of the host, which is little-endian
+** for wasm32, wasm64 and the native addon on x86 and ARM.
+*/
+
+/*
+** Hashing. Integers and REALs with an integral value hash alike, so that
+** 1 and 1.0 count as the same value, as they do for COUNT(DISTINCT).
+*/
+typedef struct sketch_key
+{
+	int type;
+	const unsigned char *p;
+	int n;
+	unsigned char buf[8];
+} sketch_key;
+
+static int sketch_key_from_value(sqlite3_value *pValue, sketch_key *pKey)
+{
+	pKey->type = sqlite3_value_type(pValue);
+	switch (pKey->type)
+	{
+	case SQLITE_NULL:
+		return 0;
+	case SQLITE_FLOAT:
+	{
+		double d = sqlite3_value_double(pValue);
+		if (d >= -9.2e18 && d <= 9.2e18 && d == (double)(sqlite3_int64)d)
+		{
+			sqlite3_int64 i = (sqlite3_int64)d;
+			pKey->type = SQLITE_INTEGER;
+			memcpy(pKey->buf, &i, 8);
+		}
+		else
+		{
+			memcpy(pKey->buf, &d, 8);
+		}
+		pKey->p = pKey->buf;
+		pKey->n = 8;
+		return 1;
+	}
+	case SQLITE_INTEGER:
+	{
+		sqlite3_int64 i = sqlite3_value_int64(pValue);
+		memcpy(pKey->buf, &i, 8);
+		pKey->p = pKey->buf;
+		pKey->n = 8;
+		return 1;
+	}
+	case SQLITE_TEXT:
+		pKey->p = sqlite3_value_text(pValue);
+		pKey->n = sqlite3_value_bytes(pValue);
+		return 1;
+	default:
+		pKey->p = sqlite3_value_blob(pValue);
+		pKey->n = sqlite3_value_bytes(pValue);
+		return 1;
+	}
+}
+
+/* MurmurHash64A, seeded with the datatype */
+static uint64_t sketch_hash(int type, const unsigned char *p, int n)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	uint64_t h = (0x8445d61a4e774912ULL * (uint64_t)type) ^ ((uint64_t)n * m);
+	int i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		uint64_t k;
+		memcpy(&k, p + i, 8);
+		k *= m;
+		k ^= k >> 47;
+		k *= m;
+		h ^= k;
+		h *= m;
+	}
+	if (i < n)
+	{
+		uint64_t k = 0;
+		memcpy(&k, p + i, n - i);
+		h ^= k;
+		h *= m;
+	}
+	h ^= h >> 47;
+	h *= m;
+	h ^= h >> 47;
+	return h;
+}
+
+static int sketch_int_arg(sqlite3_context *ctx, sqlite3_value *pArg, const char *zFunc, int min, int max, int *pOut)
+{
+	sqlite3_int64 i = sqlite3_value_int64(pArg);
+	if (sqlite3_value_numeric_type(pArg) != SQLITE_INTEGER || i < min || i > max)
+	{
+		char *zErr = sqlite3_mprintf("%s() expects an integer between %d and %d", zFunc, min, max);
+		sqlite3_result_error(ctx, zErr, -1);
+		sqlite3_free(zErr);
+		return 0;
+	}
+	*pOut = (int)i;
+	return 1;
+}
+
+/* whether X is NULL or a number, the input of the numeric aggregates */
+/* reports a malformed sketch BLOB as SQLITE_CORRUPT */
+static void sketch_corrupt(sqlite3_context *ctx, const char *zFunc, const char *zSketch)
+{
+	char *zErr = sqlite3_mprintf("%s() expects a sketch of %s()", zFunc, zSketch);
+	sqlite3_result_error(ctx, zErr, -1);
+	sqlite3_result_error_code(ctx, SQLITE_CORRUPT);
+	sqlite3_free(zErr);
+}
+
+static int sketch_numeric_arg(sqlite3_context *ctx, sqlite3_value *pArg, const char *zFunc, double *pOut)
+{
+	int type = sqlite3_value_numeric_type(pArg);
+	if (type == SQLITE_NULL)
+	{
+		return 0;
+	}
+	if (type != SQLITE_INTEGER && type != SQLITE_FLOAT)
+	{
+		char *zErr = sqlite3_mprintf("1st argument to %s() is not numeric", zFunc);
+		sqlite3_result_error(ctx, zErr, -1);
+		sqlite3_free(zErr);
+		return 0;
+	}
+	*pOut = sqlite3_value_double(pArg);
+	return !isnan(*pOut);
+}
+
+/*
+** HyperLogLog. The state is a 4 byte header, "HL", a version and P, and then
+** one byte per register. The default P of 12 takes 4 KiB and has a standard
+** error of 1.6%, every step of P halves the size or doubles it.
+*/
+#define HLL_MIN_P 4
+#define HLL_MAX_P 18
+#define HLL_DEFAULT_P 12
+#define HLL_HEADER 4
+
+typedef struct hll
+{
+	unsigned char *a;
+	int p;
+} hll;
+
+static int hll_size(int p)
+{
+	return HLL_HEADER + (1 << p);
+}
+
+static int hll_alloc(sqlite3_context *ctx, hll *pHll, int p)
+{
+	pHll->a = sqlite3_malloc(hll_size(p));
+	if (pHll->a == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return 0;
+	}
+	memset(pHll->a, 0, hll_size(p));
+	memcpy(pHll->a, "HL\1", 3);
+	pHll->a[3] = (unsigned char)p;
+	pHll->p = p;
+	return 1;
+}
+
+static void hll_add(hll *pHll, uint64_t h)
+{
+	uint64_t index = h >> (64 - pHll->p);
+	/* the marker bit bounds the rank when the remaining bits are all zero */
+	uint64_t rest = (h << pHll->p) | (1ULL << (pHll->p - 1));
+	unsigned char rank = (unsigned char)(__builtin_clzll(rest) + 1);
+	unsigned char *registers = pHll->a + HLL_HEADER;
+	if (registers[index] < rank)
+	{
+		registers[index] = rank;
+	}
+}
+
+static sqlite3_int64 hll_estimate(const unsigned char *a)
+{
+	int p = a[3];
+	int m = 1 << p;
+	const unsigned char *registers = a + HLL_HEADER;
+	double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+	double sum = 0;
+	int zeros = 0;
+	for (int i = 0; i < m; i++)
+	{
+		sum += ldexp(1.0, -registers[i]);
+		zeros += registers[i] == 0;
+	}
+	double estimate = alpha * m * m / sum;
+	/* linear counting is more accurate while many registers are empty */
+	if (estimate <= 2.5 * m && zeros > 0)
+	{
+		estimate = m * log((double)m / zeros);
+	}
+	return (sqlite3_int64)(estimate + 0.5);
+}
+
+static const unsigned char *hll_from_value(sqlite3_context *ctx, sqlite3_value *pValue, const char *zFunc)
+{
+	const unsigned char *a = sqlite3_value_blob(pValue);
+	int n = sqlite3_value_bytes(pValue);
+	if (n < HLL_HEADER || memcmp(a, "HL\1", 3) != 0 || a[3] < HLL_MIN_P || a[3] > HLL_MAX_P || n != hll_size(a[3]))
+	{
+		sketch_corrupt(ctx, zFunc, "hll_sketch");
+		return NULL;
+	}
+	return a;
+}
+
+static void hll_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	hll *pHll = sqlite3_aggregate_context(ctx, sizeof(hll));
+	sketch_key key;
+	if (pHll == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (pHll->a == NULL)
+	{
+		int p = HLL_DEFAULT_P;
+		if (argc > 1 && !sketch_int_arg(ctx, argv[1], "approx_count_distinct", HLL_MIN_P, HLL_MAX_P, &p))
+		{
+			return;
+		}
+		if (!hll_alloc(ctx, pHll, p))
+		{
+			return;
+		}
+	}
+	if (sketch_key_from_value(argv[0], &key))
+	{
+		hll_add(pHll, sketch_hash(key.type, key.p, key.n));
+	}
+}
+
+static void hll_merge_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	hll *pHll = sqlite3_aggregate_context(ctx, sizeof(hll));
+	(void)argc;
+	if (pHll == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+	{
+		return;
+	}
+	const unsigned char *a = hll_from_value(ctx, argv[0], "hll_merge");
+	if (a == NULL)
+	{
+		return;
+	}
+	if (pHll->a == NULL && !hll_alloc(ctx, pHll, a[3]))
+	{
+		return;
+	}
+	if (a[3] != pHll->p)
+	{
+		sqlite3_result_error(ctx, "hll_merge() of sketches with different precisions", -1);
+		return;
+	}
+	unsigned char *registers = pHll->a + HLL_HEADER;
+	for (int i = 0; i < (1 << pHll->p); i++)
+	{
+		if (registers[i] < a[HLL_HEADER + i])
+		{
+			registers[i] = a[HLL_HEADER + i];
+		}
+	}
+}
+
+static void hll_count_final(sqlite3_context *ctx)
+{
+	hll *pHll = sqlite3_aggregate_context(ctx, 0);
+	if (pHll == NULL || pHll->a == NULL)
+	{
+		sqlite3_result_int(ctx, 0);
+		return;
+	}
+	sqlite3_result_int64(ctx, hll_estimate(pHll->a));
+	sqlite3_free(pHll->a);
+}
+
+static void hll_sketch_final(sqlite3_context *ctx)
+{
+	hll *pHll = sqlite3_aggregate_context(ctx, 0);
+	if (pHll == NULL || pHll->a == NULL)
+	{
+		sqlite3_result_null(ctx);
+		return;
+	}
+	sqlite3_result_blob(ctx, pHll->a, hll_size(pHll->p), sqlite3_free);
+}
+
+static void hll_count(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	(void)argc;
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+	{
+		return;
+	}
+	const unsigned char *a = hll_from_value(ctx, argv[0], "hll_count");
+	if (a != NULL)
+	{
+		sqlite3_result_int64(ctx, hll_estimate(a));
+	}
+}
+
+/*
+** t-digest, the merging variant with the k1 scale function. Centroids are
+** kept sorted up to nMerged, values and merged centroids are appended after
+** them until the array is full and compressed again. The state is a header,
+** "TD", a version and a pad byte, the compression, minimum and maximum as
+** doubles and the centroid count as an int, followed by mean and weight
+** pairs. The default compression of 100 keeps at most about 100 centroids.
+*/
+#define TDIGEST_DEFAULT_COMPRESSION 100
+#define TDIGEST_HEADER 32
+#define TDIGEST_PI 3.14159265358979323846
+
+typedef struct centroid
+{
+	double mean;
+	double weight;
+} centroid;
+
+typedef struct tdigest
+{
+	centroid *a;
+	int n;
+	int nMerged;
+	int nAlloc;
+	double compression;
+	double total;
+	double min;
+	double max;
+	/* quantile of approx_percentile(), constant across the group */
+	double q;
+} tdigest;
+
+static int tdigest_init(sqlite3_context *ctx, tdigest *pDigest, double compression)
+{
+	pDigest->compression = compression;
+	pDigest->nAlloc = (int)(compression * 6) + 10;
+	pDigest->a = sqlite3_malloc64(sizeof(centroid) * pDigest->nAlloc);
+	if (pDigest->a == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return 0;
+	}
+	pDigest->min = INFINITY;
+	pDigest->max = -INFINITY;
+	return 1;
+}
+
+static int centroid_cmp(const void *pA, const void *pB)
+{
+	double a = ((const centroid *)pA)->mean;
+	double b = ((const centroid *)pB)->mean;
+	return a < b ? -1 : a > b ? 1 : 0;
+}
+
+static double tdigest_k(const tdigest *pDigest, double q)
+{
+	return pDigest->compression / (2 * TDIGEST_PI) * asin(2 * q - 1);
+}
+
+static void tdigest_compress(tdigest *pDigest)
+{
+	if (pDigest->n == pDigest->nMerged || pDigest->n == 0)
+	{
+		return;
+	}
+	qsort(pDigest->a, pDigest->n, sizeof(centroid), centroid_cmp);
+	centroid current = pDigest->a[0];
+	double before = 0;
+	int out = 0;
+	for (int i = 1; i < pDigest->n; i++)
+	{
+		centroid next = pDigest->a[i];
+		double weight = current.weight + next.weight;
+		if (tdigest_k(pDigest, (before + weight) / pDigest->total) - tdigest_k(pDigest, before / pDigest->total) <= 1)
+		{
+			current.mean += (next.mean - current.mean) * next.weight / weight;
+			current.weight = weight;
+		}
+		else
+		{
+			pDigest->a[out++] = current;
+			before += current.weight;
+			current = next;
+		}
+	}
+	pDigest->a[out++] = current;
+	pDigest->n = pDigest->nMerged = out;
+}
+
+/* 0 on NOMEM */
+static int tdigest_add(tdigest *pDigest, double mean, double weight)
+{
+	if (pDigest->n == pDigest->nAlloc)
+	{
+		tdigest_compress(pDigest);
+	}
+	/* compression frees no slot when nothing merges, so grow instead */
+	if (pDigest->n == pDigest->nAlloc)
+	{
+		centroid *a = sqlite3_realloc64(pDigest->a, sizeof(centroid) * pDigest->nAlloc * 2);
+		if (a == NULL)
+		{
+			return 0;
+		}
+		pDigest->a = a;
+		pDigest->nAlloc *= 2;
+	}
+	pDigest->a[pDigest->n].mean = mean;
+	pDigest->a[pDigest->n].weight = weight;
+	pDigest->n++;
+	pDigest->total += weight;
+	return 1;
+}
+
+static double tdigest_quantile(tdigest *pDigest, double q)
+{
+	tdigest_compress(pDigest);
+	const centroid *a = pDigest->a;
+	int n = pDigest->n;
+	double target = q * pDigest->total;
+	if (n == 1)
+	{
+		return a[0].mean;
+	}
+	/* between the minimum and the center of the first centroid */
+	if (target < a[0].weight / 2)
+	{
+		return pDigest->min + (a[0].mean - pDigest->min) * target / (a[0].weight / 2);
+	}
+	double at = a[0].weight / 2;
+	for (int i = 0; i + 1 < n; i++)
+	{
+		double step = (a[i].weight + a[i + 1].weight) / 2;
+		if (at + step >= target)
+		{
+			return a[i].mean + (a[i + 1].mean - a[i].mean) * (target - at) / step;
+		}
+		at += step;
+	}
+	double half = a[n - 1].weight / 2;
+	double right = target - at < half ? target - at : half;
+	return a[n - 1].mean + (pDigest->max - a[n - 1].mean) * right / half;
+}
+
+static int tdigest_compression_arg(sqlite3_context *ctx, int argc, sqlite3_value **argv, int i, const char *zFunc, double *pOut)
+{
+	int compression = TDIGEST_DEFAULT_COMPRESSION;
+	if (argc > i && !sketch_int_arg(ctx, argv[i], zFunc, 10, 10000, &compression))
+	{
+		return 0;
+	}
+	*pOut = compression;
+	return 1;
+}
+
+static int tdigest_quantile_arg(sqlite3_context *ctx, sqlite3_value *pArg, const char *zFunc, double *pOut)
+{
+	int type = sqlite3_value_numeric_type(pArg);
+	double q = sqlite3_value_double(pArg);
+	if ((type != SQLITE_INTEGER && type != SQLITE_FLOAT) || !(q >= 0.0 && q <= 1.0))
+	{
+		char *zErr = sqlite3_mprintf("%s() expects a quantile between 0.0 and 1.0", zFunc);
+		sqlite3_result_error(ctx, zErr, -1);
+		sqlite3_free(zErr);
+		return 0;
+	}
+	*pOut = q;
+	return 1;
+}
+
+static void tdigest_value_step(sqlite3_context *ctx, tdigest *pDigest, sqlite3_value *pValue, const char *zFunc)
+{
+	double value;
+	if (sketch_numeric_arg(ctx, pValue, zFunc, &value))
+	{
+		if (!tdigest_add(pDigest, value, 1))
+		{
+			sqlite3_result_error_nomem(ctx);
+			return;
+		}
+		pDigest->min = value < pDigest->min ? value : pDigest->min;
+		pDigest->max = value > pDigest->max ? value : pDigest->max;
+	}
+}
+
+static void approx_percentile_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	tdigest *pDigest = sqlite3_aggregate_context(ctx, sizeof(tdigest));
+	if (pDigest == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (pDigest->a == NULL)
+	{
+		double compression;
+		if (!tdigest_quantile_arg(ctx, argv[1], "approx_percentile", &pDigest->q)
+			|| !tdigest_compression_arg(ctx, argc, argv, 2, "approx_percentile", &compression)
+			|| !tdigest_init(ctx, pDigest, compression))
+		{
+			return;
+		}
+	}
+	tdigest_value_step(ctx, pDigest, argv[0], "approx_percentile");
+}
+
+static void tdigest_sketch_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	tdigest *pDigest = sqlite3_aggregate_context(ctx, sizeof(tdigest));
+	if (pDigest == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (pDigest->a == NULL)
+	{
+		double compression;
+		if (!tdigest_compression_arg(ctx, argc, argv, 1, "tdigest_sketch", &compression)
+			|| !tdigest_init(ctx, pDigest, compression))
+		{
+			return;
+		}
+	}
+	tdigest_value_step(ctx, pDigest, argv[0], "tdigest_sketch");
+}
+
+/* reads the header of a serialized digest, the centroids follow it */
+static int tdigest_from_value(sqlite3_context *ctx, sqlite3_value *pValue, const char *zFunc, tdigest *pHeader, const unsigned char **paCentroid)
+{
+	const unsigned char *a = sqlite3_value_blob(pValue);
+	int n = sqlite3_value_bytes(pValue);
+	int count = -1;
+	if (n >= TDIGEST_HEADER && memcmp(a, "TD\1", 3) == 0)
+	{
+		memcpy(&pHeader->compression, a + 4, 8);
+		memcpy(&pHeader->min, a + 12, 8);
+		memcpy(&pHeader->max, a + 20, 8);
+		memcpy(&count, a + 28, 4);
+	}
+	/* bounds count before the multiplication, which a forged count would overflow */
+	if (count < 0 || count > (n - TDIGEST_HEADER) / (int)sizeof(centroid) || n != TDIGEST_HEADER + count * (int)sizeof(centroid)
+		|| !(pHeader->compression >= 10 && pHeader->compression <= 10000))
+	{
+		sketch_corrupt(ctx, zFunc, "tdigest_sketch");
+		return -1;
+	}
+	/* compression and quantiles assume finite means and positive weights */
+	for (int i = 0; i < count; i++)
+	{
+		centroid c;
+		memcpy(&c, a + TDIGEST_HEADER + i * sizeof(centroid), sizeof(centroid));
+		if (!isfinite(c.mean) || !isfinite(c.weight) || !(c.weight > 0))
+		{
+			sketch_corrupt(ctx, zFunc, "tdigest_sketch");
+			return -1;
+		}
+	}
+	*paCentroid = a + TDIGEST_HEADER;
+	return count;
+}
+
+static void tdigest_merge_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	tdigest *pDigest = sqlite3_aggregate_context(ctx, sizeof(tdigest));
+	tdigest header;
+	const unsigned char *aCentroid;
+	(void)argc;
+	if (pDigest == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+	{
+		return;
+	}
+	int count = tdigest_from_value(ctx, argv[0], "tdigest_merge", &header, &aCentroid);
+	if (count < 0)
+	{
+		return;
+	}
+	/* the first sketch decides the compression of the merge */
+	if (pDigest->a == NULL && !tdigest_init(ctx, pDigest, header.compression))
+	{
+		return;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		centroid c;
+		memcpy(&c, aCentroid + i * sizeof(centroid), sizeof(centroid));
+		if (!tdigest_add(pDigest, c.mean, c.weight))
+		{
+			sqlite3_result_error_nomem(ctx);
+			return;
+		}
+	}
+	pDigest->min = header.min < pDigest->min ? header.min : pDigest->min;
+	pDigest->max = header.max > pDigest->max ? header.max : pDigest->max;
+}
+
+static void approx_percentile_final(sqlite3_context *ctx)
+{
+	tdigest *pDigest = sqlite3_aggregate_context(ctx, 0);
+	if (pDigest == NULL || pDigest->a == NULL)
+	{
+		return;
+	}
+	if (pDigest->n > 0)
+	{
+		sqlite3_result_double(ctx, tdigest_quantile(pDigest, pDigest->q));
+	}
+	sqlite3_free(pDigest->a);
+}
+
+static void tdigest_sketch_final(sqlite3_context *ctx)
+{
+	tdigest *pDigest = sqlite3_aggregate_context(ctx, 0);
+	if (pDigest == NULL || pDigest->a == NULL)
+	{
+		return;
+	}
+	tdigest_compress(pDigest);
+	int n = TDIGEST_HEADER + pDigest->n * (int)sizeof(centroid);
+	unsigned char *a = sqlite3_malloc(n);
+	if (a == NULL)
+	{
+		sqlite3_free(pDigest->a);
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	memset(a, 0, TDIGEST_HEADER);
+	memcpy(a, "TD\1", 3);
+	memcpy(a + 4, &pDigest->compression, 8);
+	memcpy(a + 12, &pDigest->min, 8);
+	memcpy(a + 20, &pDigest->max, 8);
+	memcpy(a + 28, &pDigest->n, 4);
+	memcpy(a + TDIGEST_HEADER, pDigest->a, pDigest->n * sizeof(centroid));
+	sqlite3_free(pDigest->a);
+	sqlite3_result_blob(ctx, a, n, sqlite3_free);
+}
+
+static void tdigest_percentile(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	tdigest digest;
+	const unsigned char *aCentroid;
+	double q;
+	(void)argc;
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL || !tdigest_quantile_arg(ctx, argv[1], "tdigest_percentile", &q))
+	{
+		return;
+	}
+	int count = tdigest_from_value(ctx, argv[0], "tdigest_percentile", &digest, &aCentroid);
+	if (count <= 0)
+	{
+		return;
+	}
+	digest.a = sqlite3_malloc64(sizeof(centroid) * count);
+	if (digest.a == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	memcpy(digest.a, aCentroid, sizeof(centroid) * count);
+	digest.n = digest.nMerged = count;
+	digest.total = 0;
+	for (int i = 0; i < count; i++)
+	{
+		digest.total += digest.a[i].weight;
+	}
+	sqlite3_result_double(ctx, tdigest_quantile(&digest, q));
+	sqlite3_free(digest.a);
+}
+
+/*
+** Top K with a count-min sketch of TOPK_DEPTH rows of TOPK_WIDTH counters,
+** which overestimates counts by at most e / TOPK_WIDTH of the total with
+** high probability, and the K * 4 values with the highest estimates as
+** candidates. The state is a header, "TK", a version and a pad byte, K and
+** the candidate count as ints, four pad bytes and the total as a 64-bit int,
+** so merged sketches can count past 2^31 rows, the counters, and then for
+** each candidate its datatype and size as ints followed by its bytes.
+*/
+#define TOPK_DEPTH 4
+#define TOPK_WIDTH 512
+#define TOPK_MAX_K 1000
+#define TOPK_HEADER 24
+
+typedef struct topk_candidate
+{
+	uint64_t hash;
+	sqlite3_int64 count;
+	int type;
+	int n;
+	unsigned char *p;
+} topk_candidate;
+
+typedef struct topk
+{
+	sqlite3_uint64 *counters;
+	topk_candidate *a;
+	int k;
+	int n;
+	sqlite3_int64 total;
+} topk;
+
+static int topk_capacity(int k)
+{
+	return k * 4 < 16 ? 16 : k * 4;
+}
+
+static int topk_init(sqlite3_context *ctx, topk *pTopk, int k)
+{
+	pTopk->k = k;
+	pTopk->counters = sqlite3_malloc64(sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH);
+	pTopk->a = sqlite3_malloc64(sizeof(topk_candidate) * topk_capacity(k));
+	if (pTopk->counters == NULL || pTopk->a == NULL)
+	{
+		sqlite3_free(pTopk->counters);
+		sqlite3_free(pTopk->a);
+		pTopk->counters = NULL;
+		pTopk->a = NULL;
+		sqlite3_result_error_nomem(ctx);
+		return 0;
+	}
+	memset(pTopk->counters, 0, sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH);
+	return 1;
+}
+
+static void topk_free(topk *pTopk)
+{
+	for (int i = 0; i < pTopk->n; i++)
+	{
+		sqlite3_free(pTopk->a[i].p);
+	}
+	sqlite3_free(pTopk->a);
+	sqlite3_free(pTopk->counters);
+	pTopk->a = NULL;
+	pTopk->counters = NULL;
+}
+
+/* the counter of value h in row i, double hashing from the two halves of h */
+static sqlite3_uint64 *topk_counter(topk *pTopk, uint64_t h, int i)
+{
+	uint32_t h1 = (uint32_t)h;
+	uint32_t h2 = (uint32_t)(h >> 32) | 1;
+	return &pTopk->counters[i * TOPK_WIDTH + (h1 + (uint32_t)i * h2) % TOPK_WIDTH];
+}
+
+static sqlite3_int64 topk_estimate(topk *pTopk, uint64_t h)
+{
+	sqlite3_uint64 min = *topk_counter(pTopk, h, 0);
+	for (int i = 1; i < TOPK_DEPTH; i++)
+	{
+		sqlite3_uint64 c = *topk_counter(pTopk, h, i);
+		min = c < min ? c : min;
+	}
+	return (sqlite3_int64)min;
+}
+
+/* offers a value with its current estimate to the candidates, 0 on NOMEM */
+static int topk_offer(topk *pTopk, int type, const unsigned char *p, int n, uint64_t h, sqlite3_int64 count)
+{
+	int capacity = topk_capacity(pTopk->k);
+	int min = -1;
+	for (int i = 0; i < pTopk->n; i++)
+	{
+		topk_candidate *c = &pTopk->a[i];
+		if (c->hash == h && c->type == type && c->n == n && memcmp(c->p, p, n) == 0)
+		{
+			c->count = count;
+			return 1;
+		}
+		if (min < 0 || c->count < pTopk->a[min].count)
+		{
+			min = i;
+		}
+	}
+	topk_candidate *c;
+	if (pTopk->n < capacity)
+	{
+		c = &pTopk->a[pTopk->n++];
+	}
+	else if (count > pTopk->a[min].count)
+	{
+		c = &pTopk->a[min];
+		sqlite3_free(c->p);
+	}
+	else
+	{
+		return 1;
+	}
+	c->p = sqlite3_malloc(n > 0 ? n : 1);
+	if (c->p == NULL)
+	{
+		*c = pTopk->a[--pTopk->n];
+		return 0;
+	}
+	memcpy(c->p, p, n);
+	c->hash = h;
+	c->count = count;
+	c->type = type;
+	c->n = n;
+	return 1;
+}
+
+static void topk_value_step(sqlite3_context *ctx, int argc, sqlite3_value **argv, const char *zFunc)
+{
+	topk *pTopk = sqlite3_aggregate_context(ctx, sizeof(topk));
+	sketch_key key;
+	(void)argc;
+	if (pTopk == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (pTopk->a == NULL)
+	{
+		int k;
+		if (!sketch_int_arg(ctx, argv[1], zFunc, 1, TOPK_MAX_K, &k) || !topk_init(ctx, pTopk, k))
+		{
+			return;
+		}
+	}
+	if (!sketch_key_from_value(argv[0], &key))
+	{
+		return;
+	}
+	uint64_t h = sketch_hash(key.type, key.p, key.n);
+	for (int i = 0; i < TOPK_DEPTH; i++)
+	{
+		(*topk_counter(pTopk, h, i))++;
+	}
+	pTopk->total++;
+	if (!topk_offer(pTopk, key.type, key.p, key.n, h, topk_estimate(pTopk, h)))
+	{
+		sqlite3_result_error_nomem(ctx);
+	}
+}
+
+static void approx_top_k_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	topk_value_step(ctx, argc, argv, "approx_top_k");
+}
+
+static void topk_sketch_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	topk_value_step(ctx, argc, argv, "topk_sketch");
+}
+
+/* parses a serialized sketch into pTopk, which must not be initialized yet */
+static int topk_from_value(sqlite3_context *ctx, sqlite3_value *pValue, const char *zFunc, topk *pTopk)
+{
+	const unsigned char *a = sqlite3_value_blob(pValue);
+	int n = sqlite3_value_bytes(pValue);
+	int k = 0, count = 0;
+	int offset = TOPK_HEADER + (int)sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH;
+	sqlite3_int64 total = -1;
+	if (n >= offset && memcmp(a, "TK\2", 3) == 0)
+	{
+		memcpy(&k, a + 4, 4);
+		memcpy(&count, a + 8, 4);
+		memcpy(&total, a + 16, 8);
+	}
+	if (k < 1 || k > TOPK_MAX_K || count < 0 || count > topk_capacity(k) || total < 0)
+	{
+		goto corrupt;
+	}
+	if (!topk_init(ctx, pTopk, k))
+	{
+		return 0;
+	}
+	pTopk->total = total;
+	memcpy(pTopk->counters, a + TOPK_HEADER, sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH);
+	for (int i = 0; i < count; i++)
+	{
+		int type, size;
+		if (offset + 8 > n)
+		{
+			goto corrupt;
+		}
+		memcpy(&type, a + offset, 4);
+		memcpy(&size, a + offset + 4, 4);
+		offset += 8;
+		if (size < 0 || size > n - offset || type < SQLITE_INTEGER || type > SQLITE_BLOB
+			|| ((type == SQLITE_INTEGER || type == SQLITE_FLOAT) && size != 8))
+		{
+			goto corrupt;
+		}
+		uint64_t h = sketch_hash(type, a + offset, size);
+		if (!topk_offer(pTopk, type, a + offset, size, h, topk_estimate(pTopk, h)))
+		{
+			sqlite3_result_error_nomem(ctx);
+			return 0;
+		}
+		offset += size;
+	}
+	if (offset != n)
+	{
+		goto corrupt;
+	}
+	return 1;
+
+corrupt:
+	topk_free(pTopk);
+	sketch_corrupt(ctx, zFunc, "topk_sketch");
+	return 0;
+}
+
+static void topk_merge_step(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	topk *pTopk = sqlite3_aggregate_context(ctx, sizeof(topk));
+	topk other = { 0 };
+	(void)argc;
+	if (pTopk == NULL)
+	{
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL || !topk_from_value(ctx, argv[0], "topk_merge", &other))
+	{
+		return;
+	}
+	if (pTopk->a == NULL)
+	{
+		*pTopk = other;
+		return;
+	}
+	/* the larger K keeps more candidates */
+	if (other.k > pTopk->k)
+	{
+		topk_candidate *a = sqlite3_realloc64(pTopk->a, sizeof(topk_candidate) * topk_capacity(other.k));
+		if (a == NULL)
+		{
+			topk_free(&other);
+			sqlite3_result_error_nomem(ctx);
+			return;
+		}
+		pTopk->a = a;
+		pTopk->k = other.k;
+	}
+	for (int i = 0; i < TOPK_DEPTH * TOPK_WIDTH; i++)
+	{
+		pTopk->counters[i] += other.counters[i];
+	}
+	pTopk->total += other.total;
+	for (int i = 0; i < pTopk->n; i++)
+	{
+		pTopk->a[i].count = topk_estimate(pTopk, pTopk->a[i].hash);
+	}
+	for (int i = 0; i < other.n; i++)
+	{
+		topk_candidate *c = &other.a[i];
+		if (!topk_offer(pTopk, c->type, c->p, c->n, c->hash, topk_estimate(pTopk, c->hash)))
+		{
+			sqlite3_result_error_nomem(ctx);
+			break;
+		}
+	}
+	topk_free(&other);
+}
+
+static int topk_candidate_cmp(const void *pA, const void *pB)
+{
+	sqlite3_int64 a = ((const topk_candidate *)pA)->count;
+	sqlite3_int64 b = ((const topk_candidate *)pB)->count;
+	return a > b ? -1 : a < b ? 1 : 0;
+}
+
+/* [{"value": ..., "count": ...}, ...] of the k most frequent candidates, BLOBs as hex text */
+static void topk_result_json(sqlite3_context *ctx, topk *pTopk, int k)
+{
+	sqlite3_str *pOut = sqlite3_str_new(sqlite3_context_db_handle(ctx));
+	qsort(pTopk->a, pTopk->n, sizeof(topk_candidate), topk_candidate_cmp);
+	sqlite3_str_appendchar(pOut, 1, '[');
+	for (int i = 0; i < pTopk->n && i < k; i++)
+	{
+		topk_candidate *c = &pTopk->a[i];
+		sqlite3_str_appendall(pOut, i == 0 ? "{\"value\":" : ",{\"value\":");
+		if (c->type == SQLITE_INTEGER)
+		{
+			sqlite3_int64 v;
+			memcpy(&v, c->p, 8);
+			sqlite3_str_appendf(pOut, "%lld", v);
+		}
+		else if (c->type == SQLITE_FLOAT)
+		{
+			double v;
+			memcpy(&v, c->p, 8);
+			sqlite3_str_appendf(pOut, isfinite(v) ? "%!.17g" : "null", v);
+		}
+		else if (c->type == SQLITE_TEXT)
+		{
+			ext_json_append_string(pOut, c->p, c->n);
+		}
+		else
+		{
+			sqlite3_str_appendchar(pOut, 1, '"');
+			for (int j = 0; j < c->n; j++)
+			{
+				sqlite3_str_appendf(pOut, "%02x", c->p[j]);
+			}
+			sqlite3_str_appendchar(pOut, 1, '"');
+		}
+		sqlite3_str_appendf(pOut, ",\"count\":%lld}", c->count);
+	}
+	sqlite3_str_appendchar(pOut, 1, ']');
+	int rc = sqlite3_str_errcode(pOut);
+	int n = sqlite3_str_length(pOut);
+	char *z = sqlite3_str_finish(pOut);
+	if (rc != SQLITE_OK)
+	{
+		sqlite3_free(z);
+		sqlite3_result_error_code(ctx, rc);
+		return;
+	}
+	sqlite3_result_text(ctx, z, n, sqlite3_free);
+	sqlite3_result_subtype(ctx, 'J');
+}
+
+static void approx_top_k_final(sqlite3_context *ctx)
+{
+	topk *pTopk = sqlite3_aggregate_context(ctx, 0);
+	if (pTopk == NULL || pTopk->a == NULL)
+	{
+		sqlite3_result_text(ctx, "[]", 2, SQLITE_STATIC);
+		return;
+	}
+	topk_result_json(ctx, pTopk, pTopk->k);
+	topk_free(pTopk);
+}
+
+static void topk_sketch_final(sqlite3_context *ctx)
+{
+	topk *pTopk = sqlite3_aggregate_context(ctx, 0);
+	if (pTopk == NULL || pTopk->a == NULL)
+	{
+		return;
+	}
+	sqlite3_int64 n = TOPK_HEADER + sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH;
+	for (int i = 0; i < pTopk->n; i++)
+	{
+		n += 8 + pTopk->a[i].n;
+	}
+	unsigned char *a = sqlite3_malloc64(n);
+	if (a == NULL)
+	{
+		topk_free(pTopk);
+		sqlite3_result_error_nomem(ctx);
+		return;
+	}
+	memset(a, 0, TOPK_HEADER);
+	memcpy(a, "TK\2", 3);
+	memcpy(a + 4, &pTopk->k, 4);
+	memcpy(a + 8, &pTopk->n, 4);
+	memcpy(a + 16, &pTopk->total, 8);
+	memcpy(a + TOPK_HEADER, pTopk->counters, sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH);
+	sqlite3_int64 offset = TOPK_HEADER + sizeof(sqlite3_uint64) * TOPK_DEPTH * TOPK_WIDTH;
+	for (int i = 0; i < pTopk->n; i++)
+	{
+		topk_candidate *c = &pTopk->a[i];
+		memcpy(a + offset, &c->type, 4);
+		memcpy(a + offset + 4, &c->n, 4);
+		memcpy(a + offset + 8, c->p, c->n);
+		offset += 8 + c->n;
+	}
+	topk_free(pTopk);
+	sqlite3_result_blob64(ctx, a, n, sqlite3_free);
+}
+
+static void topk_values(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	topk sketch = { 0 };
+	int k = 0;
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL)
+	{
+		return;
+	}
+	if (argc > 1 && !sketch_int_arg(ctx, argv[1], "topk_values", 1, TOPK_MAX_K, &k))
+	{
+		return;
+	}
+	if (!topk_from_value(ctx, argv[0], "topk_values", &sketch))
+	{
+		return;
+	}
+	topk_result_json(ctx, &sketch, k > 0 ? k : sketch.k);
+	topk_free(&sketch);
+}
+
+int sqlite3_sketch_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi)
+{
+	static const struct
+	{
+		const char *zName;
+		int nArg;
+		void (*xFunc)(sqlite3_context *, int, sqlite3_value **);
+		void (*xStep)(sqlite3_context *, int, sqlite3_value **);
+		void (*xFinal)(sqlite3_context *);
+	} functions[] = {
+		{ "approx_count_distinct", 1, NULL, hll_step, hll_count_final },
+		{ "approx_count_distinct", 2, NULL, hll_step, hll_count_final },
+		{ "hll_sketch", 1, NULL, hll_step, hll_sketch_final },
+		{ "hll_sketch", 2, NULL, hll_step, hll_sketch_final },
+		{ "hll_merge", 1, NULL, hll_merge_step, hll_sketch_final },
+		{ "hll_count", 1, hll_count, NULL, NULL },
+		{ "approx_percentile", 2, NULL, approx_percentile_step, approx_percentile_final },
+		{ "approx_percentile", 3, NULL, approx_percentile_step, approx_percentile_final },
+		{ "tdigest_sketch", 1, NULL, tdigest_sketch_step, tdigest_sketch_final },
+		{ "tdigest_sketch", 2, NULL, tdigest_sketch_step, tdigest_sketch_final },
+		{ "tdigest_merge", 1, NULL, tdigest_merge_step, tdigest_sketch_final },
+		{ "tdigest_percentile", 2, tdigest_percentile, NULL, NULL },
+		{ "approx_top_k", 2, NULL, approx_top_k_step, approx_top_k_final },
+		{ "topk_sketch", 2, NULL, topk_sketch_step, topk_sketch_final },
+		{ "topk_merge", 1, NULL, topk_merge_step, topk_sketch_final },
+		{ "topk_values", 1, topk_values, NULL, NULL },
+		{ "topk_values", 2, topk_values, NULL, NULL },
+	};
+	(void)pzErrMsg;
+	(void)pApi;
+	for (size_t i = 0; i < sizeof(functions) / sizeof(functions[0]); i++)
+	{
+		int rc = sqlite3_create_function(db, functions[i].zName, functions[i].nArg,
+			SQLITE_UTF8 | SQLITE_INNOCUOUS | (functions[i].xFunc != NULL ? SQLITE_DETERMINISTIC : 0), NULL,
+			functions[i].xFunc, functions[i].xStep, functions[i].xFinal);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+	return SQLITE_OK;
+}
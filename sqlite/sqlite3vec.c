@@ -0,0 +1,1598 @@
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#include "sqlite3wasm.h"
+
+/*
+** Vector search over float32 vectors stored as BLOBs, such as the bytes of a
+** Float32Array bound with SQLiteStatement.bindFloat32Array. Linked into the
+** full flavor and registered for every connection by sqlite3_ext_init.
+**
+**   vec_dot(A, B)        inner product
+**   vec_cosine(A, B)     cosine similarity
+**   vec_l2(A, B)         Euclidean distance
+**
+**   SELECT id, distance FROM vec_topk('docs', 'embedding', :query, 10, 'cosine')
+**
+** scans a column and keeps the K nearest rows in a heap, and
+**
+**   CREATE VIRTUAL TABLE items USING vec_ivf(dimensions=384, lists=100, metric=cosine);
+**   INSERT INTO items(rowid, vector) VALUES (...);
+**   INSERT INTO items(items) VALUES ('train');
+**   SELECT rowid, distance FROM items WHERE vector MATCH :query AND k = 10 AND probes = 8;
+**
+** is an inverted file index, vectors are clustered around centroids found by
+** k-means and a query only scans the lists of the nearest centroids. Distances
+** are ascending for every metric, the cosine distance is 1 - similarity and
+** the dot distance the negated inner product.
+*/
+
+#define VEC_L2 0
+#define VEC_COSINE 1
+#define VEC_DOT 2
+
+#define VEC_MAX_K 100000
+
+static int vec_metric_parse(const char *z)
+{
+	if (z == NULL || sqlite3_stricmp(z, "l2") == 0)
+	{
+		return VEC_L2;
+	}
+	if (sqlite3_stricmp(z, "cosine") == 0)
+	{
+		return VEC_COSINE;
+	}
+	if (sqlite3_stricmp(z, "dot") == 0)
+	{
+		return VEC_DOT;
+	}
+	return -1;
+}
+
+/*
+** Kernels over n float32s. BLOBs of values and rows are not always 4 byte
+** aligned, so the scalar loads go through memcpy and the SIMD loads are
+** unaligned v128.load. vec_sums is inlined into one loop per metric, sums[0]
+** is the squared distance for VEC_L2 and the inner product otherwise, and
+** sums[1] and sums[2] the squared norms for VEC_COSINE.
+*/
+static float vec_load(const unsigned char *p)
+{
+	float f;
+	memcpy(&f, p, 4);
+	return f;
+}
+
+#ifdef __wasm_simd128__
+static float vec_sum_lanes(v128_t v)
+{
+	return wasm_f32x4_extract_lane(v, 0) + wasm_f32x4_extract_lane(v, 1)
+		+ wasm_f32x4_extract_lane(v, 2) + wasm_f32x4_extract_lane(v, 3);
+}
+#endif
+
+static inline __attribute__((always_inline)) void vec_sums(const unsigned char *a, const unsigned char *b, int n, int metric, float sums[3])
+{
+	int i = 0;
+	sums[0] = sums[1] = sums[2] = 0;
+#ifdef __wasm_simd128__
+	v128_t s0 = wasm_f32x4_splat(0), s1 = s0, s2 = s0;
+	for (; i + 4 <= n; i += 4)
+	{
+		v128_t x = wasm_v128_load(a + i * 4);
+		v128_t y = wasm_v128_load(b + i * 4);
+		if (metric == VEC_L2)
+		{
+			v128_t d = wasm_f32x4_sub(x, y);
+			s0 = wasm_f32x4_add(s0, wasm_f32x4_mul(d, d));
+			continue;
+		}
+		s0 = wasm_f32x4_add(s0, wasm_f32x4_mul(x, y));
+		if (metric == VEC_COSINE)
+		{
+			s1 = wasm_f32x4_add(s1, wasm_f32x4_mul(x, x));
+			s2 = wasm_f32x4_add(s2, wasm_f32x4_mul(y, y));
+		}
+	}
+	sums[0] = vec_sum_lanes(s0);
+	sums[1] = vec_sum_lanes(s1);
+	sums[2] = vec_sum_lanes(s2);
+#endif
+	for (; i < n; i++)
+	{
+		float x = vec_load(a + i * 4);
+		float y = vec_load(b + i * 4);
+		if (metric == VEC_L2)
+		{
+			sums[0] += (x - y) * (x - y);
+			continue;
+		}
+		sums[0] += x * y;
+		if (metric == VEC_COSINE)
+		{
+			sums[1] += x * x;
+			sums[2] += y * y;
+		}
+	}
+}
+
+static double vec_l2(const unsigned char *a, const unsigned char *b, int n)
+{
+	float sums[3];
+	vec_sums(a, b, n, VEC_L2, sums);
+	return sqrt(sums[0]);
+}
+
+static double vec_dot(const unsigned char *a, const unsigned char *b, int n)
+{
+	float sums[3];
+	vec_sums(a, b, n, VEC_DOT, sums);
+	return sums[0];
+}
+
+/* NaN for a zero vector */
+static double vec_cosine(const unsigned char *a, const unsigned char *b, int n)
+{
+	float sums[3];
+	vec_sums(a, b, n, VEC_COSINE, sums);
+	return sums[1] > 0 && sums[2] > 0 ? sums[0] / sqrt((double)sums[1] * sums[2]) : NAN;
+}
+
+static double vec_distance(int metric, const unsigned char *a, const unsigned char *b, int n)
+{
+	switch (metric)
+	{
+	case VEC_COSINE:
+	{
+		/* a zero vector is as far from everything as an orthogonal one */
+		double similarity = vec_cosine(a, b, n);
+		return isnan(similarity) ? 1.0 : 1.0 - similarity;
+	}
+	case VEC_DOT:
+		return -vec_dot(a, b, n);
+	default:
+		return vec_l2(a, b, n);
+	}
+}
+
+/*
+** Scalar functions, the user data is the metric
+*/
+static void vec_function(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+	static const char *const azFunc[] = { "vec_l2", "vec_cosine", "vec_dot" };
+	int metric = (int)(intptr_t)sqlite3_user_data(ctx);
+	(void)argc;
+	if (sqlite3_value_type(argv[0]) == SQLITE_NULL || sqlite3_value_type(argv[1]) == SQLITE_NULL)
+	{
+		return;
+	}
+	int nA = sqlite3_value_bytes(argv[0]);
+	int nB = sqlite3_value_bytes(argv[1]);
+	if (sqlite3_value_type(argv[0]) != SQLITE_BLOB || sqlite3_value_type(argv[1]) != SQLITE_BLOB || nA != nB || nA % 4 != 0)
+	{
+		char *zErr = sqlite3_mprintf("%s() expects two BLOBs of float32s of the same length", azFunc[metric]);
+		sqlite3_result_error(ctx, zErr, -1);
+		sqlite3_free(zErr);
+		return;
+	}
+	const unsigned char *a = sqlite3_value_blob(argv[0]);
+	const unsigned char *b = sqlite3_value_blob(argv[1]);
+	double result = metric == VEC_L2 ? vec_l2(a, b, nA / 4) : metric == VEC_DOT ? vec_dot(a, b, nA / 4) : vec_cosine(a, b, nA / 4);
+	if (!isnan(result))
+	{
+		sqlite3_result_double(ctx, result);
+	}
+}
+
+/*
+** The K nearest rows so far, a max-heap on the distance so the farthest one
+** is replaced first.
+*/
+typedef struct vec_hit
+{
+	sqlite3_int64 id;
+	double distance;
+} vec_hit;
+
+typedef struct vec_heap
+{
+	vec_hit *a;
+	int n;
+	int k;
+} vec_heap;
+
+static int vec_heap_init(vec_heap *pHeap, int k)
+{
+	pHeap->a = sqlite3_malloc64(sizeof(vec_hit) * k);
+	pHeap->n = 0;
+	pHeap->k = k;
+	return pHeap->a != NULL ? SQLITE_OK : SQLITE_NOMEM;
+}
+
+static void vec_heap_push(vec_heap *pHeap, sqlite3_int64 id, double distance)
+{
+	vec_hit *a = pHeap->a;
+	int i;
+	if (isnan(distance))
+	{
+		return;
+	}
+	if (pHeap->n < pHeap->k)
+	{
+		/* sift up */
+		i = pHeap->n++;
+		while (i > 0 && a[(i - 1) / 2].distance < distance)
+		{
+			a[i] = a[(i - 1) / 2];
+			i = (i - 1) / 2;
+		}
+		a[i].id = id;
+		a[i].distance = distance;
+		return;
+	}
+	if (distance >= a[0].distance)
+	{
+		return;
+	}
+	/* sift down from the root */
+	i = 0;
+	for (;;)
+	{
+		int child = i * 2 + 1;
+		if (child >= pHeap->n)
+		{
+			break;
+		}
+		if (child + 1 < pHeap->n && a[child + 1].distance > a[child].distance)
+		{
+			child++;
+		}
+		if (a[child].distance <= distance)
+		{
+			break;
+		}
+		a[i] = a[child];
+		i = child;
+	}
+	a[i].id = id;
+	a[i].distance = distance;
+}
+
+static int vec_hit_cmp(const void *pA, const void *pB)
+{
+	const vec_hit *a = pA;
+	const vec_hit *b = pB;
+	if (a->distance != b->distance)
+	{
+		return a->distance < b->distance ? -1 : 1;
+	}
+	return a->id < b->id ? -1 : a->id > b->id;
+}
+
+static void vec_heap_sort(vec_heap *pHeap)
+{
+	qsort(pHeap->a, pHeap->n, sizeof(vec_hit), vec_hit_cmp);
+}
+
+/* whether pValue is a vector, or of nBytes bytes when nBytes is not 0 */
+static int vec_check(sqlite3_value *pValue, int nBytes)
+{
+	int n = sqlite3_value_bytes(pValue);
+	return sqlite3_value_type(pValue) == SQLITE_BLOB && n > 0 && n % 4 == 0 && (nBytes == 0 || n == nBytes);
+}
+
+/*
+** Cursors of vec_topk and of MATCH queries on vec_ivf, the sorted hits of
+** xFilter.
+*/
+typedef struct vec_hits_cursor
+{
+	sqlite3_vtab_cursor base;
+	vec_heap hits;
+	int i;
+} vec_hits_cursor;
+
+
+static int vec_hits_open(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCursor)
+{
+	vec_hits_cursor *pCur = sqlite3_malloc(sizeof(vec_hits_cursor));
+	(void)pVtab;
+	if (pCur == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	memset(pCur, 0, sizeof(vec_hits_cursor));
+	*ppCursor = &pCur->base;
+	return SQLITE_OK;
+}
+
+static int vec_hits_close(sqlite3_vtab_cursor *pCursor)
+{
+	vec_hits_cursor *pCur = (vec_hits_cursor *)pCursor;
+	sqlite3_free(pCur->hits.a);
+	sqlite3_free(pCur);
+	return SQLITE_OK;
+}
+
+static int vec_hits_next(sqlite3_vtab_cursor *pCursor)
+{
+	((vec_hits_cursor *)pCursor)->i++;
+	return SQLITE_OK;
+}
+
+static int vec_hits_eof(sqlite3_vtab_cursor *pCursor)
+{
+	vec_hits_cursor *pCur = (vec_hits_cursor *)pCursor;
+	return pCur->i >= pCur->hits.n;
+}
+
+static int vec_hits_rowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
+{
+	vec_hits_cursor *pCur = (vec_hits_cursor *)pCursor;
+	*pRowid = pCur->hits.a[pCur->i].id;
+	return SQLITE_OK;
+}
+
+/* sets the error message of a virtual table, returns rc */
+static int vec_error(sqlite3_vtab *pVtab, int rc, const char *zFormat, ...)
+{
+	va_list ap;
+	va_start(ap, zFormat);
+	sqlite3_free(pVtab->zErrMsg);
+	pVtab->zErrMsg = sqlite3_vmprintf(zFormat, ap);
+	va_end(ap);
+	return rc;
+}
+
+static int vec_int_arg(sqlite3_vtab *pVtab, sqlite3_value *pValue, const char *zWhat, int *pOut)
+{
+	sqlite3_int64 i = sqlite3_value_int64(pValue);
+	if (sqlite3_value_numeric_type(pValue) != SQLITE_INTEGER || i < 1 || i > VEC_MAX_K)
+	{
+		vec_error(pVtab, SQLITE_ERROR, "%s must be an integer between 1 and %d", zWhat, VEC_MAX_K);
+		return 0;
+	}
+	*pOut = (int)i;
+	return 1;
+}
+
+/*
+** vec_topk(table_name, column_name, query [, k [, metric]]), an eponymous
+** table-valued function that scans every row, k defaults to 10 and metric
+** to l2.
+*/
+#define TOPK_ID 0
+#define TOPK_DISTANCE 1
+#define TOPK_TABLE 2
+#define TOPK_NARG 5
+
+typedef struct vec_topk_vtab
+{
+	sqlite3_vtab base;
+	sqlite3 *db;
+} vec_topk_vtab;
+
+static int vec_topk_connect(sqlite3 *db, void *pAux, int argc, const char *const *argv, sqlite3_vtab **ppVtab, char **pzErr)
+{
+	(void)pAux;
+	(void)argc;
+	(void)argv;
+	(void)pzErr;
+	int rc = sqlite3_declare_vtab(db,
+		"CREATE TABLE x(id INTEGER, distance REAL, table_name HIDDEN, column_name HIDDEN, query HIDDEN, k HIDDEN, metric HIDDEN)");
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	vec_topk_vtab *pVtab = sqlite3_malloc(sizeof(vec_topk_vtab));
+	if (pVtab == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	memset(pVtab, 0, sizeof(vec_topk_vtab));
+	pVtab->db = db;
+	*ppVtab = &pVtab->base;
+	return SQLITE_OK;
+}
+
+static int vec_topk_disconnect(sqlite3_vtab *pVtab)
+{
+	sqlite3_free(pVtab);
+	return SQLITE_OK;
+}
+
+/* idxNum has bit i set for argument i, they come in argument order */
+static int vec_topk_best_index(sqlite3_vtab *pVtab, sqlite3_index_info *pInfo)
+{
+	int aArg[TOPK_NARG] = { -1, -1, -1, -1, -1 };
+	(void)pVtab;
+	for (int i = 0; i < pInfo->nConstraint; i++)
+	{
+		const struct sqlite3_index_constraint *c = &pInfo->aConstraint[i];
+		if (c->iColumn < TOPK_TABLE || c->op != SQLITE_INDEX_CONSTRAINT_EQ)
+		{
+			continue;
+		}
+		/* another join order has to supply the argument first */
+		if (!c->usable)
+		{
+			return SQLITE_CONSTRAINT;
+		}
+		aArg[c->iColumn - TOPK_TABLE] = i;
+	}
+	int nArg = 0;
+	for (int i = 0; i < TOPK_NARG; i++)
+	{
+		if (aArg[i] >= 0)
+		{
+			pInfo->aConstraintUsage[aArg[i]].argvIndex = ++nArg;
+			pInfo->aConstraintUsage[aArg[i]].omit = 1;
+			pInfo->idxNum |= 1 << i;
+		}
+	}
+	pInfo->estimatedCost = 1000000;
+	pInfo->estimatedRows = 10;
+	if (pInfo->nOrderBy == 1 && pInfo->aOrderBy[0].iColumn == TOPK_DISTANCE && !pInfo->aOrderBy[0].desc)
+	{
+		pInfo->orderByConsumed = 1;
+	}
+	return SQLITE_OK;
+}
+
+static int vec_topk_filter(sqlite3_vtab_cursor *pCursor, int idxNum, const char *idxStr, int argc, sqlite3_value **argv)
+{
+	vec_hits_cursor *pCur = (vec_hits_cursor *)pCursor;
+	vec_topk_vtab *pVtab = (vec_topk_vtab *)pCursor->pVtab;
+	sqlite3_value *aArg[TOPK_NARG] = { NULL, NULL, NULL, NULL, NULL };
+	(void)idxStr;
+	(void)argc;
+	for (int i = 0, j = 0; i < TOPK_NARG; i++)
+	{
+		if (idxNum & (1 << i))
+		{
+			aArg[i] = argv[j++];
+		}
+	}
+	sqlite3_free(pCur->hits.a);
+	memset(&pCur->hits, 0, sizeof(vec_heap));
+	pCur->i = 0;
+	if (aArg[0] == NULL || aArg[1] == NULL || aArg[2] == NULL)
+	{
+		return vec_error(&pVtab->base, SQLITE_ERROR, "vec_topk() needs a table, a column and a query vector");
+	}
+	if (!vec_check(aArg[2], 0))
+	{
+		return vec_error(&pVtab->base, SQLITE_ERROR, "vec_topk() expects a BLOB of float32s as the query");
+	}
+	int k = 10;
+	if (aArg[3] != NULL && !vec_int_arg(&pVtab->base, aArg[3], "k of vec_topk()", &k))
+	{
+		return SQLITE_ERROR;
+	}
+	int metric = vec_metric_parse(aArg[4] != NULL ? (const char *)sqlite3_value_text(aArg[4]) : NULL);
+	if (metric < 0)
+	{
+		return vec_error(&pVtab->base, SQLITE_ERROR, "vec_topk() metric must be l2, cosine or dot");
+	}
+
+	const unsigned char *query = sqlite3_value_blob(aArg[2]);
+	int nQuery = sqlite3_value_bytes(aArg[2]);
+	char *zSql = sqlite3_mprintf("SELECT rowid, \"%w\" FROM \"%w\"", sqlite3_value_text(aArg[1]), sqlite3_value_text(aArg[0]));
+	sqlite3_stmt *pStmt = NULL;
+	if (zSql == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	int rc = sqlite3_prepare_v2(pVtab->db, zSql, -1, &pStmt, NULL);
+	sqlite3_free(zSql);
+	if (rc != SQLITE_OK)
+	{
+		return vec_error(&pVtab->base, rc, "%s", sqlite3_errmsg(pVtab->db));
+	}
+	rc = vec_heap_init(&pCur->hits, k);
+	while (rc == SQLITE_OK && sqlite3_step(pStmt) == SQLITE_ROW)
+	{
+		if (sqlite3_column_type(pStmt, 1) == SQLITE_NULL)
+		{
+			continue;
+		}
+		const unsigned char *vector = sqlite3_column_blob(pStmt, 1);
+		if (sqlite3_column_type(pStmt, 1) != SQLITE_BLOB || sqlite3_column_bytes(pStmt, 1) != nQuery)
+		{
+			rc = vec_error(&pVtab->base, SQLITE_ERROR, "vec_topk() found %d bytes in row %lld, the query has %d",
+				sqlite3_column_bytes(pStmt, 1), sqlite3_column_int64(pStmt, 0), nQuery);
+			break;
+		}
+		vec_heap_push(&pCur->hits, sqlite3_column_int64(pStmt, 0), vec_distance(metric, query, vector, nQuery / 4));
+	}
+	if (rc == SQLITE_OK && (rc = sqlite3_finalize(pStmt)) != SQLITE_OK)
+	{
+		return vec_error(&pVtab->base, rc, "%s", sqlite3_errmsg(pVtab->db));
+	}
+	if (rc != SQLITE_OK)
+	{
+		sqlite3_finalize(pStmt);
+		return rc;
+	}
+	vec_heap_sort(&pCur->hits);
+	return SQLITE_OK;
+}
+
+static int vec_topk_column(sqlite3_vtab_cursor *pCursor, sqlite3_context *ctx, int i)
+{
+	vec_hits_cursor *pCur = (vec_hits_cursor *)pCursor;
+	if (i == TOPK_ID)
+	{
+		sqlite3_result_int64(ctx, pCur->hits.a[pCur->i].id);
+	}
+	else if (i == TOPK_DISTANCE)
+	{
+		sqlite3_result_double(ctx, pCur->hits.a[pCur->i].distance);
+	}
+	return SQLITE_OK;
+}
+
+static sqlite3_module vec_topk_module = {
+	0,
+	NULL,
+	vec_topk_connect,
+	vec_topk_best_index,
+	vec_topk_disconnect,
+	NULL,
+	vec_hits_open,
+	vec_hits_close,
+	vec_topk_filter,
+	vec_hits_next,
+	vec_hits_eof,
+	vec_topk_column,
+	vec_hits_rowid,
+};
+
+/*
+** vec_ivf(dimensions=N [, lists=N] [, metric=l2|cosine|dot]), an inverted
+** file index over three shadow tables:
+**
+**   %_centroids(list, vector)    the centroids found by 'train'
+**   %_rows(id, list)             the list of every row
+**   %_lists(list, id, vector)    the vectors, clustered by list
+**
+** Rows inserted before the first 'train' go to list -1, which every query
+** scans, later rows to the list of the nearest centroid. Training again
+** after the data drifted clusters every row anew. Lists default to 100 and
+** queries probe the sqrt(lists) nearest ones unless they set probes.
+*/
+#define IVF_VECTOR 0
+#define IVF_DISTANCE 1
+#define IVF_K 2
+#define IVF_PROBES 3
+#define IVF_COMMAND 4
+
+#define IVF_PLAN_SCAN 0
+#define IVF_PLAN_ROWID 1
+#define IVF_PLAN_MATCH 2
+#define IVF_PLAN_K 4
+#define IVF_PLAN_PROBES 8
+
+#define IVF_UNTRAINED (-1)
+#define IVF_MAX_LISTS 65536
+#define IVF_MAX_DIMENSIONS 65536
+/* k-means runs on a sample of this many rows per list */
+#define IVF_SAMPLE 256
+#define IVF_ITERATIONS 10
+
+enum
+{
+	IVF_INSERT_ROW,
+	IVF_INSERT_LIST,
+	IVF_SELECT_LIST,
+	IVF_DELETE_ROW,
+	IVF_DELETE_LIST,
+	IVF_SCAN_LIST,
+	IVF_SELECT_VECTOR,
+	IVF_STMT_COUNT
+};
+
+/* formatted with the schema and the table name, twice */
+static const char *const ivf_sql[IVF_STMT_COUNT] = {
+	"INSERT INTO \"%w\".\"%w_rows\"(id, list) VALUES (?1, ?2)",
+	"INSERT INTO \"%w\".\"%w_lists\"(list, id, vector) VALUES (?1, ?2, ?3)",
+	"SELECT list FROM \"%w\".\"%w_rows\" WHERE id = ?1",
+	"DELETE FROM \"%w\".\"%w_rows\" WHERE id = ?1",
+	"DELETE FROM \"%w\".\"%w_lists\" WHERE list = ?1 AND id = ?2",
+	"SELECT id, vector FROM \"%w\".\"%w_lists\" WHERE list = ?1",
+	"SELECT id, vector FROM \"%w\".\"%w_lists\" WHERE list = (SELECT list FROM \"%w\".\"%w_rows\" WHERE id = ?1) AND id = ?1",
+};
+
+typedef struct vec_ivf_vtab
+{
+	sqlite3_vtab base;
+	sqlite3 *db;
+	char *zSchema;
+	char *zName;
+	int dimensions;
+	int lists;
+	int metric;
+	/* the centroids as of dataVersion, reloaded once another connection commits */
+	float *aCentroid;
+	int nCentroid;
+	int cached;
+	unsigned int dataVersion;
+	sqlite3_stmt *aStmt[IVF_STMT_COUNT];
+} vec_ivf_vtab;
+
+typedef struct vec_ivf_cursor
+{
+	/* the hits of IVF_PLAN_MATCH */
+	vec_hits_cursor hits;
+	int plan;
+	/* the rows of the other plans */
+	sqlite3_stmt *pStmt;
+	int eof;
+} vec_ivf_cursor;
+
+static int ivf_exec(vec_ivf_vtab *p, const char *zFormat, ...)
+{
+	va_list ap;
+	va_start(ap, zFormat);
+	char *zSql = sqlite3_vmprintf(zFormat, ap);
+	va_end(ap);
+	if (zSql == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	int rc = sqlite3_exec(p->db, zSql, NULL, NULL, NULL);
+	sqlite3_free(zSql);
+	if (rc != SQLITE_OK)
+	{
+		return vec_error(&p->base, rc, "%s", sqlite3_errmsg(p->db));
+	}
+	return SQLITE_OK;
+}
+
+static int ivf_prepare(vec_ivf_vtab *p, const char *zFormat, sqlite3_stmt **ppStmt, unsigned int prepFlags)
+{
+	char *zSql = sqlite3_mprintf(zFormat, p->zSchema, p->zName, p->zSchema, p->zName);
+	if (zSql == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	int rc = sqlite3_prepare_v3(p->db, zSql, -1, prepFlags, ppStmt, NULL);
+	sqlite3_free(zSql);
+	if (rc != SQLITE_OK)
+	{
+		return vec_error(&p->base, rc, "%s", sqlite3_errmsg(p->db));
+	}
+	return SQLITE_OK;
+}
+
+/* one of the statements of ivf_sql, prepared on first use */
+static int ivf_stmt(vec_ivf_vtab *p, int i, sqlite3_stmt **ppStmt)
+{
+	if (p->aStmt[i] == NULL)
+	{
+		int rc = ivf_prepare(p, ivf_sql[i], &p->aStmt[i], SQLITE_PREPARE_PERSISTENT);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+	*ppStmt = p->aStmt[i];
+	return SQLITE_OK;
+}
+
+/* resets a statement after its last step, which reports the error of the step */
+static int ivf_reset(vec_ivf_vtab *p, sqlite3_stmt *pStmt)
+{
+	int rc = sqlite3_reset(pStmt);
+	if (rc != SQLITE_OK)
+	{
+		return vec_error(&p->base, rc, "%s", sqlite3_errmsg(p->db));
+	}
+	return SQLITE_OK;
+}
+
+static void ivf_free(vec_ivf_vtab *p)
+{
+	for (int i = 0; i < IVF_STMT_COUNT; i++)
+	{
+		sqlite3_finalize(p->aStmt[i]);
+	}
+	sqlite3_free(p->aCentroid);
+	sqlite3_free(p->zSchema);
+	sqlite3_free(p->zName);
+	sqlite3_free(p);
+}
+
+static int ivf_parse(vec_ivf_vtab *p, int argc, const char *const *argv, char **pzErr)
+{
+	p->lists = 100;
+	p->metric = VEC_L2;
+	for (int i = 3; i < argc; i++)
+	{
+		char zKey[16], zValue[16], *zEnd;
+		if (sscanf(argv[i], " %15[a-z] = %15s", zKey, zValue) != 2)
+		{
+			*pzErr = sqlite3_mprintf("vec_ivf argument %s is not key=value", argv[i]);
+			return SQLITE_ERROR;
+		}
+		long value = strtol(zValue, &zEnd, 10);
+		if (strcmp(zKey, "dimensions") == 0 && *zEnd == '\0' && value >= 1 && value <= IVF_MAX_DIMENSIONS)
+		{
+			p->dimensions = (int)value;
+		}
+		else if (strcmp(zKey, "lists") == 0 && *zEnd == '\0' && value >= 1 && value <= IVF_MAX_LISTS)
+		{
+			p->lists = (int)value;
+		}
+		else if (strcmp(zKey, "metric") == 0 && vec_metric_parse(zValue) >= 0)
+		{
+			p->metric = vec_metric_parse(zValue);
+		}
+		else
+		{
+			*pzErr = sqlite3_mprintf("vec_ivf argument %s is not valid", argv[i]);
+			return SQLITE_ERROR;
+		}
+	}
+	if (p->dimensions == 0)
+	{
+		*pzErr = sqlite3_mprintf("vec_ivf needs dimensions=N");
+		return SQLITE_ERROR;
+	}
+	return SQLITE_OK;
+}
+
+static int ivf_init(sqlite3 *db, int argc, const char *const *argv, sqlite3_vtab **ppVtab, char **pzErr, int create)
+{
+	vec_ivf_vtab *p = sqlite3_malloc(sizeof(vec_ivf_vtab));
+	if (p == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	memset(p, 0, sizeof(vec_ivf_vtab));
+	p->db = db;
+	p->zSchema = sqlite3_mprintf("%s", argv[1]);
+	p->zName = sqlite3_mprintf("%s", argv[2]);
+	int rc = p->zSchema != NULL && p->zName != NULL ? ivf_parse(p, argc, argv, pzErr) : SQLITE_NOMEM;
+	if (rc == SQLITE_OK && create)
+	{
+		rc = ivf_exec(p,
+			"CREATE TABLE \"%w\".\"%w_centroids\"(list INTEGER PRIMARY KEY, vector BLOB NOT NULL);"
+			"CREATE TABLE \"%w\".\"%w_rows\"(id INTEGER PRIMARY KEY, list INTEGER NOT NULL);"
+			"CREATE TABLE \"%w\".\"%w_lists\"(list INTEGER, id INTEGER, vector BLOB NOT NULL, PRIMARY KEY (list, id)) WITHOUT ROWID;",
+			p->zSchema, p->zName, p->zSchema, p->zName, p->zSchema, p->zName);
+		if (rc != SQLITE_OK)
+		{
+			*pzErr = sqlite3_mprintf("%s", p->base.zErrMsg);
+			sqlite3_free(p->base.zErrMsg);
+		}
+	}
+	if (rc == SQLITE_OK)
+	{
+		char *zSql = sqlite3_mprintf("CREATE TABLE x(vector BLOB, distance REAL HIDDEN, k HIDDEN, probes HIDDEN, \"%w\" HIDDEN)", p->zName);
+		rc = zSql != NULL ? sqlite3_declare_vtab(db, zSql) : SQLITE_NOMEM;
+		sqlite3_free(zSql);
+	}
+	if (rc != SQLITE_OK)
+	{
+		ivf_free(p);
+		return rc;
+	}
+	*ppVtab = &p->base;
+	return SQLITE_OK;
+}
+
+static int ivf_create(sqlite3 *db, void *pAux, int argc, const char *const *argv, sqlite3_vtab **ppVtab, char **pzErr)
+{
+	(void)pAux;
+	return ivf_init(db, argc, argv, ppVtab, pzErr, 1);
+}
+
+static int ivf_connect(sqlite3 *db, void *pAux, int argc, const char *const *argv, sqlite3_vtab **ppVtab, char **pzErr)
+{
+	(void)pAux;
+	return ivf_init(db, argc, argv, ppVtab, pzErr, 0);
+}
+
+static int ivf_disconnect(sqlite3_vtab *pVtab)
+{
+	ivf_free((vec_ivf_vtab *)pVtab);
+	return SQLITE_OK;
+}
+
+static int ivf_destroy(sqlite3_vtab *pVtab)
+{
+	vec_ivf_vtab *p = (vec_ivf_vtab *)pVtab;
+	int rc = ivf_exec(p,
+		"DROP TABLE \"%w\".\"%w_centroids\"; DROP TABLE \"%w\".\"%w_rows\"; DROP TABLE \"%w\".\"%w_lists\";",
+		p->zSchema, p->zName, p->zSchema, p->zName, p->zSchema, p->zName);
+	if (rc == SQLITE_OK)
+	{
+		ivf_free(p);
+	}
+	return rc;
+}
+
+static int ivf_rename(sqlite3_vtab *pVtab, const char *zNew)
+{
+	vec_ivf_vtab *p = (vec_ivf_vtab *)pVtab;
+	char *zName = sqlite3_mprintf("%s", zNew);
+	if (zName == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	int rc = ivf_exec(p,
+		"ALTER TABLE \"%w\".\"%w_centroids\" RENAME TO \"%w_centroids\";"
+		"ALTER TABLE \"%w\".\"%w_rows\" RENAME TO \"%w_rows\";"
+		"ALTER TABLE \"%w\".\"%w_lists\" RENAME TO \"%w_lists\";",
+		p->zSchema, p->zName, zNew, p->zSchema, p->zName, zNew, p->zSchema, p->zName, zNew);
+	if (rc != SQLITE_OK)
+	{
+		sqlite3_free(zName);
+		return rc;
+	}
+	for (int i = 0; i < IVF_STMT_COUNT; i++)
+	{
+		sqlite3_finalize(p->aStmt[i]);
+		p->aStmt[i] = NULL;
+	}
+	sqlite3_free(p->zName);
+	p->zName = zName;
+	return SQLITE_OK;
+}
+
+static int ivf_shadow_name(const char *zName)
+{
+	return strcmp(zName, "centroids") == 0 || strcmp(zName, "rows") == 0 || strcmp(zName, "lists") == 0;
+}
+
+static int ivf_load_centroids(vec_ivf_vtab *p)
+{
+	unsigned int version = 0;
+	sqlite3_file_control(p->db, p->zSchema, SQLITE_FCNTL_DATA_VERSION, &version);
+	if (p->cached && version == p->dataVersion)
+	{
+		return SQLITE_OK;
+	}
+	sqlite3_free(p->aCentroid);
+	p->aCentroid = sqlite3_malloc64((sqlite3_int64)p->lists * p->dimensions * 4);
+	p->nCentroid = 0;
+	p->cached = 0;
+	if (p->aCentroid == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	sqlite3_stmt *pStmt;
+	int rc = ivf_prepare(p, "SELECT vector FROM \"%w\".\"%w_centroids\" ORDER BY list", &pStmt, 0);
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	while (p->nCentroid < p->lists && sqlite3_step(pStmt) == SQLITE_ROW)
+	{
+		if (sqlite3_column_bytes(pStmt, 0) != p->dimensions * 4)
+		{
+			sqlite3_finalize(pStmt);
+			return vec_error(&p->base, SQLITE_CORRUPT_VTAB, "vec_ivf table %s has a centroid of the wrong size", p->zName);
+		}
+		memcpy(p->aCentroid + (size_t)p->nCentroid * p->dimensions, sqlite3_column_blob(pStmt, 0), p->dimensions * 4);
+		p->nCentroid++;
+	}
+	rc = sqlite3_finalize(pStmt);
+	if (rc != SQLITE_OK)
+	{
+		return vec_error(&p->base, rc, "%s", sqlite3_errmsg(p->db));
+	}
+	p->cached = 1;
+	p->dataVersion = version;
+	return SQLITE_OK;
+}
+
+static int ivf_nearest(const float *aCentroid, int nCentroid, int dimensions, int metric, const unsigned char *vector)
+{
+	int best = IVF_UNTRAINED;
+	double bestDistance = INFINITY;
+	for (int i = 0; i < nCentroid; i++)
+	{
+		double distance = vec_distance(metric, (const unsigned char *)(aCentroid + (size_t)i * dimensions), vector, dimensions);
+		if (distance < bestDistance)
+		{
+			best = i;
+			bestDistance = distance;
+		}
+	}
+	return best;
+}
+
+static int ivf_insert(vec_ivf_vtab *p, sqlite3_value *pId, sqlite3_value *pVector, sqlite3_int64 *pRowid)
+{
+	sqlite3_stmt *pStmt;
+	if (!vec_check(pVector, p->dimensions * 4))
+	{
+		return vec_error(&p->base, SQLITE_ERROR, "vec_ivf table %s takes BLOBs of %d float32s", p->zName, p->dimensions);
+	}
+	int rc = ivf_load_centroids(p);
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	int list = ivf_nearest(p->aCentroid, p->nCentroid, p->dimensions, p->metric, sqlite3_value_blob(pVector));
+	if ((rc = ivf_stmt(p, IVF_INSERT_ROW, &pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	sqlite3_bind_value(pStmt, 1, pId);
+	sqlite3_bind_int(pStmt, 2, list);
+	sqlite3_step(pStmt);
+	if ((rc = ivf_reset(p, pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	*pRowid = sqlite3_last_insert_rowid(p->db);
+	if ((rc = ivf_stmt(p, IVF_INSERT_LIST, &pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	sqlite3_bind_int(pStmt, 1, list);
+	sqlite3_bind_int64(pStmt, 2, *pRowid);
+	sqlite3_bind_value(pStmt, 3, pVector);
+	sqlite3_step(pStmt);
+	return ivf_reset(p, pStmt);
+}
+
+static int ivf_delete(vec_ivf_vtab *p, sqlite3_int64 id)
+{
+	sqlite3_stmt *pStmt;
+	int rc = ivf_stmt(p, IVF_SELECT_LIST, &pStmt);
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	sqlite3_bind_int64(pStmt, 1, id);
+	int found = sqlite3_step(pStmt) == SQLITE_ROW;
+	int list = sqlite3_column_int(pStmt, 0);
+	if ((rc = ivf_reset(p, pStmt)) != SQLITE_OK || !found)
+	{
+		return rc;
+	}
+	if ((rc = ivf_stmt(p, IVF_DELETE_ROW, &pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	sqlite3_bind_int64(pStmt, 1, id);
+	sqlite3_step(pStmt);
+	if ((rc = ivf_reset(p, pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	if ((rc = ivf_stmt(p, IVF_DELETE_LIST, &pStmt)) != SQLITE_OK)
+	{
+		return rc;
+	}
+	sqlite3_bind_int(pStmt, 1, list);
+	sqlite3_bind_int64(pStmt, 2, id);
+	sqlite3_step(pStmt);
+	return ivf_reset(p, pStmt);
+}
+
+typedef struct ivf_move
+{
+	sqlite3_int64 id;
+	int from;
+	int to;
+} ivf_move;
+
+/* k-means on a sample, then every row moves to the list of its nearest centroid */
+static int ivf_kmeans(vec_ivf_vtab *p, float *aCentroid, const float *aSample, int nSample)
+{
+	int d = p->dimensions;
+	double *aSum = sqlite3_malloc64(sizeof(double) * p->lists * d);
+	int *aCount = sqlite3_malloc64(sizeof(int) * p->lists);
+	int *aAssign = sqlite3_malloc64(sizeof(int) * nSample);
+	if (aSum == NULL || aCount == NULL || aAssign == NULL)
+	{
+		sqlite3_free(aSum);
+		sqlite3_free(aCount);
+		sqlite3_free(aAssign);
+		return SQLITE_NOMEM;
+	}
+	/* evenly spaced samples as the initial centroids */
+	for (int j = 0; j < p->lists; j++)
+	{
+		memcpy(aCentroid + (size_t)j * d, aSample + (size_t)(j * (sqlite3_int64)nSample / p->lists) * d, d * 4);
+	}
+	for (int iteration = 0; iteration < IVF_ITERATIONS; iteration++)
+	{
+		int changed = 0;
+		for (int s = 0; s < nSample; s++)
+		{
+			int list = ivf_nearest(aCentroid, p->lists, d, p->metric, (const unsigned char *)(aSample + (size_t)s * d));
+			changed += iteration == 0 || list != aAssign[s];
+			aAssign[s] = list;
+		}
+		if (changed == 0)
+		{
+			break;
+		}
+		memset(aSum, 0, sizeof(double) * p->lists * d);
+		memset(aCount, 0, sizeof(int) * p->lists);
+		for (int s = 0; s < nSample; s++)
+		{
+			if (aAssign[s] < 0)
+			{
+				continue;
+			}
+			double *sum = aSum + (size_t)aAssign[s] * d;
+			for (int i = 0; i < d; i++)
+			{
+				sum[i] += aSample[(size_t)s * d + i];
+			}
+			aCount[aAssign[s]]++;
+		}
+		/* an empty list keeps its centroid */
+		for (int j = 0; j < p->lists; j++)
+		{
+			if (aCount[j] == 0)
+			{
+				continue;
+			}
+			double norm = 0;
+			for (int i = 0; i < d; i++)
+			{
+				double mean = aSum[(size_t)j * d + i] / aCount[j];
+				aCentroid[(size_t)j * d + i] = (float)mean;
+				norm += mean * mean;
+			}
+			/* spherical k-means, cosine only depends on the direction */
+			if (p->metric == VEC_COSINE && norm > 0)
+			{
+				for (int i = 0; i < d; i++)
+				{
+					aCentroid[(size_t)j * d + i] /= (float)sqrt(norm);
+				}
+			}
+		}
+	}
+	sqlite3_free(aSum);
+	sqlite3_free(aCount);
+	sqlite3_free(aAssign);
+	return SQLITE_OK;
+}
+
+/* the vector of a _lists row, NULL with the error set when its size is wrong */
+static const unsigned char *ivf_list_vector(vec_ivf_vtab *p, sqlite3_stmt *pStmt, int iId, int iVector)
+{
+	const unsigned char *vector = sqlite3_column_blob(pStmt, iVector);
+	if (vector == NULL || sqlite3_column_bytes(pStmt, iVector) != p->dimensions * 4)
+	{
+		vec_error(&p->base, SQLITE_CORRUPT_VTAB, "vec_ivf table %s has a vector of the wrong size in row %lld", p->zName,
+			sqlite3_column_int64(pStmt, iId));
+		return NULL;
+	}
+	return vector;
+}
+
+static int ivf_train(vec_ivf_vtab *p)
+{
+	int d = p->dimensions;
+	sqlite3_stmt *pStmt;
+	sqlite3_int64 nRow = 0;
+	int rc = ivf_prepare(p, "SELECT count(*) FROM \"%w\".\"%w_rows\"", &pStmt, 0);
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	if (sqlite3_step(pStmt) == SQLITE_ROW)
+	{
+		nRow = sqlite3_column_int64(pStmt, 0);
+	}
+	sqlite3_finalize(pStmt);
+	if (nRow < p->lists)
+	{
+		return vec_error(&p->base, SQLITE_ERROR, "vec_ivf table %s needs at least %d rows to train", p->zName, p->lists);
+	}
+
+	/* every step-th row as the sample */
+	sqlite3_int64 maxSample = (sqlite3_int64)p->lists * IVF_SAMPLE;
+	int nSample = (int)(nRow < maxSample ? nRow : maxSample);
+	sqlite3_int64 step = nRow / nSample;
+	float *aSample = sqlite3_malloc64((sqlite3_int64)nSample * d * 4);
+	float *aCentroid = sqlite3_malloc64((sqlite3_int64)p->lists * d * 4);
+	ivf_move *aMove = NULL;
+	int nMove = 0, nMoveAlloc = 0;
+	if (aSample == NULL || aCentroid == NULL)
+	{
+		rc = SQLITE_NOMEM;
+		goto done;
+	}
+	if ((rc = ivf_prepare(p, "SELECT id, vector FROM \"%w\".\"%w_lists\"", &pStmt, 0)) != SQLITE_OK)
+	{
+		goto done;
+	}
+	int n = 0;
+	for (sqlite3_int64 i = 0; n < nSample && sqlite3_step(pStmt) == SQLITE_ROW; i++)
+	{
+		if (i % step == 0)
+		{
+			const unsigned char *vector = ivf_list_vector(p, pStmt, 0, 1);
+			if (vector == NULL)
+			{
+				rc = SQLITE_CORRUPT_VTAB;
+				break;
+			}
+			memcpy(aSample + (size_t)n++ * d, vector, d * 4);
+		}
+	}
+	sqlite3_finalize(pStmt);
+	if (rc != SQLITE_OK)
+	{
+		goto done;
+	}
+	nSample = n;
+	if ((rc = ivf_kmeans(p, aCentroid, aSample, nSample)) != SQLITE_OK)
+	{
+		goto done;
+	}
+
+	rc = ivf_exec(p, "DELETE FROM \"%w\".\"%w_centroids\"", p->zSchema, p->zName);
+	if (rc == SQLITE_OK)
+	{
+		rc = ivf_prepare(p, "INSERT INTO \"%w\".\"%w_centroids\"(list, vector) VALUES (?1, ?2)", &pStmt, 0);
+	}
+	for (int j = 0; rc == SQLITE_OK && j < p->lists; j++)
+	{
+		sqlite3_bind_int(pStmt, 1, j);
+		sqlite3_bind_blob(pStmt, 2, aCentroid + (size_t)j * d, d * 4, SQLITE_STATIC);
+		sqlite3_step(pStmt);
+		rc = ivf_reset(p, pStmt);
+	}
+	sqlite3_finalize(pStmt);
+	if (rc != SQLITE_OK)
+	{
+		goto done;
+	}
+
+	/* the moves are collected first, the lists table can not change while it is scanned */
+	if ((rc = ivf_prepare(p, "SELECT id, list, vector FROM \"%w\".\"%w_lists\"", &pStmt, 0)) != SQLITE_OK)
+	{
+		goto done;
+	}
+	while (sqlite3_step(pStmt) == SQLITE_ROW)
+	{
+		int from = sqlite3_column_int(pStmt, 1);
+		const unsigned char *vector = ivf_list_vector(p, pStmt, 0, 2);
+		if (vector == NULL)
+		{
+			rc = SQLITE_CORRUPT_VTAB;
+			break;
+		}
+		int to = ivf_nearest(aCentroid, p->lists, d, p->metric, vector);
+		if (from == to)
+		{
+			continue;
+		}
+		if (nMove == nMoveAlloc)
+		{
+			nMoveAlloc = nMoveAlloc * 2 + 1024;
+			ivf_move *a = sqlite3_realloc64(aMove, sizeof(ivf_move) * nMoveAlloc);
+			if (a == NULL)
+			{
+				rc = SQLITE_NOMEM;
+				break;
+			}
+			aMove = a;
+		}
+		aMove[nMove].id = sqlite3_column_int64(pStmt, 0);
+		aMove[nMove].from = from;
+		aMove[nMove].to = to;
+		nMove++;
+	}
+	if (sqlite3_finalize(pStmt) != SQLITE_OK && rc == SQLITE_OK)
+	{
+		rc = vec_error(&p->base, sqlite3_errcode(p->db), "%s", sqlite3_errmsg(p->db));
+	}
+	if (rc != SQLITE_OK)
+	{
+		goto done;
+	}
+	sqlite3_stmt *pRows = NULL;
+	rc = ivf_prepare(p, "UPDATE \"%w\".\"%w_lists\" SET list = ?3 WHERE list = ?2 AND id = ?1", &pStmt, 0);
+	if (rc == SQLITE_OK)
+	{
+		rc = ivf_prepare(p, "UPDATE \"%w\".\"%w_rows\" SET list = ?3 WHERE id = ?1", &pRows, 0);
+	}
+	for (int i = 0; rc == SQLITE_OK && i < nMove; i++)
+	{
+		for (sqlite3_stmt *pUpdate = pStmt; rc == SQLITE_OK && pUpdate != NULL; pUpdate = pUpdate == pStmt ? pRows : NULL)
+		{
+			sqlite3_bind_int64(pUpdate, 1, aMove[i].id);
+			sqlite3_bind_int(pUpdate, 2, aMove[i].from);
+			sqlite3_bind_int(pUpdate, 3, aMove[i].to);
+			sqlite3_step(pUpdate);
+			rc = ivf_reset(p, pUpdate);
+		}
+	}
+	sqlite3_finalize(pStmt);
+	sqlite3_finalize(pRows);
+	if (rc == SQLITE_OK)
+	{
+		/* the cache follows the transaction, xRollback drops it */
+		sqlite3_free(p->aCentroid);
+		p->aCentroid = aCentroid;
+		p->nCentroid = p->lists;
+		p->cached = 1;
+		sqlite3_file_control(p->db, p->zSchema, SQLITE_FCNTL_DATA_VERSION, &p->dataVersion);
+		aCentroid = NULL;
+	}
+
+done:
+	sqlite3_free(aSample);
+	sqlite3_free(aCentroid);
+	sqlite3_free(aMove);
+	return rc;
+}
+
+static int ivf_update(sqlite3_vtab *pVtab, int argc, sqlite3_value **argv, sqlite3_int64 *pRowid)
+{
+	vec_ivf_vtab *p = (vec_ivf_vtab *)pVtab;
+	if (argc == 1)
+	{
+		return ivf_delete(p, sqlite3_value_int64(argv[0]));
+	}
+	/* INSERT INTO t(t) VALUES ('train') */
+	sqlite3_value *pCommand = argv[2 + IVF_COMMAND];
+	if (sqlite3_value_type(pCommand) != SQLITE_NULL)
+	{
+		const char *zCommand = (const char *)sqlite3_value_text(pCommand);
+		if (sqlite3_value_type(argv[0]) == SQLITE_NULL && sqlite3_stricmp(zCommand, "train") == 0)
+		{
+			return ivf_train(p);
+		}
+		return vec_error(pVtab, SQLITE_ERROR, "unknown vec_ivf command %Q", zCommand);
+	}
+	if (sqlite3_value_type(argv[0]) != SQLITE_NULL)
+	{
+		int rc = ivf_delete(p, sqlite3_value_int64(argv[0]));
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+	return ivf_insert(p, argv[1], argv[2 + IVF_VECTOR], pRowid);
+}
+
+static int ivf_best_index(sqlite3_vtab *pVtab, sqlite3_index_info *pInfo)
+{
+	int iMatch = -1, iK = -1, iProbes = -1, iRowid = -1;
+	(void)pVtab;
+	for (int i = 0; i < pInfo->nConstraint; i++)
+	{
+		const struct sqlite3_index_constraint *c = &pInfo->aConstraint[i];
+		if (c->iColumn == IVF_VECTOR && c->op == SQLITE_INDEX_CONSTRAINT_MATCH)
+		{
+			/* MATCH has no meaning outside of xFilter */
+			if (!c->usable)
+			{
+				return SQLITE_CONSTRAINT;
+			}
+			iMatch = i;
+		}
+		else if (c->usable && c->op == SQLITE_INDEX_CONSTRAINT_EQ)
+		{
+			if (c->iColumn == IVF_K)
+			{
+				iK = i;
+			}
+			else if (c->iColumn == IVF_PROBES)
+			{
+				iProbes = i;
+			}
+			else if (c->iColumn == -1)
+			{
+				iRowid = i;
+			}
+		}
+	}
+	if (iMatch >= 0)
+	{
+		int nArg = 0;
+		pInfo->idxNum = IVF_PLAN_MATCH;
+		pInfo->aConstraintUsage[iMatch].argvIndex = ++nArg;
+		pInfo->aConstraintUsage[iMatch].omit = 1;
+		if (iK >= 0)
+		{
+			pInfo->idxNum |= IVF_PLAN_K;
+			pInfo->aConstraintUsage[iK].argvIndex = ++nArg;
+			pInfo->aConstraintUsage[iK].omit = 1;
+		}
+		if (iProbes >= 0)
+		{
+			pInfo->idxNum |= IVF_PLAN_PROBES;
+			pInfo->aConstraintUsage[iProbes].argvIndex = ++nArg;
+			pInfo->aConstraintUsage[iProbes].omit = 1;
+		}
+		pInfo->estimatedCost = 10000;
+		pInfo->estimatedRows = 10;
+		if (pInfo->nOrderBy == 1 && pInfo->aOrderBy[0].iColumn == IVF_DISTANCE && !pInfo->aOrderBy[0].desc)
+		{
+			pInfo->orderByConsumed = 1;
+		}
+	}
+	else if (iRowid >= 0)
+	{
+		pInfo->idxNum = IVF_PLAN_ROWID;
+		pInfo->aConstraintUsage[iRowid].argvIndex = 1;
+		pInfo->aConstraintUsage[iRowid].omit = 1;
+		pInfo->estimatedCost = 10;
+		pInfo->estimatedRows = 1;
+		pInfo->idxFlags = SQLITE_INDEX_SCAN_UNIQUE;
+	}
+	else
+	{
+		pInfo->idxNum = IVF_PLAN_SCAN;
+		pInfo->estimatedCost = 1000000;
+	}
+	return SQLITE_OK;
+}
+
+static int ivf_open(sqlite3_vtab *pVtab, sqlite3_vtab_cursor **ppCursor)
+{
+	vec_ivf_cursor *pCur = sqlite3_malloc(sizeof(vec_ivf_cursor));
+	(void)pVtab;
+	if (pCur == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	memset(pCur, 0, sizeof(vec_ivf_cursor));
+	*ppCursor = &pCur->hits.base;
+	return SQLITE_OK;
+}
+
+static int ivf_close(sqlite3_vtab_cursor *pCursor)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	sqlite3_finalize(pCur->pStmt);
+	sqlite3_free(pCur->hits.hits.a);
+	sqlite3_free(pCur);
+	return SQLITE_OK;
+}
+
+static int ivf_search(vec_ivf_vtab *p, vec_heap *pHits, const unsigned char *query, int probes)
+{
+	vec_heap nearest = { NULL, 0, 0 };
+	sqlite3_stmt *pStmt;
+	int rc = ivf_load_centroids(p);
+	if (rc == SQLITE_OK && p->nCentroid > 0)
+	{
+		rc = vec_heap_init(&nearest, probes < p->nCentroid ? probes : p->nCentroid);
+		for (int i = 0; rc == SQLITE_OK && i < p->nCentroid; i++)
+		{
+			vec_heap_push(&nearest, i, vec_distance(p->metric, (const unsigned char *)(p->aCentroid + (size_t)i * p->dimensions), query, p->dimensions));
+		}
+	}
+	if (rc == SQLITE_OK)
+	{
+		rc = ivf_stmt(p, IVF_SCAN_LIST, &pStmt);
+	}
+	/* list -1 first, then the nearest lists */
+	for (int i = -1; rc == SQLITE_OK && i < nearest.n; i++)
+	{
+		sqlite3_bind_int64(pStmt, 1, i < 0 ? IVF_UNTRAINED : nearest.a[i].id);
+		while (sqlite3_step(pStmt) == SQLITE_ROW)
+		{
+			const unsigned char *vector = ivf_list_vector(p, pStmt, 0, 1);
+			if (vector == NULL)
+			{
+				rc = SQLITE_CORRUPT_VTAB;
+				break;
+			}
+			vec_heap_push(pHits, sqlite3_column_int64(pStmt, 0), vec_distance(p->metric, query, vector, p->dimensions));
+		}
+		if (rc == SQLITE_OK)
+		{
+			rc = ivf_reset(p, pStmt);
+		}
+		else
+		{
+			sqlite3_reset(pStmt);
+		}
+	}
+	sqlite3_free(nearest.a);
+	return rc;
+}
+
+static int ivf_next(sqlite3_vtab_cursor *pCursor)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	if (pCur->plan == IVF_PLAN_MATCH)
+	{
+		pCur->hits.i++;
+		return SQLITE_OK;
+	}
+	if (sqlite3_step(pCur->pStmt) != SQLITE_ROW)
+	{
+		pCur->eof = 1;
+		return ivf_reset((vec_ivf_vtab *)pCursor->pVtab, pCur->pStmt);
+	}
+	return SQLITE_OK;
+}
+
+static int ivf_filter(sqlite3_vtab_cursor *pCursor, int idxNum, const char *idxStr, int argc, sqlite3_value **argv)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	vec_ivf_vtab *p = (vec_ivf_vtab *)pCursor->pVtab;
+	(void)idxStr;
+	(void)argc;
+	sqlite3_finalize(pCur->pStmt);
+	sqlite3_free(pCur->hits.hits.a);
+	memset(&pCur->hits.hits, 0, sizeof(vec_heap));
+	pCur->pStmt = NULL;
+	pCur->hits.i = 0;
+	pCur->eof = 0;
+	pCur->plan = idxNum & 3;
+	if (pCur->plan == IVF_PLAN_MATCH)
+	{
+		int k = 10, probes = (int)ceil(sqrt(p->lists)), i = 1;
+		if ((idxNum & IVF_PLAN_K) && !vec_int_arg(&p->base, argv[i++], "k of vec_ivf", &k))
+		{
+			return SQLITE_ERROR;
+		}
+		if ((idxNum & IVF_PLAN_PROBES) && !vec_int_arg(&p->base, argv[i++], "probes of vec_ivf", &probes))
+		{
+			return SQLITE_ERROR;
+		}
+		if (!vec_check(argv[0], p->dimensions * 4))
+		{
+			return vec_error(&p->base, SQLITE_ERROR, "vec_ivf table %s takes BLOBs of %d float32s", p->zName, p->dimensions);
+		}
+		int rc = vec_heap_init(&pCur->hits.hits, k);
+		if (rc == SQLITE_OK)
+		{
+			rc = ivf_search(p, &pCur->hits.hits, sqlite3_value_blob(argv[0]), probes);
+		}
+		vec_heap_sort(&pCur->hits.hits);
+		return rc;
+	}
+	int rc = ivf_prepare(p, pCur->plan == IVF_PLAN_ROWID ? ivf_sql[IVF_SELECT_VECTOR] : "SELECT id, vector FROM \"%w\".\"%w_lists\"", &pCur->pStmt, 0);
+	if (rc != SQLITE_OK)
+	{
+		return rc;
+	}
+	if (pCur->plan == IVF_PLAN_ROWID)
+	{
+		sqlite3_bind_value(pCur->pStmt, 1, argv[0]);
+	}
+	return ivf_next(pCursor);
+}
+
+static int ivf_eof(sqlite3_vtab_cursor *pCursor)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	return pCur->plan == IVF_PLAN_MATCH ? vec_hits_eof(pCursor) : pCur->eof;
+}
+
+static int ivf_rowid(sqlite3_vtab_cursor *pCursor, sqlite3_int64 *pRowid)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	if (pCur->plan == IVF_PLAN_MATCH)
+	{
+		return vec_hits_rowid(pCursor, pRowid);
+	}
+	*pRowid = sqlite3_column_int64(pCur->pStmt, 0);
+	return SQLITE_OK;
+}
+
+static int ivf_column(sqlite3_vtab_cursor *pCursor, sqlite3_context *ctx, int i)
+{
+	vec_ivf_cursor *pCur = (vec_ivf_cursor *)pCursor;
+	vec_ivf_vtab *p = (vec_ivf_vtab *)pCursor->pVtab;
+	if (pCur->plan != IVF_PLAN_MATCH)
+	{
+		if (i == IVF_VECTOR)
+		{
+			sqlite3_result_value(ctx, sqlite3_column_value(pCur->pStmt, 1));
+		}
+		return SQLITE_OK;
+	}
+	const vec_hit *pHit = &pCur->hits.hits.a[pCur->hits.i];
+	if (i == IVF_DISTANCE)
+	{
+		sqlite3_result_double(ctx, pHit->distance);
+	}
+	else if (i == IVF_VECTOR)
+	{
+		/* hits only keep their ids, the vector is looked up when it is read */
+		sqlite3_stmt *pStmt;
+		int rc = ivf_stmt(p, IVF_SELECT_VECTOR, &pStmt);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+		sqlite3_bind_int64(pStmt, 1, pHit->id);
+		if (sqlite3_step(pStmt) == SQLITE_ROW)
+		{
+			sqlite3_result_value(ctx, sqlite3_column_value(pStmt, 1));
+		}
+		return ivf_reset(p, pStmt);
+	}
+	return SQLITE_OK;
+}
+
+/* xBegin and xCommit, SQLite only calls xRollback of modules with xBegin */
+static int ivf_noop(sqlite3_vtab *pVtab)
+{
+	(void)pVtab;
+	return SQLITE_OK;
+}
+
+/* a rolled back 'train' leaves centroids in the cache that are not in the table */
+static int ivf_rollback(sqlite3_vtab *pVtab)
+{
+	((vec_ivf_vtab *)pVtab)->cached = 0;
+	return SQLITE_OK;
+}
+
+static int ivf_rollback_to(sqlite3_vtab *pVtab, int iSavepoint)
+{
+	(void)iSavepoint;
+	return ivf_rollback(pVtab);
+}
+
+static sqlite3_module vec_ivf_module = {
+	3,
+	ivf_create,
+	ivf_connect,
+	ivf_best_index,
+	ivf_disconnect,
+	ivf_destroy,
+	ivf_open,
+	ivf_close,
+	ivf_filter,
+	ivf_next,
+	ivf_eof,
+	ivf_column,
+	ivf_rowid,
+	ivf_update,
+	ivf_noop,
+	NULL,
+	ivf_noop,
+	ivf_rollback,
+	NULL,
+	ivf_rename,
+	NULL,
+	NULL,
+	ivf_rollback_to,
+	ivf_shadow_name,
+};
+
+int sqlite3_vec_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi)
+{
+	static const char *const azFunc[] = { "vec_l2", "vec_cosine", "vec_dot" };
+	(void)pzErrMsg;
+	(void)pApi;
+	for (int metric = VEC_L2; metric <= VEC_DOT; metric++)
+	{
+		int rc = sqlite3_create_function(db, azFunc[metric], 2, SQLITE_UTF8 | SQLITE_INNOCUOUS | SQLITE_DETERMINISTIC,
+			(void *)(intptr_t)metric, vec_function, NULL, NULL);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+	int rc = sqlite3_create_module(db, "vec_topk", &vec_topk_module, NULL);
+	if (rc == SQLITE_OK)
+	{
+		rc = sqlite3_create_module(db, "vec_ivf", &vec_ivf_module, NULL);
+	}
+	return rc;
+}
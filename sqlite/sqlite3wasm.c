@@ -1,3 +1,5 @@
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -9,6 +11,101 @@
 
 static sqlite3_vfs *ext_vfs[MAX_EXT_VFS] = { 0 };
 
+#if SQLITE_THREADSAFE && defined(_REENTRANT)
+#include <pthread.h>
+
+/*
+** SQLITE_OS_OTHER builds fall back to the no-op mutexes, so threaded builds
+** install pthread mutexes through SQLITE_CONFIG_MUTEX instead.
+*/
+struct sqlite3_mutex
+{
+	pthread_mutex_t mutex;
+	int id;
+};
+
+static sqlite3_mutex static_mutexes[SQLITE_MUTEX_STATIC_VFS3 - SQLITE_MUTEX_RECURSIVE];
+
+static int mutex_init(void)
+{
+	for (int i = 0; i < SQLITE_MUTEX_STATIC_VFS3 - SQLITE_MUTEX_RECURSIVE; i++)
+	{
+		pthread_mutex_init(&static_mutexes[i].mutex, NULL);
+		static_mutexes[i].id = i + SQLITE_MUTEX_STATIC_MAIN;
+	}
+	return SQLITE_OK;
+}
+
+static int mutex_end(void)
+{
+	return SQLITE_OK;
+}
+
+static sqlite3_mutex *mutex_alloc(int id)
+{
+	if (id > SQLITE_MUTEX_RECURSIVE)
+	{
+		if (id > SQLITE_MUTEX_STATIC_VFS3)
+		{
+			return NULL;
+		}
+		return &static_mutexes[id - SQLITE_MUTEX_STATIC_MAIN];
+	}
+	/* sqlite3_malloc() may need a mutex itself, use the libc allocator */
+	sqlite3_mutex *p = malloc(sizeof(sqlite3_mutex));
+	if (p == NULL)
+	{
+		return NULL;
+	}
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	if (id == SQLITE_MUTEX_RECURSIVE)
+	{
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	}
+	pthread_mutex_init(&p->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	p->id = id;
+	return p;
+}
+
+static void mutex_free(sqlite3_mutex *p)
+{
+	if (p->id <= SQLITE_MUTEX_RECURSIVE)
+	{
+		pthread_mutex_destroy(&p->mutex);
+		free(p);
+	}
+}
+
+static void mutex_enter(sqlite3_mutex *p)
+{
+	pthread_mutex_lock(&p->mutex);
+}
+
+static int mutex_try(sqlite3_mutex *p)
+{
+	return pthread_mutex_trylock(&p->mutex) == 0 ? SQLITE_OK : SQLITE_BUSY;
+}
+
+static void mutex_leave(sqlite3_mutex *p)
+{
+	pthread_mutex_unlock(&p->mutex);
+}
+
+static sqlite3_mutex_methods mutex_methods = {
+	mutex_init,
+	mutex_end,
+	mutex_alloc,
+	mutex_free,
+	mutex_enter,
+	mutex_try,
+	mutex_leave,
+	NULL,
+	NULL,
+};
+#endif
+
 typedef struct sqlite3_ext_file sqlite3_ext_file;
 struct sqlite3_ext_file
 {
@@ -20,9 +117,7 @@ struct sqlite3_ext_file
 static int io_close(sqlite3_file *pFile)
 {
 	sqlite3_ext_file *p = (sqlite3_ext_file *)pFile;
-	int rc = sqlite3_ext_io_close(p->vfsId, p->fileId);
-	sqlite3_free(p);
-	return rc;
+	return sqlite3_ext_io_close(p->vfsId, p->fileId);
 }
 
 static int io_read(sqlite3_file *pFile, void *pBuf, int iAmt, sqlite3_int64 iOfst)
@@ -112,37 +207,40 @@ static sqlite3_io_methods io_methods = {
 
 static int vfs_open(sqlite3_vfs *vfs, const char *zName, sqlite3_file *file, int flags, int *pOutFlags)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	int fileId = 0;
 	int rc = sqlite3_ext_vfs_open(id, zName, &fileId, flags, pOutFlags);
+	sqlite3_ext_file *ext = (sqlite3_ext_file *)file;
+	if (rc != SQLITE_OK)
+	{
+		ext->base.pMethods = NULL;
+		return rc;
+	}
 	if (fileId == 0) {
+		ext->base.pMethods = NULL;
 		return SQLITE_MISUSE;
 	}
-	if (rc == SQLITE_OK)
-	{
-		sqlite3_ext_file *ext = (sqlite3_ext_file *)file;
-		ext->base.pMethods = &io_methods;
-		ext->vfsId = id;
-		ext->fileId = fileId;
-	}
-	return rc;
+	ext->base.pMethods = &io_methods;
+	ext->vfsId = id;
+	ext->fileId = fileId;
+	return SQLITE_OK;
 }
 
 static int vfs_delete(sqlite3_vfs *vfs, const char *zName, int syncDir)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_delete(id, zName, syncDir);
 }
 
 static int vfs_access(sqlite3_vfs *vfs, const char *zName, int flags, int *pResOut)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_access(id, zName, flags, pResOut);
 }
 
 static int vfs_full_pathname(sqlite3_vfs *vfs, const char *zName, int nOut, char *zOut)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_full_pathname(id, zName, nOut, zOut);
 }
 
@@ -162,25 +260,25 @@ static void vfs_dlerror(sqlite3_vfs *vfs, int nByte, char *zErrMsg)
 
 static int vfs_randomness(sqlite3_vfs *vfs, int nByte, char *zOut)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_randomness(id, nByte, zOut);
 }
 
 static int vfs_sleep(sqlite3_vfs *vfs, int microseconds)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_sleep(id, microseconds);
 }
 
 static int vfs_current_time(sqlite3_vfs *vfs, double *pTimeOut)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_current_time(id, pTimeOut);
 }
 
 static int vfs_get_last_error(sqlite3_vfs *vfs, int nByte, char *zOut)
 {
-	int id = (int)vfs->pAppData;
+	int id = (int)(intptr_t)vfs->pAppData;
 	return sqlite3_ext_vfs_get_last_error(id, nByte, zOut);
 }
 
@@ -198,7 +296,71 @@ static int next_ext_vfs_id()
 
 static int exec_callback(void *pArg, int nCols, char **azCols, char **azColNames)
 {
-	return sqlite3_ext_exec_callback((int)pArg, nCols, azCols, azColNames);
+	return sqlite3_ext_exec_callback((int)(intptr_t)pArg, nCols, azCols, azColNames);
+}
+
+static int progress_callback(void *pArg)
+{
+	return sqlite3_ext_progress_callback((int)(intptr_t)pArg);
+}
+
+#if defined(SQLITE_EXT_MISC) || defined(SQLITE_EXT_SKETCH) || defined(SQLITE_EXT_VEC)
+/*
+** The ext/misc extensions of sqlite3misc.c, the approximate aggregates of
+** sqlite3sketch.c and the vector search of sqlite3vec.c, registered for every
+** connection since dynamic loading is left out.
+*/
+typedef int (*ext_misc_init)(sqlite3 *, char **, const sqlite3_api_routines *);
+
+int sqlite3_decimal_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+int sqlite3_percentile_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+int sqlite3_regexp_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+int sqlite3_series_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+int sqlite3_sketch_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+int sqlite3_vec_init(sqlite3 *db, char **pzErrMsg, const sqlite3_api_routines *pApi);
+
+static const ext_misc_init ext_misc[] = {
+#ifdef SQLITE_EXT_MISC
+	sqlite3_decimal_init,
+	sqlite3_percentile_init,
+	sqlite3_regexp_init,
+	sqlite3_series_init,
+#endif
+#ifdef SQLITE_EXT_SKETCH
+	sqlite3_sketch_init,
+#endif
+#ifdef SQLITE_EXT_VEC
+	sqlite3_vec_init,
+#endif
+};
+#endif
+
+int sqlite3_ext_init(void)
+{
+#if SQLITE_THREADSAFE && defined(_REENTRANT)
+	static int configured = 0;
+	if (!configured)
+	{
+		int rc = sqlite3_config(SQLITE_CONFIG_MUTEX, &mutex_methods);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+		configured = 1;
+	}
+#endif
+#if defined(SQLITE_EXT_MISC) || defined(SQLITE_EXT_SKETCH) || defined(SQLITE_EXT_VEC)
+	/* sqlite3_auto_extension ignores extensions that are already registered */
+	for (size_t i = 0; i < sizeof(ext_misc) / sizeof(ext_misc[0]); i++)
+	{
+		int rc = sqlite3_auto_extension((void (*)(void))ext_misc[i]);
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+#endif
+	return SQLITE_OK;
 }
 
 int sqlite3_ext_vfs_register(const char *name, int makeDflt, int *pOutVfsId)
@@ -235,7 +397,7 @@ int sqlite3_ext_vfs_register(const char *name, int makeDflt, int *pOutVfsId)
 	vfs->szOsFile = sizeof(sqlite3_ext_file);
 	vfs->mxPathname = 256;
 	vfs->zName = nameCopy;
-	vfs->pAppData = (void *)vfsId;
+	vfs->pAppData = (void *)(intptr_t)vfsId;
 	vfs->xOpen = vfs_open;
 	vfs->xDelete = vfs_delete;
 	vfs->xAccess = vfs_access;
@@ -253,7 +415,7 @@ int sqlite3_ext_vfs_register(const char *name, int makeDflt, int *pOutVfsId)
 
 	if (rc == SQLITE_OK)
 	{
-		*pOutVfsId = (int)vfs->pAppData;
+		*pOutVfsId = (int)(intptr_t)vfs->pAppData;
 		ext_vfs[vfsId] = vfs;
 		return SQLITE_OK;
 	}
@@ -292,5 +454,309 @@ int sqlite3_os_end()
 
 int sqlite3_ext_exec(sqlite3 *db, const char *sql, int id, char **errmsg)
 {
-	return sqlite3_exec(db, sql, exec_callback, (void *)id, errmsg);
+	return sqlite3_exec(db, sql, exec_callback, (void *)(intptr_t)id, errmsg);
+}
+
+void sqlite3_ext_progress_handler(sqlite3 *db, int nOps, int id)
+{
+	if (nOps <= 0)
+	{
+		sqlite3_progress_handler(db, 0, NULL, NULL);
+		return;
+	}
+	sqlite3_progress_handler(db, nOps, progress_callback, (void *)(intptr_t)id);
+}
+
+/*
+** Binds a buffer of sqlite3_malloc that SQLite frees, so a BLOB written into
+** the heap from JS is not copied again as with SQLITE_TRANSIENT. SQLite frees
+** it on failure as well.
+*/
+int sqlite3_ext_bind_blob_free(sqlite3_stmt *pStmt, int i, void *p, int n)
+{
+	return sqlite3_bind_blob(pStmt, i, p, n, sqlite3_free);
+}
+
+void ext_json_append_string(sqlite3_str *pOut, const unsigned char *z, int n)
+{
+	static const char hex[] = "0123456789abcdef";
+	int start = 0;
+	sqlite3_str_appendchar(pOut, 1, '"');
+	for (int i = 0; i < n; i++)
+	{
+		unsigned char c = z[i];
+		if (c >= 0x20 && c != '"' && c != '\\')
+		{
+			continue;
+		}
+		sqlite3_str_append(pOut, (const char *)z + start, i - start);
+		start = i + 1;
+		switch (c)
+		{
+		case '"':
+			sqlite3_str_append(pOut, "\\\"", 2);
+			break;
+		case '\\':
+			sqlite3_str_append(pOut, "\\\\", 2);
+			break;
+		case '\n':
+			sqlite3_str_append(pOut, "\\n", 2);
+			break;
+		case '\r':
+			sqlite3_str_append(pOut, "\\r", 2);
+			break;
+		case '\t':
+			sqlite3_str_append(pOut, "\\t", 2);
+			break;
+		default:
+			sqlite3_str_appendf(pOut, "\\u00%c%c", hex[c >> 4], hex[c & 0xf]);
+			break;
+		}
+	}
+	sqlite3_str_append(pOut, (const char *)z + start, n - start);
+	sqlite3_str_appendchar(pOut, 1, '"');
+}
+
+/*
+** Steps pStmt to the end and writes every row to one JSON text, an array of
+** objects keyed by column name, or of arrays with SQLITE_EXT_JSON_ARRAYS.
+** TEXT of columns declared JSON is copied as it is, so it must be valid
+** JSON. BLOBs have no JSON form and fail with SQLITE_MISMATCH, like
+** json_quote(). On success *pzOut is an sqlite3_malloc buffer of *pnOut bytes
+** without a terminator that the caller frees.
+*/
+int sqlite3_ext_stmt_json(sqlite3_stmt *pStmt, int flags, char **pzOut, int *pnOut)
+{
+	sqlite3_str *pOut = sqlite3_str_new(sqlite3_db_handle(pStmt));
+	int nCol = sqlite3_column_count(pStmt);
+	int rc;
+	*pzOut = NULL;
+	*pnOut = 0;
+	sqlite3_str_appendchar(pOut, 1, '[');
+	for (int nRow = 0; (rc = sqlite3_step(pStmt)) == SQLITE_ROW; nRow++)
+	{
+		sqlite3_str_appendall(pOut, nRow == 0 ? "" : ",");
+		sqlite3_str_appendchar(pOut, 1, flags & SQLITE_EXT_JSON_ARRAYS ? '[' : '{');
+		for (int i = 0; i < nCol; i++)
+		{
+			if (i > 0)
+			{
+				sqlite3_str_appendchar(pOut, 1, ',');
+			}
+			if (!(flags & SQLITE_EXT_JSON_ARRAYS))
+			{
+				const char *zName = sqlite3_column_name(pStmt, i);
+				ext_json_append_string(pOut, (const unsigned char *)zName, (int)strlen(zName));
+				sqlite3_str_appendchar(pOut, 1, ':');
+			}
+			switch (sqlite3_column_type(pStmt, i))
+			{
+			case SQLITE_INTEGER:
+				sqlite3_str_appendf(pOut, "%lld", sqlite3_column_int64(pStmt, i));
+				break;
+			case SQLITE_FLOAT:
+			{
+				/* the shortest of 15 or 17 digits that reads back as the same double */
+				char zNum[32];
+				double d = sqlite3_column_double(pStmt, i);
+				if (!isfinite(d))
+				{
+					sqlite3_str_appendall(pOut, "null");
+					break;
+				}
+				sqlite3_snprintf(sizeof(zNum), zNum, "%!.15g", d);
+				if (strtod(zNum, NULL) != d)
+				{
+					sqlite3_snprintf(sizeof(zNum), zNum, "%!.17g", d);
+				}
+				sqlite3_str_appendall(pOut, zNum);
+				break;
+			}
+			case SQLITE_TEXT:
+			{
+				const unsigned char *z = sqlite3_column_text(pStmt, i);
+				int n = sqlite3_column_bytes(pStmt, i);
+				const char *zType = sqlite3_column_decltype(pStmt, i);
+				if (zType != NULL && sqlite3_stricmp(zType, "JSON") == 0)
+				{
+					sqlite3_str_append(pOut, (const char *)z, n);
+				}
+				else
+				{
+					ext_json_append_string(pOut, z, n);
+				}
+				break;
+			}
+			case SQLITE_BLOB:
+				rc = SQLITE_MISMATCH;
+				break;
+			default:
+				sqlite3_str_appendall(pOut, "null");
+				break;
+			}
+		}
+		if (rc != SQLITE_ROW)
+		{
+			break;
+		}
+		sqlite3_str_appendchar(pOut, 1, flags & SQLITE_EXT_JSON_ARRAYS ? ']' : '}');
+	}
+	sqlite3_str_appendchar(pOut, 1, ']');
+	if (rc == SQLITE_DONE)
+	{
+		rc = sqlite3_str_errcode(pOut);
+	}
+	*pnOut = sqlite3_str_length(pOut);
+	*pzOut = sqlite3_str_finish(pOut);
+	if (rc != SQLITE_OK)
+	{
+		sqlite3_free(*pzOut);
+		*pzOut = NULL;
+		*pnOut = 0;
+	}
+	return rc;
+}
+
+#ifdef SQLITE_ENABLE_FTS5
+/*
+** FTS5 tokenizers implemented in JS, see src/fts5.ts. Each document or query
+** crosses into JS once: sqlite3_ext_fts5_tokenize returns every token of the
+** text in one sqlite3_malloc buffer of ints, the token count, then flags,
+** start, end and term length per token, then the UTF-8 terms back to back.
+*/
+typedef struct ext_tokenizer
+{
+	int id;
+} ext_tokenizer;
+
+static int tokenizer_create(void *pCtx, const char **azArg, int nArg, Fts5Tokenizer **ppOut)
+{
+	ext_tokenizer *tokenizer = sqlite3_malloc(sizeof(ext_tokenizer));
+	if (tokenizer == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+	tokenizer->id = (int)(intptr_t)pCtx;
+	*ppOut = (Fts5Tokenizer *)tokenizer;
+	return SQLITE_OK;
+}
+
+static void tokenizer_delete(Fts5Tokenizer *pTok)
+{
+	sqlite3_free(pTok);
 }
+
+static int tokenizer_tokenize(Fts5Tokenizer *pTok, void *pCtx, int flags, const char *pText, int nText,
+	int (*xToken)(void *, int, const char *, int, int, int))
+{
+	ext_tokenizer *tokenizer = (ext_tokenizer *)pTok;
+	int *aToken = NULL;
+	int rc = sqlite3_ext_fts5_tokenize(tokenizer->id, flags, pText, nText, &aToken);
+	if (rc != SQLITE_OK || aToken == NULL)
+	{
+		return rc;
+	}
+	int nToken = aToken[0];
+	const char *zTerm = (const char *)&aToken[1 + nToken * 4];
+	for (int i = 0; i < nToken && rc == SQLITE_OK; i++)
+	{
+		const int *token = &aToken[1 + i * 4];
+		rc = xToken(pCtx, token[0], zTerm, token[3], token[1], token[2]);
+		zTerm += token[3];
+	}
+	sqlite3_free(aToken);
+	return rc;
+}
+
+static fts5_api *fts5_api_from_db(sqlite3 *db)
+{
+	fts5_api *pApi = NULL;
+	sqlite3_stmt *pStmt = NULL;
+	if (sqlite3_prepare_v2(db, "SELECT fts5(?1)", -1, &pStmt, NULL) == SQLITE_OK)
+	{
+		sqlite3_bind_pointer(pStmt, 1, (void *)&pApi, "fts5_api_ptr", NULL);
+		sqlite3_step(pStmt);
+	}
+	sqlite3_finalize(pStmt);
+	return pApi;
+}
+
+int sqlite3_ext_fts5_tokenizer_register(sqlite3 *db, const char *zName, int id)
+{
+	static fts5_tokenizer methods = { tokenizer_create, tokenizer_delete, tokenizer_tokenize };
+	fts5_api *pApi = fts5_api_from_db(db);
+	if (pApi == NULL)
+	{
+		return SQLITE_ERROR;
+	}
+	return pApi->xCreateTokenizer(pApi, zName, (void *)(intptr_t)id, &methods, NULL);
+}
+#endif
+
+#ifdef SQLITE_ENABLE_RTREE
+/*
+** Bulk load of an R*Tree table, see src/rtree.ts. aRow holds nRow rows of
+** nCol doubles, the id and then the minimum and maximum of each dimension,
+** so the whole buffer crosses from JS once and every row goes through one
+** prepared statement. The caller wraps it in a savepoint. An id that is not
+** an integer in the range of sqlite3_int64 fails with SQLITE_MISMATCH.
+*/
+int sqlite3_ext_rtree_load(sqlite3 *db, const char *zTable, int nCol, int nRow, const double *aRow)
+{
+	sqlite3_str *pSql = sqlite3_str_new(db);
+	sqlite3_str_appendf(pSql, "INSERT INTO \"%w\" VALUES (?", zTable);
+	for (int i = 1; i < nCol; i++)
+	{
+		sqlite3_str_appendall(pSql, ", ?");
+	}
+	sqlite3_str_appendchar(pSql, 1, ')');
+	char *zSql = sqlite3_str_finish(pSql);
+	if (zSql == NULL)
+	{
+		return SQLITE_NOMEM;
+	}
+
+	sqlite3_stmt *pStmt = NULL;
+	int rc = sqlite3_prepare_v2(db, zSql, -1, &pStmt, NULL);
+	sqlite3_free(zSql);
+	for (int i = 0; rc == SQLITE_OK && i < nRow; i++)
+	{
+		const double *aCol = aRow + (size_t)i * nCol;
+		/* NaN fails both comparisons, the cast is only defined inside the range */
+		if (!(aCol[0] >= -9223372036854775808.0 && aCol[0] < 9223372036854775808.0)
+			|| (double)(sqlite3_int64)aCol[0] != aCol[0])
+		{
+			rc = SQLITE_MISMATCH;
+			break;
+		}
+		sqlite3_bind_int64(pStmt, 1, (sqlite3_int64)aCol[0]);
+		for (int j = 1; j < nCol; j++)
+		{
+			sqlite3_bind_double(pStmt, j + 1, aCol[j]);
+		}
+		sqlite3_step(pStmt);
+		rc = sqlite3_reset(pStmt);
+	}
+	/* keeps the error of the failed row for sqlite3_errmsg */
+	if (rc == SQLITE_OK)
+	{
+		rc = sqlite3_finalize(pStmt);
+	}
+	else
+	{
+		sqlite3_finalize(pStmt);
+	}
+	return rc;
+}
+#endif
+
+#ifdef __wasm64__
+/*
+** Marks memory64 builds, whose imports and exports take pointers as i64. The
+** JS side looks for this export before instantiating, see src/memory64.ts.
+*/
+SQLITE_EXTRA_API int sqlite3_ext_memory64(void)
+{
+	return (int)sizeof(void *);
+}
+#endif
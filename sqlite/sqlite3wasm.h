@@ -17,6 +17,9 @@ SQLITE_IMPORTED_API int sqlite3_ext_os_end(void);
 __attribute__((import_module("imports"),import_name("sqlite3_ext_exec_callback")))
 SQLITE_IMPORTED_API int sqlite3_ext_exec_callback(int id, int nCols, char** azCols, char** azColNames);
 
+__attribute__((import_module("imports"),import_name("sqlite3_ext_progress_callback")))
+SQLITE_IMPORTED_API int sqlite3_ext_progress_callback(int id);
+
 __attribute__((import_module("imports"),import_name("sqlite3_ext_io_close")))
 SQLITE_IMPORTED_API int sqlite3_ext_io_close(int vfsId, int fileId);
 
@@ -77,8 +80,29 @@ SQLITE_IMPORTED_API int sqlite3_ext_vfs_current_time(int id, double *pTimeOut);
 __attribute__((import_module("imports"),import_name("sqlite3_ext_vfs_get_last_error")))
 SQLITE_IMPORTED_API int sqlite3_ext_vfs_get_last_error(int id, int nByte, char *zOut);
 
+__attribute__((import_module("imports"),import_name("sqlite3_ext_fts5_tokenize")))
+SQLITE_IMPORTED_API int sqlite3_ext_fts5_tokenize(int id, int flags, const char *pText, int nText, int **ppOut);
+
+SQLITE_EXTRA_API int sqlite3_ext_init(void);
+
 SQLITE_EXTRA_API int sqlite3_ext_vfs_register(const char *name, int makeDflt, int *pOutVfsId);
 
 SQLITE_EXTRA_API int sqlite3_ext_vfs_unregister(int vfsId);
 
 SQLITE_EXTRA_API int sqlite3_ext_exec(sqlite3 *db, const char *sql, int id, char **errmsg);
+
+SQLITE_EXTRA_API void sqlite3_ext_progress_handler(sqlite3 *db, int nOps, int id);
+
+SQLITE_EXTRA_API int sqlite3_ext_bind_blob_free(sqlite3_stmt *pStmt, int i, void *p, int n);
+
+/* sqlite3_ext_stmt_json writes rows as arrays instead of objects */
+#define SQLITE_EXT_JSON_ARRAYS 0x0001
+
+SQLITE_EXTRA_API int sqlite3_ext_stmt_json(sqlite3_stmt *pStmt, int flags, char **pzOut, int *pnOut);
+
+/* appends z as a JSON string, shared with sqlite3sketch.c and not exported */
+void ext_json_append_string(sqlite3_str *pOut, const unsigned char *z, int n);
+
+SQLITE_EXTRA_API int sqlite3_ext_fts5_tokenizer_register(sqlite3 *db, const char *zName, int id);
+
+SQLITE_EXTRA_API int sqlite3_ext_rtree_load(sqlite3 *db, const char *zTable, int nCol, int nRow, const double *aRow);
@@ -7,6 +7,11 @@ export type CFunctionPointer = number;
 export type CFloat = number;
 export type CDouble = number;
 
+// memory64 builds pass pointers and size_t as i64, see src/memory64.ts
+export type CPointer64 = bigint;
+export type CString64 = bigint;
+export type CFunctionPointer64 = bigint;
+
 
 export interface SQLiteExports extends WebAssembly.Exports {
 	sqlite3_libversion: () => CPointer;
@@ -307,9 +312,15 @@ export interface SQLiteExports extends WebAssembly.Exports {
 	sqlite3changegroup_output_strm: (a: CPointer, xOutput: CFunctionPointer, pOut: CPointer) => CInteger;
 	sqlite3rebaser_rebase_strm: (pRebaser: CPointer, xInput: CFunctionPointer, pIn: CPointer, xOutput: CFunctionPointer, pOut: CPointer) => CInteger;
 	sqlite3session_config: (op: CInteger, pArg: CPointer) => CInteger;
+	sqlite3_ext_init: () => CInteger;
 	sqlite3_ext_vfs_register: (name: CString, makeDflt: CInteger, pOutVfsId: CPointer) => CInteger;
 	sqlite3_ext_vfs_unregister: (vfsId: CInteger) => CInteger;
 	sqlite3_ext_exec: (db: CPointer, sql: CString, id: CInteger, d: CPointer) => CInteger;
+	sqlite3_ext_progress_handler: (db: CPointer, nOps: CInteger, id: CInteger) => void;
+	sqlite3_ext_bind_blob_free: (pStmt: CPointer, i: CInteger, p: CPointer, n: CInteger) => CInteger;
+	sqlite3_ext_stmt_json: (pStmt: CPointer, flags: CInteger, c: CPointer, pnOut: CPointer) => CInteger;
+	sqlite3_ext_fts5_tokenizer_register: (db: CPointer, zName: CString, id: CInteger) => CInteger;
+	sqlite3_ext_rtree_load: (db: CPointer, zTable: CString, nCol: CInteger, nRow: CInteger, aRow: CPointer) => CInteger;
 
 	memory: WebAssembly.Memory;
 }
@@ -318,6 +329,7 @@ export interface SQLiteImports {
 	sqlite3_ext_os_init: () => CInteger;
 	sqlite3_ext_os_end: () => CInteger;
 	sqlite3_ext_exec_callback: (id: CInteger, nCols: CInteger, azCols: CPointer, azColNames: CPointer) => CInteger;
+	sqlite3_ext_progress_callback: (id: CInteger) => CInteger;
 	sqlite3_ext_io_close: (vfsId: CInteger, fileId: CInteger) => CInteger;
 	sqlite3_ext_io_read: (vfsId: CInteger, fileId: CInteger, pBuf: CPointer, iAmt: CInteger, iOfst: CInteger) => CInteger;
 	sqlite3_ext_io_write: (vfsId: CInteger, fileId: CInteger, pBuf: CPointer, iAmt: CInteger, iOfst: CInteger) => CInteger;
@@ -338,8 +350,686 @@ export interface SQLiteImports {
 	sqlite3_ext_vfs_sleep: (id: CInteger, microseconds: CInteger) => CInteger;
 	sqlite3_ext_vfs_current_time: (id: CInteger, pTimeOut: CPointer) => CInteger;
 	sqlite3_ext_vfs_get_last_error: (id: CInteger, nByte: CInteger, zOut: CPointer) => CInteger;
+	sqlite3_ext_fts5_tokenize: (id: CInteger, flags: CInteger, pText: CString, nText: CInteger, e: CPointer) => CInteger;
 }
 
+export interface SQLiteExports64 extends WebAssembly.Exports {
+	sqlite3_libversion: () => CPointer64;
+	sqlite3_sourceid: () => CString64;
+	sqlite3_libversion_number: () => CInteger;
+	sqlite3_compileoption_used: (zOptName: CString64) => CInteger;
+	sqlite3_compileoption_get: (N: CInteger) => CString64;
+	sqlite3_threadsafe: () => CInteger;
+	sqlite3_close: (a: CPointer64) => CInteger;
+	sqlite3_close_v2: (a: CPointer64) => CInteger;
+	sqlite3_exec: (a: CPointer64, sql: CString64, callback: CFunctionPointer64, d: CPointer64, e: CPointer64) => CInteger;
+	sqlite3_initialize: () => CInteger;
+	sqlite3_shutdown: () => CInteger;
+	sqlite3_os_init: () => CInteger;
+	sqlite3_os_end: () => CInteger;
+	sqlite3_config: (a: CInteger, b: CPointer64) => CInteger;
+	sqlite3_db_config: (a: CPointer64, op: CInteger, c: CPointer64) => CInteger;
+	sqlite3_extended_result_codes: (a: CPointer64, onoff: CInteger) => CInteger;
+	sqlite3_last_insert_rowid: (a: CPointer64) => CInteger64;
+	sqlite3_set_last_insert_rowid: (a: CPointer64, b: CInteger64) => void;
+	sqlite3_changes: (a: CPointer64) => CInteger;
+	sqlite3_changes64: (a: CPointer64) => CInteger64;
+	sqlite3_total_changes: (a: CPointer64) => CInteger;
+	sqlite3_total_changes64: (a: CPointer64) => CInteger64;
+	sqlite3_interrupt: (a: CPointer64) => void;
+	sqlite3_complete: (sql: CString64) => CInteger;
+	sqlite3_busy_handler: (a: CPointer64, b: CFunctionPointer64, c: CPointer64) => CInteger;
+	sqlite3_busy_timeout: (a: CPointer64, ms: CInteger) => CInteger;
+	sqlite3_get_table: (db: CPointer64, zSql: CString64, c: CPointer64, pnRow: CPointer64, pnColumn: CPointer64, f: CPointer64) => CInteger;
+	sqlite3_free_table: (a: CPointer64) => void;
+	sqlite3_mprintf: (a: CString64, b: CPointer64) => CPointer64;
+	sqlite3_vmprintf: (a: CString64, b: CPointer64) => CPointer64;
+	sqlite3_snprintf: (a: CInteger, b: CPointer64, c: CString64, d: CPointer64) => CPointer64;
+	sqlite3_vsnprintf: (a: CInteger, b: CPointer64, c: CString64, d: CPointer64) => CPointer64;
+	sqlite3_malloc: (a: CInteger) => CPointer64;
+	sqlite3_malloc64: (a: CInteger64) => CPointer64;
+	sqlite3_realloc: (a: CPointer64, b: CInteger) => CPointer64;
+	sqlite3_realloc64: (a: CPointer64, b: CInteger64) => CPointer64;
+	sqlite3_free: (a: CPointer64) => void;
+	sqlite3_msize: (a: CPointer64) => CInteger64;
+	sqlite3_memory_used: () => CInteger64;
+	sqlite3_memory_highwater: (resetFlag: CInteger) => CInteger64;
+	sqlite3_randomness: (N: CInteger, P: CPointer64) => void;
+	sqlite3_set_authorizer: (a: CPointer64, xAuth: CFunctionPointer64, pUserData: CPointer64) => CInteger;
+	sqlite3_trace_v2: (a: CPointer64, uMask: unknown, xCallback: CFunctionPointer64, pCtx: CPointer64) => CInteger;
+	sqlite3_progress_handler: (a: CPointer64, b: CInteger, c: CFunctionPointer64, d: CPointer64) => void;
+	sqlite3_open: (filename: CString64, b: CPointer64) => CInteger;
+	sqlite3_open_v2: (filename: CString64, b: CPointer64, flags: CInteger, zVfs: CString64) => CInteger;
+	sqlite3_uri_parameter: (zFilename: CString64, zParam: CString64) => CString64;
+	sqlite3_uri_boolean: (zFile: CString64, zParam: CString64, bDefault: CInteger) => CInteger;
+	sqlite3_uri_int64: (a: CString64, b: CString64, c: CInteger64) => CInteger64;
+	sqlite3_uri_key: (zFilename: CString64, N: CInteger) => CString64;
+	sqlite3_filename_database: (a: CString64) => CString64;
+	sqlite3_filename_journal: (a: CString64) => CString64;
+	sqlite3_filename_wal: (a: CString64) => CString64;
+	sqlite3_database_file_object: (a: CString64) => CPointer64;
+	sqlite3_create_filename: (zDatabase: CString64, zJournal: CString64, zWal: CString64, nParam: CInteger, e: CPointer64) => CPointer64;
+	sqlite3_free_filename: (a: CPointer64) => void;
+	sqlite3_errcode: (db: CPointer64) => CInteger;
+	sqlite3_extended_errcode: (db: CPointer64) => CInteger;
+	sqlite3_errmsg: (a: CPointer64) => CString64;
+	sqlite3_errstr: (a: CInteger) => CString64;
+	sqlite3_limit: (a: CPointer64, id: CInteger, newVal: CInteger) => CInteger;
+	sqlite3_prepare: (db: CPointer64, zSql: CString64, nByte: CInteger, d: CPointer64, e: CPointer64) => CInteger;
+	sqlite3_prepare_v2: (db: CPointer64, zSql: CString64, nByte: CInteger, d: CPointer64, e: CPointer64) => CInteger;
+	sqlite3_prepare_v3: (db: CPointer64, zSql: CString64, nByte: CInteger, prepFlags: CInteger, e: CPointer64, f: CPointer64) => CInteger;
+	sqlite3_sql: (pStmt: CPointer64) => CString64;
+	sqlite3_expanded_sql: (pStmt: CPointer64) => CPointer64;
+	sqlite3_normalized_sql: (pStmt: CPointer64) => CString64;
+	sqlite3_stmt_readonly: (pStmt: CPointer64) => CInteger;
+	sqlite3_stmt_isexplain: (pStmt: CPointer64) => CInteger;
+	sqlite3_stmt_busy: (a: CPointer64) => CInteger;
+	sqlite3_bind_blob: (a: CPointer64, b: CInteger, c: CPointer64, n: CInteger, e: CFunctionPointer64) => CInteger;
+	sqlite3_bind_blob64: (a: CPointer64, b: CInteger, c: CPointer64, d: CInteger64, e: CFunctionPointer64) => CInteger;
+	sqlite3_bind_double: (a: CPointer64, b: CInteger, c: CDouble) => CInteger;
+	sqlite3_bind_int: (a: CPointer64, b: CInteger, c: CInteger) => CInteger;
+	sqlite3_bind_int64: (a: CPointer64, b: CInteger, c: CInteger64) => CInteger;
+	sqlite3_bind_null: (a: CPointer64, b: CInteger) => CInteger;
+	sqlite3_bind_text: (a: CPointer64, b: CInteger, c: CString64, d: CInteger, e: CFunctionPointer64) => CInteger;
+	sqlite3_bind_text64: (a: CPointer64, b: CInteger, c: CString64, d: CInteger64, e: CFunctionPointer64, encoding: unknown) => CInteger;
+	sqlite3_bind_value: (a: CPointer64, b: CInteger, c: CPointer64) => CInteger;
+	sqlite3_bind_pointer: (a: CPointer64, b: CInteger, c: CPointer64, d: CString64, e: CFunctionPointer64) => CInteger;
+	sqlite3_bind_zeroblob: (a: CPointer64, b: CInteger, n: CInteger) => CInteger;
+	sqlite3_bind_zeroblob64: (a: CPointer64, b: CInteger, c: CInteger64) => CInteger;
+	sqlite3_bind_parameter_count: (a: CPointer64) => CInteger;
+	sqlite3_bind_parameter_name: (a: CPointer64, b: CInteger) => CString64;
+	sqlite3_bind_parameter_index: (a: CPointer64, zName: CString64) => CInteger;
+	sqlite3_clear_bindings: (a: CPointer64) => CInteger;
+	sqlite3_column_count: (pStmt: CPointer64) => CInteger;
+	sqlite3_column_name: (a: CPointer64, N: CInteger) => CString64;
+	sqlite3_column_database_name: (a: CPointer64, b: CInteger) => CString64;
+	sqlite3_column_table_name: (a: CPointer64, b: CInteger) => CString64;
+	sqlite3_column_origin_name: (a: CPointer64, b: CInteger) => CString64;
+	sqlite3_column_decltype: (a: CPointer64, b: CInteger) => CString64;
+	sqlite3_step: (a: CPointer64) => CInteger;
+	sqlite3_data_count: (pStmt: CPointer64) => CInteger;
+	sqlite3_column_blob: (a: CPointer64, iCol: CInteger) => CPointer64;
+	sqlite3_column_double: (a: CPointer64, iCol: CInteger) => CDouble;
+	sqlite3_column_int: (a: CPointer64, iCol: CInteger) => CInteger;
+	sqlite3_column_int64: (a: CPointer64, iCol: CInteger) => CInteger64;
+	sqlite3_column_text: (a: CPointer64, iCol: CInteger) => CPointer64;
+	sqlite3_column_value: (a: CPointer64, iCol: CInteger) => CPointer64;
+	sqlite3_column_bytes: (a: CPointer64, iCol: CInteger) => CInteger;
+	sqlite3_column_type: (a: CPointer64, iCol: CInteger) => CInteger;
+	sqlite3_finalize: (pStmt: CPointer64) => CInteger;
+	sqlite3_reset: (pStmt: CPointer64) => CInteger;
+	sqlite3_create_function: (db: CPointer64, zFunctionName: CString64, nArg: CInteger, eTextRep: CInteger, pApp: CPointer64, xFunc: CFunctionPointer64, xStep: CFunctionPointer64, xFinal: CFunctionPointer64) => CInteger;
+	sqlite3_create_function_v2: (db: CPointer64, zFunctionName: CString64, nArg: CInteger, eTextRep: CInteger, pApp: CPointer64, xFunc: CFunctionPointer64, xStep: CFunctionPointer64, xFinal: CFunctionPointer64, xDestroy: CFunctionPointer64) => CInteger;
+	sqlite3_create_window_function: (db: CPointer64, zFunctionName: CString64, nArg: CInteger, eTextRep: CInteger, pApp: CPointer64, xStep: CFunctionPointer64, xFinal: CFunctionPointer64, xValue: CFunctionPointer64, xInverse: CFunctionPointer64, xDestroy: CFunctionPointer64) => CInteger;
+	sqlite3_value_blob: (a: CPointer64) => CPointer64;
+	sqlite3_value_double: (a: CPointer64) => CDouble;
+	sqlite3_value_int: (a: CPointer64) => CInteger;
+	sqlite3_value_int64: (a: CPointer64) => CInteger64;
+	sqlite3_value_pointer: (a: CPointer64, b: CString64) => CPointer64;
+	sqlite3_value_text: (a: CPointer64) => CPointer64;
+	sqlite3_value_bytes: (a: CPointer64) => CInteger;
+	sqlite3_value_type: (a: CPointer64) => CInteger;
+	sqlite3_value_numeric_type: (a: CPointer64) => CInteger;
+	sqlite3_value_nochange: (a: CPointer64) => CInteger;
+	sqlite3_value_frombind: (a: CPointer64) => CInteger;
+	sqlite3_value_subtype: (a: CPointer64) => CInteger;
+	sqlite3_value_dup: (a: CPointer64) => CPointer64;
+	sqlite3_value_free: (a: CPointer64) => void;
+	sqlite3_aggregate_context: (a: CPointer64, nBytes: CInteger) => CPointer64;
+	sqlite3_user_data: (a: CPointer64) => CPointer64;
+	sqlite3_context_db_handle: (a: CPointer64) => CPointer64;
+	sqlite3_get_auxdata: (a: CPointer64, N: CInteger) => CPointer64;
+	sqlite3_set_auxdata: (a: CPointer64, N: CInteger, c: CPointer64, d: CFunctionPointer64) => void;
+	sqlite3_result_blob: (a: CPointer64, b: CPointer64, c: CInteger, d: CFunctionPointer64) => void;
+	sqlite3_result_blob64: (a: CPointer64, b: CPointer64, c: CInteger64, d: CFunctionPointer64) => void;
+	sqlite3_result_double: (a: CPointer64, b: CDouble) => void;
+	sqlite3_result_error: (a: CPointer64, b: CString64, c: CInteger) => void;
+	sqlite3_result_error_toobig: (a: CPointer64) => void;
+	sqlite3_result_error_nomem: (a: CPointer64) => void;
+	sqlite3_result_error_code: (a: CPointer64, b: CInteger) => void;
+	sqlite3_result_int: (a: CPointer64, b: CInteger) => void;
+	sqlite3_result_int64: (a: CPointer64, b: CInteger64) => void;
+	sqlite3_result_null: (a: CPointer64) => void;
+	sqlite3_result_text: (a: CPointer64, b: CString64, c: CInteger, d: CFunctionPointer64) => void;
+	sqlite3_result_text64: (a: CPointer64, b: CString64, c: CInteger64, d: CFunctionPointer64, encoding: unknown) => void;
+	sqlite3_result_value: (a: CPointer64, b: CPointer64) => void;
+	sqlite3_result_pointer: (a: CPointer64, b: CPointer64, c: CString64, d: CFunctionPointer64) => void;
+	sqlite3_result_zeroblob: (a: CPointer64, n: CInteger) => void;
+	sqlite3_result_zeroblob64: (a: CPointer64, n: CInteger64) => CInteger;
+	sqlite3_result_subtype: (a: CPointer64, int: CInteger) => void;
+	sqlite3_create_collation: (a: CPointer64, zName: CString64, eTextRep: CInteger, pArg: CPointer64, xCompare: CFunctionPointer64) => CInteger;
+	sqlite3_create_collation_v2: (a: CPointer64, zName: CString64, eTextRep: CInteger, pArg: CPointer64, xCompare: CFunctionPointer64, xDestroy: CFunctionPointer64) => CInteger;
+	sqlite3_collation_needed: (a: CPointer64, b: CPointer64, c: CFunctionPointer64) => CInteger;
+	sqlite3_activate_cerod: (zPassPhrase: CString64) => void;
+	sqlite3_sleep: (a: CInteger) => CInteger;
+	sqlite3_win32_set_directory: (type: unknown, zValue: CPointer64) => CPointer64;
+	sqlite3_win32_set_directory8: (type: unknown, zValue: CString64) => CInteger;
+	sqlite3_get_autocommit: (a: CPointer64) => CInteger;
+	sqlite3_db_handle: (a: CPointer64) => CPointer64;
+	sqlite3_db_filename: (db: CPointer64, zDbName: CString64) => CString64;
+	sqlite3_db_readonly: (db: CPointer64, zDbName: CString64) => CInteger;
+	sqlite3_txn_state: (a: CPointer64, zSchema: CString64) => CInteger;
+	sqlite3_next_stmt: (pDb: CPointer64, pStmt: CPointer64) => CPointer64;
+	sqlite3_commit_hook: (a: CPointer64, b: CFunctionPointer64, c: CPointer64) => CPointer64;
+	sqlite3_rollback_hook: (a: CPointer64, b: CFunctionPointer64, c: CPointer64) => CPointer64;
+	sqlite3_autovacuum_pages: (db: CPointer64, b: CFunctionPointer64, c: CPointer64, d: CFunctionPointer64) => CInteger;
+	sqlite3_update_hook: (a: CPointer64, b: CFunctionPointer64, c: CPointer64) => CPointer64;
+	sqlite3_enable_shared_cache: (a: CInteger) => CInteger;
+	sqlite3_release_memory: (a: CInteger) => CInteger;
+	sqlite3_db_release_memory: (a: CPointer64) => CInteger;
+	sqlite3_soft_heap_limit64: (N: CInteger64) => CInteger64;
+	sqlite3_hard_heap_limit64: (N: CInteger64) => CInteger64;
+	sqlite3_table_column_metadata: (db: CPointer64, zDbName: CString64, zTableName: CString64, zColumnName: CString64, e: CPointer64, f: CPointer64, pNotNull: CPointer64, pPrimaryKey: CPointer64, pAutoinc: CPointer64) => CInteger;
+	sqlite3_load_extension: (db: CPointer64, zFile: CString64, zProc: CString64, d: CPointer64) => CInteger;
+	sqlite3_enable_load_extension: (db: CPointer64, onoff: CInteger) => CInteger;
+	sqlite3_auto_extension: (xEntryPoint: CFunctionPointer64) => CInteger;
+	sqlite3_cancel_auto_extension: (xEntryPoint: CFunctionPointer64) => CInteger;
+	sqlite3_reset_auto_extension: () => void;
+	sqlite3_create_module: (db: CPointer64, zName: CString64, p: CPointer64, pClientData: CPointer64) => CInteger;
+	sqlite3_create_module_v2: (db: CPointer64, zName: CString64, p: CPointer64, pClientData: CPointer64, xDestroy: CFunctionPointer64) => CInteger;
+	sqlite3_drop_modules: (db: CPointer64, b: CPointer64) => CInteger;
+	sqlite3_declare_vtab: (a: CPointer64, zSQL: CString64) => CInteger;
+	sqlite3_overload_function: (a: CPointer64, zFuncName: CString64, nArg: CInteger) => CInteger;
+	sqlite3_blob_open: (a: CPointer64, zDb: CString64, zTable: CString64, zColumn: CString64, iRow: CInteger64, flags: CInteger, g: CPointer64) => CInteger;
+	sqlite3_blob_reopen: (a: CPointer64, b: CInteger64) => CInteger;
+	sqlite3_blob_close: (a: CPointer64) => CInteger;
+	sqlite3_blob_bytes: (a: CPointer64) => CInteger;
+	sqlite3_blob_read: (a: CPointer64, Z: CPointer64, N: CInteger, iOffset: CInteger) => CInteger;
+	sqlite3_blob_write: (a: CPointer64, z: CPointer64, n: CInteger, iOffset: CInteger) => CInteger;
+	sqlite3_vfs_find: (zVfsName: CString64) => CPointer64;
+	sqlite3_vfs_register: (a: CPointer64, makeDflt: CInteger) => CInteger;
+	sqlite3_vfs_unregister: (a: CPointer64) => CInteger;
+	sqlite3_mutex_alloc: (a: CInteger) => CPointer64;
+	sqlite3_mutex_free: (a: CPointer64) => void;
+	sqlite3_mutex_enter: (a: CPointer64) => void;
+	sqlite3_mutex_try: (a: CPointer64) => CInteger;
+	sqlite3_mutex_leave: (a: CPointer64) => void;
+	sqlite3_mutex_held: (a: CPointer64) => CInteger;
+	sqlite3_mutex_notheld: (a: CPointer64) => CInteger;
+	sqlite3_db_mutex: (a: CPointer64) => CPointer64;
+	sqlite3_file_control: (a: CPointer64, zDbName: CString64, op: CInteger, d: CPointer64) => CInteger;
+	sqlite3_test_control: (op: CInteger, b: CPointer64) => CInteger;
+	sqlite3_keyword_count: () => CInteger;
+	sqlite3_keyword_name: (a: CInteger, b: CPointer64, c: CPointer64) => CInteger;
+	sqlite3_keyword_check: (a: CString64, b: CInteger) => CInteger;
+	sqlite3_str_new: (a: CPointer64) => CPointer64;
+	sqlite3_str_finish: (a: CPointer64) => CPointer64;
+	sqlite3_str_appendf: (a: CPointer64, zFormat: CString64, c: CPointer64) => void;
+	sqlite3_str_vappendf: (a: CPointer64, zFormat: CString64, c: CPointer64) => void;
+	sqlite3_str_append: (a: CPointer64, zIn: CString64, N: CInteger) => void;
+	sqlite3_str_appendall: (a: CPointer64, zIn: CString64) => void;
+	sqlite3_str_appendchar: (a: CPointer64, N: CInteger, C: unknown) => void;
+	sqlite3_str_reset: (a: CPointer64) => void;
+	sqlite3_str_errcode: (a: CPointer64) => CInteger;
+	sqlite3_str_length: (a: CPointer64) => CInteger;
+	sqlite3_str_value: (a: CPointer64) => CPointer64;
+	sqlite3_status: (op: CInteger, pCurrent: CPointer64, pHighwater: CPointer64, resetFlag: CInteger) => CInteger;
+	sqlite3_status64: (op: CInteger, pCurrent: CPointer64, pHighwater: CPointer64, resetFlag: CInteger) => CInteger;
+	sqlite3_db_status: (a: CPointer64, op: CInteger, pCur: CPointer64, pHiwtr: CPointer64, resetFlg: CInteger) => CInteger;
+	sqlite3_stmt_status: (a: CPointer64, op: CInteger, resetFlg: CInteger) => CInteger;
+	sqlite3_backup_init: (pDest: CPointer64, zDestName: CString64, pSource: CPointer64, zSourceName: CString64) => CPointer64;
+	sqlite3_backup_step: (p: CPointer64, nPage: CInteger) => CInteger;
+	sqlite3_backup_finish: (p: CPointer64) => CInteger;
+	sqlite3_backup_remaining: (p: CPointer64) => CInteger;
+	sqlite3_backup_pagecount: (p: CPointer64) => CInteger;
+	sqlite3_unlock_notify: (pBlocked: CPointer64, xNotify: CFunctionPointer64, pNotifyArg: CPointer64) => CInteger;
+	sqlite3_stricmp: (a: CString64, b: CString64) => CInteger;
+	sqlite3_strnicmp: (a: CString64, b: CString64, c: CInteger) => CInteger;
+	sqlite3_strglob: (zGlob: CString64, zStr: CString64) => CInteger;
+	sqlite3_strlike: (zGlob: CString64, zStr: CString64, cEsc: CInteger) => CInteger;
+	sqlite3_log: (iErrCode: CInteger, zFormat: CString64, c: CPointer64) => void;
+	sqlite3_wal_hook: (a: CPointer64, b: CFunctionPointer64, c: CPointer64) => CPointer64;
+	sqlite3_wal_autocheckpoint: (db: CPointer64, N: CInteger) => CInteger;
+	sqlite3_wal_checkpoint: (db: CPointer64, zDb: CString64) => CInteger;
+	sqlite3_wal_checkpoint_v2: (db: CPointer64, zDb: CString64, eMode: CInteger, pnLog: CPointer64, pnCkpt: CPointer64) => CInteger;
+	sqlite3_vtab_config: (a: CPointer64, op: CInteger, c: CPointer64) => CInteger;
+	sqlite3_vtab_on_conflict: (a: CPointer64) => CInteger;
+	sqlite3_vtab_nochange: (a: CPointer64) => CInteger;
+	sqlite3_vtab_collation: (a: CPointer64, b: CInteger) => CPointer64;
+	sqlite3_stmt_scanstatus: (pStmt: CPointer64, idx: CInteger, iScanStatusOp: CInteger, pOut: CPointer64) => CInteger;
+	sqlite3_stmt_scanstatus_reset: (a: CPointer64) => void;
+	sqlite3_db_cacheflush: (a: CPointer64) => CInteger;
+	sqlite3_preupdate_hook: (db: CPointer64, xPreUpdate: CFunctionPointer64, c: CPointer64) => CPointer64;
+	sqlite3_preupdate_old: (a: CPointer64, b: CInteger, c: CPointer64) => CInteger;
+	sqlite3_preupdate_count: (a: CPointer64) => CInteger;
+	sqlite3_preupdate_depth: (a: CPointer64) => CInteger;
+	sqlite3_preupdate_new: (a: CPointer64, b: CInteger, c: CPointer64) => CInteger;
+	sqlite3_preupdate_blobwrite: (a: CPointer64) => CInteger;
+	sqlite3_system_errno: (a: CPointer64) => CInteger;
+	sqlite3_snapshot_get: (db: CPointer64, zSchema: CString64, c: CPointer64) => CInteger;
+	sqlite3_snapshot_open: (db: CPointer64, zSchema: CString64, pSnapshot: CPointer64) => CInteger;
+	sqlite3_snapshot_free: (a: CPointer64) => unknown;
+	sqlite3_snapshot_cmp: (p1: CPointer64, p2: CPointer64) => CInteger;
+	sqlite3_snapshot_recover: (db: CPointer64, zDb: CString64) => CInteger;
+	sqlite3_serialize: (db: CPointer64, zSchema: CString64, piSize: CPointer64, mFlags: CInteger) => CPointer64;
+	sqlite3_deserialize: (db: CPointer64, zSchema: CString64, pData: CPointer64, szDb: CInteger64, szBuf: CInteger64, mFlags: unknown) => CInteger;
+	sqlite3_rtree_geometry_callback: (db: CPointer64, zGeom: CString64, xGeom: CFunctionPointer64, pContext: CPointer64) => CInteger;
+	sqlite3_rtree_query_callback: (db: CPointer64, zQueryFunc: CString64, xQueryFunc: CFunctionPointer64, pContext: CPointer64, xDestructor: CFunctionPointer64) => CInteger;
+	sqlite3session_create: (db: CPointer64, zDb: CString64, c: CPointer64) => CInteger;
+	sqlite3session_delete: (pSession: CPointer64) => void;
+	sqlite3session_object_config: (a: CPointer64, op: CInteger, pArg: CPointer64) => CInteger;
+	sqlite3session_enable: (pSession: CPointer64, bEnable: CInteger) => CInteger;
+	sqlite3session_indirect: (pSession: CPointer64, bIndirect: CInteger) => CInteger;
+	sqlite3session_attach: (pSession: CPointer64, zTab: CString64) => CInteger;
+	sqlite3session_table_filter: (pSession: CPointer64, xFilter: CFunctionPointer64, pCtx: CPointer64) => void;
+	sqlite3session_changeset: (pSession: CPointer64, pnChangeset: CPointer64, c: CPointer64) => CInteger;
+	sqlite3session_changeset_size: (pSession: CPointer64) => CInteger64;
+	sqlite3session_diff: (pSession: CPointer64, zFromDb: CString64, zTbl: CString64, d: CPointer64) => CInteger;
+	sqlite3session_patchset: (pSession: CPointer64, pnPatchset: CPointer64, c: CPointer64) => CInteger;
+	sqlite3session_isempty: (pSession: CPointer64) => CInteger;
+	sqlite3session_memory_used: (pSession: CPointer64) => CInteger64;
+	sqlite3changeset_start: (a: CPointer64, nChangeset: CInteger, pChangeset: CPointer64) => CInteger;
+	sqlite3changeset_start_v2: (a: CPointer64, nChangeset: CInteger, pChangeset: CPointer64, flags: CInteger) => CInteger;
+	sqlite3changeset_next: (pIter: CPointer64) => CInteger;
+	sqlite3changeset_op: (pIter: CPointer64, b: CPointer64, pnCol: CPointer64, pOp: CPointer64, pbIndirect: CPointer64) => CInteger;
+	sqlite3changeset_pk: (pIter: CPointer64, b: CPointer64, pnCol: CPointer64) => CInteger;
+	sqlite3changeset_old: (pIter: CPointer64, iVal: CInteger, c: CPointer64) => CInteger;
+	sqlite3changeset_new: (pIter: CPointer64, iVal: CInteger, c: CPointer64) => CInteger;
+	sqlite3changeset_conflict: (pIter: CPointer64, iVal: CInteger, c: CPointer64) => CInteger;
+	sqlite3changeset_fk_conflicts: (pIter: CPointer64, pnOut: CPointer64) => CInteger;
+	sqlite3changeset_finalize: (pIter: CPointer64) => CInteger;
+	sqlite3changeset_invert: (nIn: CInteger, pIn: CPointer64, pnOut: CPointer64, d: CPointer64) => CInteger;
+	sqlite3changeset_concat: (nA: CInteger, pA: CPointer64, nB: CInteger, pB: CPointer64, pnOut: CPointer64, f: CPointer64) => CInteger;
+	sqlite3changegroup_new: (a: CPointer64) => CInteger;
+	sqlite3changegroup_add: (a: CPointer64, nData: CInteger, pData: CPointer64) => CInteger;
+	sqlite3changegroup_output: (a: CPointer64, pnData: CPointer64, c: CPointer64) => CInteger;
+	sqlite3changegroup_delete: (a: CPointer64) => void;
+	sqlite3changeset_apply: (db: CPointer64, nChangeset: CInteger, pChangeset: CPointer64, xFilter: CFunctionPointer64, xConflict: CFunctionPointer64, pCtx: CPointer64) => CInteger;
+	sqlite3changeset_apply_v2: (db: CPointer64, nChangeset: CInteger, pChangeset: CPointer64, xFilter: CFunctionPointer64, xConflict: CFunctionPointer64, pCtx: CPointer64, g: CPointer64, pnRebase: CPointer64, flags: CInteger) => CInteger;
+	sqlite3rebaser_create: (a: CPointer64) => CInteger;
+	sqlite3rebaser_configure: (a: CPointer64, nRebase: CInteger, pRebase: CPointer64) => CInteger;
+	sqlite3rebaser_rebase: (a: CPointer64, nIn: CInteger, pIn: CPointer64, pnOut: CPointer64, e: CPointer64) => CInteger;
+	sqlite3rebaser_delete: (p: CPointer64) => void;
+	sqlite3changeset_apply_strm: (db: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64, xFilter: CFunctionPointer64, xConflict: CFunctionPointer64, pCtx: CPointer64) => CInteger;
+	sqlite3changeset_apply_v2_strm: (db: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64, xFilter: CFunctionPointer64, xConflict: CFunctionPointer64, pCtx: CPointer64, g: CPointer64, pnRebase: CPointer64, flags: CInteger) => CInteger;
+	sqlite3changeset_concat_strm: (xInputA: CFunctionPointer64, pInA: CPointer64, xInputB: CFunctionPointer64, pInB: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3changeset_invert_strm: (xInput: CFunctionPointer64, pIn: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3changeset_start_strm: (a: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64) => CInteger;
+	sqlite3changeset_start_v2_strm: (a: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64, flags: CInteger) => CInteger;
+	sqlite3session_changeset_strm: (pSession: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3session_patchset_strm: (pSession: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3changegroup_add_strm: (a: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64) => CInteger;
+	sqlite3changegroup_output_strm: (a: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3rebaser_rebase_strm: (pRebaser: CPointer64, xInput: CFunctionPointer64, pIn: CPointer64, xOutput: CFunctionPointer64, pOut: CPointer64) => CInteger;
+	sqlite3session_config: (op: CInteger, pArg: CPointer64) => CInteger;
+	sqlite3_ext_init: () => CInteger;
+	sqlite3_ext_vfs_register: (name: CString64, makeDflt: CInteger, pOutVfsId: CPointer64) => CInteger;
+	sqlite3_ext_vfs_unregister: (vfsId: CInteger) => CInteger;
+	sqlite3_ext_exec: (db: CPointer64, sql: CString64, id: CInteger, d: CPointer64) => CInteger;
+	sqlite3_ext_progress_handler: (db: CPointer64, nOps: CInteger, id: CInteger) => void;
+	sqlite3_ext_bind_blob_free: (pStmt: CPointer64, i: CInteger, p: CPointer64, n: CInteger) => CInteger;
+	sqlite3_ext_stmt_json: (pStmt: CPointer64, flags: CInteger, c: CPointer64, pnOut: CPointer64) => CInteger;
+	sqlite3_ext_fts5_tokenizer_register: (db: CPointer64, zName: CString64, id: CInteger) => CInteger;
+	sqlite3_ext_rtree_load: (db: CPointer64, zTable: CString64, nCol: CInteger, nRow: CInteger, aRow: CPointer64) => CInteger;
+
+	memory: WebAssembly.Memory;
+}
+
+export interface SQLiteImports64 {
+	sqlite3_ext_os_init: () => CInteger;
+	sqlite3_ext_os_end: () => CInteger;
+	sqlite3_ext_exec_callback: (id: CInteger, nCols: CInteger, azCols: CPointer64, azColNames: CPointer64) => CInteger;
+	sqlite3_ext_progress_callback: (id: CInteger) => CInteger;
+	sqlite3_ext_io_close: (vfsId: CInteger, fileId: CInteger) => CInteger;
+	sqlite3_ext_io_read: (vfsId: CInteger, fileId: CInteger, pBuf: CPointer64, iAmt: CInteger, iOfst: CInteger) => CInteger;
+	sqlite3_ext_io_write: (vfsId: CInteger, fileId: CInteger, pBuf: CPointer64, iAmt: CInteger, iOfst: CInteger) => CInteger;
+	sqlite3_ext_io_truncate: (vfsId: CInteger, fileId: CInteger, size: CInteger) => CInteger;
+	sqlite3_ext_io_sync: (vfsId: CInteger, fileId: CInteger, flags: CInteger) => CInteger;
+	sqlite3_ext_io_file_size: (vfsId: CInteger, fileId: CInteger, pSize: CPointer64) => CInteger;
+	sqlite3_ext_io_lock: (vfsId: CInteger, fileId: CInteger, locktype: CInteger) => CInteger;
+	sqlite3_ext_io_unlock: (vfsId: CInteger, fileId: CInteger, locktype: CInteger) => CInteger;
+	sqlite3_ext_io_check_reserved_lock: (vfsId: CInteger, fileId: CInteger, pResOut: CPointer64) => CInteger;
+	sqlite3_ext_io_file_control: (vfsId: CInteger, fileId: CInteger, op: CInteger, pArg: CPointer64) => CInteger;
+	sqlite3_ext_io_sector_size: (vfsId: CInteger, fileId: CInteger) => CInteger;
+	sqlite3_ext_io_device_characteristics: (vfsId: CInteger, fileId: CInteger) => CInteger;
+	sqlite3_ext_vfs_open: (id: CInteger, zName: CString64, pOutfileId: CPointer64, flags: CInteger, pOutFlags: CPointer64) => CInteger;
+	sqlite3_ext_vfs_delete: (id: CInteger, zName: CString64, syncDir: CInteger) => CInteger;
+	sqlite3_ext_vfs_access: (id: CInteger, zName: CString64, flags: CInteger, pResOut: CPointer64) => CInteger;
+	sqlite3_ext_vfs_full_pathname: (id: CInteger, zName: CString64, nOut: CInteger, zOut: CPointer64) => CInteger;
+	sqlite3_ext_vfs_randomness: (id: CInteger, nByte: CInteger, zOut: CPointer64) => CInteger;
+	sqlite3_ext_vfs_sleep: (id: CInteger, microseconds: CInteger) => CInteger;
+	sqlite3_ext_vfs_current_time: (id: CInteger, pTimeOut: CPointer64) => CInteger;
+	sqlite3_ext_vfs_get_last_error: (id: CInteger, nByte: CInteger, zOut: CPointer64) => CInteger;
+	sqlite3_ext_fts5_tokenize: (id: CInteger, flags: CInteger, pText: CString64, nText: CInteger, e: CPointer64) => CInteger;
+}
+
+// Return and argument kinds of every api for the memory64 adapters, "p" for pointers and
+// varargs and "_" for everything else, for example "p:p_" returns a pointer.
+export const pointerSignatures: Record<string, string> = {
+	sqlite3_libversion: "p:",
+	sqlite3_sourceid: "p:",
+	sqlite3_libversion_number: "_:",
+	sqlite3_compileoption_used: "_:p",
+	sqlite3_compileoption_get: "p:_",
+	sqlite3_threadsafe: "_:",
+	sqlite3_close: "_:p",
+	sqlite3_close_v2: "_:p",
+	sqlite3_exec: "_:ppppp",
+	sqlite3_initialize: "_:",
+	sqlite3_shutdown: "_:",
+	sqlite3_os_init: "_:",
+	sqlite3_os_end: "_:",
+	sqlite3_config: "_:_p",
+	sqlite3_db_config: "_:p_p",
+	sqlite3_extended_result_codes: "_:p_",
+	sqlite3_last_insert_rowid: "_:p",
+	sqlite3_set_last_insert_rowid: "_:p_",
+	sqlite3_changes: "_:p",
+	sqlite3_changes64: "_:p",
+	sqlite3_total_changes: "_:p",
+	sqlite3_total_changes64: "_:p",
+	sqlite3_interrupt: "_:p",
+	sqlite3_complete: "_:p",
+	sqlite3_busy_handler: "_:ppp",
+	sqlite3_busy_timeout: "_:p_",
+	sqlite3_get_table: "_:pppppp",
+	sqlite3_free_table: "_:p",
+	sqlite3_mprintf: "p:pp",
+	sqlite3_vmprintf: "p:pp",
+	sqlite3_snprintf: "p:_ppp",
+	sqlite3_vsnprintf: "p:_ppp",
+	sqlite3_malloc: "p:_",
+	sqlite3_malloc64: "p:_",
+	sqlite3_realloc: "p:p_",
+	sqlite3_realloc64: "p:p_",
+	sqlite3_free: "_:p",
+	sqlite3_msize: "_:p",
+	sqlite3_memory_used: "_:",
+	sqlite3_memory_highwater: "_:_",
+	sqlite3_randomness: "_:_p",
+	sqlite3_set_authorizer: "_:ppp",
+	sqlite3_trace_v2: "_:p_pp",
+	sqlite3_progress_handler: "_:p_pp",
+	sqlite3_open: "_:pp",
+	sqlite3_open_v2: "_:pp_p",
+	sqlite3_uri_parameter: "p:pp",
+	sqlite3_uri_boolean: "_:pp_",
+	sqlite3_uri_int64: "_:pp_",
+	sqlite3_uri_key: "p:p_",
+	sqlite3_filename_database: "p:p",
+	sqlite3_filename_journal: "p:p",
+	sqlite3_filename_wal: "p:p",
+	sqlite3_database_file_object: "p:p",
+	sqlite3_create_filename: "p:ppp_p",
+	sqlite3_free_filename: "_:p",
+	sqlite3_errcode: "_:p",
+	sqlite3_extended_errcode: "_:p",
+	sqlite3_errmsg: "p:p",
+	sqlite3_errstr: "p:_",
+	sqlite3_limit: "_:p__",
+	sqlite3_prepare: "_:pp_pp",
+	sqlite3_prepare_v2: "_:pp_pp",
+	sqlite3_prepare_v3: "_:pp__pp",
+	sqlite3_sql: "p:p",
+	sqlite3_expanded_sql: "p:p",
+	sqlite3_normalized_sql: "p:p",
+	sqlite3_stmt_readonly: "_:p",
+	sqlite3_stmt_isexplain: "_:p",
+	sqlite3_stmt_busy: "_:p",
+	sqlite3_bind_blob: "_:p_p_p",
+	sqlite3_bind_blob64: "_:p_p_p",
+	sqlite3_bind_double: "_:p__",
+	sqlite3_bind_int: "_:p__",
+	sqlite3_bind_int64: "_:p__",
+	sqlite3_bind_null: "_:p_",
+	sqlite3_bind_text: "_:p_p_p",
+	sqlite3_bind_text64: "_:p_p_p_",
+	sqlite3_bind_value: "_:p_p",
+	sqlite3_bind_pointer: "_:p_ppp",
+	sqlite3_bind_zeroblob: "_:p__",
+	sqlite3_bind_zeroblob64: "_:p__",
+	sqlite3_bind_parameter_count: "_:p",
+	sqlite3_bind_parameter_name: "p:p_",
+	sqlite3_bind_parameter_index: "_:pp",
+	sqlite3_clear_bindings: "_:p",
+	sqlite3_column_count: "_:p",
+	sqlite3_column_name: "p:p_",
+	sqlite3_column_database_name: "p:p_",
+	sqlite3_column_table_name: "p:p_",
+	sqlite3_column_origin_name: "p:p_",
+	sqlite3_column_decltype: "p:p_",
+	sqlite3_step: "_:p",
+	sqlite3_data_count: "_:p",
+	sqlite3_column_blob: "p:p_",
+	sqlite3_column_double: "_:p_",
+	sqlite3_column_int: "_:p_",
+	sqlite3_column_int64: "_:p_",
+	sqlite3_column_text: "p:p_",
+	sqlite3_column_value: "p:p_",
+	sqlite3_column_bytes: "_:p_",
+	sqlite3_column_type: "_:p_",
+	sqlite3_finalize: "_:p",
+	sqlite3_reset: "_:p",
+	sqlite3_create_function: "_:pp__pppp",
+	sqlite3_create_function_v2: "_:pp__ppppp",
+	sqlite3_create_window_function: "_:pp__pppppp",
+	sqlite3_value_blob: "p:p",
+	sqlite3_value_double: "_:p",
+	sqlite3_value_int: "_:p",
+	sqlite3_value_int64: "_:p",
+	sqlite3_value_pointer: "p:pp",
+	sqlite3_value_text: "p:p",
+	sqlite3_value_bytes: "_:p",
+	sqlite3_value_type: "_:p",
+	sqlite3_value_numeric_type: "_:p",
+	sqlite3_value_nochange: "_:p",
+	sqlite3_value_frombind: "_:p",
+	sqlite3_value_subtype: "_:p",
+	sqlite3_value_dup: "p:p",
+	sqlite3_value_free: "_:p",
+	sqlite3_aggregate_context: "p:p_",
+	sqlite3_user_data: "p:p",
+	sqlite3_context_db_handle: "p:p",
+	sqlite3_get_auxdata: "p:p_",
+	sqlite3_set_auxdata: "_:p_pp",
+	sqlite3_result_blob: "_:pp_p",
+	sqlite3_result_blob64: "_:pp_p",
+	sqlite3_result_double: "_:p_",
+	sqlite3_result_error: "_:pp_",
+	sqlite3_result_error_toobig: "_:p",
+	sqlite3_result_error_nomem: "_:p",
+	sqlite3_result_error_code: "_:p_",
+	sqlite3_result_int: "_:p_",
+	sqlite3_result_int64: "_:p_",
+	sqlite3_result_null: "_:p",
+	sqlite3_result_text: "_:pp_p",
+	sqlite3_result_text64: "_:pp_p_",
+	sqlite3_result_value: "_:pp",
+	sqlite3_result_pointer: "_:pppp",
+	sqlite3_result_zeroblob: "_:p_",
+	sqlite3_result_zeroblob64: "_:p_",
+	sqlite3_result_subtype: "_:p_",
+	sqlite3_create_collation: "_:pp_pp",
+	sqlite3_create_collation_v2: "_:pp_ppp",
+	sqlite3_collation_needed: "_:ppp",
+	sqlite3_activate_cerod: "_:p",
+	sqlite3_sleep: "_:_",
+	sqlite3_win32_set_directory: "p:_p",
+	sqlite3_win32_set_directory8: "_:_p",
+	sqlite3_get_autocommit: "_:p",
+	sqlite3_db_handle: "p:p",
+	sqlite3_db_filename: "p:pp",
+	sqlite3_db_readonly: "_:pp",
+	sqlite3_txn_state: "_:pp",
+	sqlite3_next_stmt: "p:pp",
+	sqlite3_commit_hook: "p:ppp",
+	sqlite3_rollback_hook: "p:ppp",
+	sqlite3_autovacuum_pages: "_:pppp",
+	sqlite3_update_hook: "p:ppp",
+	sqlite3_enable_shared_cache: "_:_",
+	sqlite3_release_memory: "_:_",
+	sqlite3_db_release_memory: "_:p",
+	sqlite3_soft_heap_limit64: "_:_",
+	sqlite3_hard_heap_limit64: "_:_",
+	sqlite3_table_column_metadata: "_:ppppppppp",
+	sqlite3_load_extension: "_:pppp",
+	sqlite3_enable_load_extension: "_:p_",
+	sqlite3_auto_extension: "_:p",
+	sqlite3_cancel_auto_extension: "_:p",
+	sqlite3_reset_auto_extension: "_:",
+	sqlite3_create_module: "_:pppp",
+	sqlite3_create_module_v2: "_:ppppp",
+	sqlite3_drop_modules: "_:pp",
+	sqlite3_declare_vtab: "_:pp",
+	sqlite3_overload_function: "_:pp_",
+	sqlite3_blob_open: "_:pppp__p",
+	sqlite3_blob_reopen: "_:p_",
+	sqlite3_blob_close: "_:p",
+	sqlite3_blob_bytes: "_:p",
+	sqlite3_blob_read: "_:pp__",
+	sqlite3_blob_write: "_:pp__",
+	sqlite3_vfs_find: "p:p",
+	sqlite3_vfs_register: "_:p_",
+	sqlite3_vfs_unregister: "_:p",
+	sqlite3_mutex_alloc: "p:_",
+	sqlite3_mutex_free: "_:p",
+	sqlite3_mutex_enter: "_:p",
+	sqlite3_mutex_try: "_:p",
+	sqlite3_mutex_leave: "_:p",
+	sqlite3_mutex_held: "_:p",
+	sqlite3_mutex_notheld: "_:p",
+	sqlite3_db_mutex: "p:p",
+	sqlite3_file_control: "_:pp_p",
+	sqlite3_test_control: "_:_p",
+	sqlite3_keyword_count: "_:",
+	sqlite3_keyword_name: "_:_pp",
+	sqlite3_keyword_check: "_:p_",
+	sqlite3_str_new: "p:p",
+	sqlite3_str_finish: "p:p",
+	sqlite3_str_appendf: "_:ppp",
+	sqlite3_str_vappendf: "_:ppp",
+	sqlite3_str_append: "_:pp_",
+	sqlite3_str_appendall: "_:pp",
+	sqlite3_str_appendchar: "_:p__",
+	sqlite3_str_reset: "_:p",
+	sqlite3_str_errcode: "_:p",
+	sqlite3_str_length: "_:p",
+	sqlite3_str_value: "p:p",
+	sqlite3_status: "_:_pp_",
+	sqlite3_status64: "_:_pp_",
+	sqlite3_db_status: "_:p_pp_",
+	sqlite3_stmt_status: "_:p__",
+	sqlite3_backup_init: "p:pppp",
+	sqlite3_backup_step: "_:p_",
+	sqlite3_backup_finish: "_:p",
+	sqlite3_backup_remaining: "_:p",
+	sqlite3_backup_pagecount: "_:p",
+	sqlite3_unlock_notify: "_:ppp",
+	sqlite3_stricmp: "_:pp",
+	sqlite3_strnicmp: "_:pp_",
+	sqlite3_strglob: "_:pp",
+	sqlite3_strlike: "_:pp_",
+	sqlite3_log: "_:_pp",
+	sqlite3_wal_hook: "p:ppp",
+	sqlite3_wal_autocheckpoint: "_:p_",
+	sqlite3_wal_checkpoint: "_:pp",
+	sqlite3_wal_checkpoint_v2: "_:pp_pp",
+	sqlite3_vtab_config: "_:p_p",
+	sqlite3_vtab_on_conflict: "_:p",
+	sqlite3_vtab_nochange: "_:p",
+	sqlite3_vtab_collation: "p:p_",
+	sqlite3_stmt_scanstatus: "_:p__p",
+	sqlite3_stmt_scanstatus_reset: "_:p",
+	sqlite3_db_cacheflush: "_:p",
+	sqlite3_preupdate_hook: "p:ppp",
+	sqlite3_preupdate_old: "_:p_p",
+	sqlite3_preupdate_count: "_:p",
+	sqlite3_preupdate_depth: "_:p",
+	sqlite3_preupdate_new: "_:p_p",
+	sqlite3_preupdate_blobwrite: "_:p",
+	sqlite3_system_errno: "_:p",
+	sqlite3_snapshot_get: "_:ppp",
+	sqlite3_snapshot_open: "_:ppp",
+	sqlite3_snapshot_free: "_:p",
+	sqlite3_snapshot_cmp: "_:pp",
+	sqlite3_snapshot_recover: "_:pp",
+	sqlite3_serialize: "p:ppp_",
+	sqlite3_deserialize: "_:ppp___",
+	sqlite3_rtree_geometry_callback: "_:pppp",
+	sqlite3_rtree_query_callback: "_:ppppp",
+	sqlite3session_create: "_:ppp",
+	sqlite3session_delete: "_:p",
+	sqlite3session_object_config: "_:p_p",
+	sqlite3session_enable: "_:p_",
+	sqlite3session_indirect: "_:p_",
+	sqlite3session_attach: "_:pp",
+	sqlite3session_table_filter: "_:ppp",
+	sqlite3session_changeset: "_:ppp",
+	sqlite3session_changeset_size: "_:p",
+	sqlite3session_diff: "_:pppp",
+	sqlite3session_patchset: "_:ppp",
+	sqlite3session_isempty: "_:p",
+	sqlite3session_memory_used: "_:p",
+	sqlite3changeset_start: "_:p_p",
+	sqlite3changeset_start_v2: "_:p_p_",
+	sqlite3changeset_next: "_:p",
+	sqlite3changeset_op: "_:ppppp",
+	sqlite3changeset_pk: "_:ppp",
+	sqlite3changeset_old: "_:p_p",
+	sqlite3changeset_new: "_:p_p",
+	sqlite3changeset_conflict: "_:p_p",
+	sqlite3changeset_fk_conflicts: "_:pp",
+	sqlite3changeset_finalize: "_:p",
+	sqlite3changeset_invert: "_:_ppp",
+	sqlite3changeset_concat: "_:_p_ppp",
+	sqlite3changegroup_new: "_:p",
+	sqlite3changegroup_add: "_:p_p",
+	sqlite3changegroup_output: "_:ppp",
+	sqlite3changegroup_delete: "_:p",
+	sqlite3changeset_apply: "_:p_pppp",
+	sqlite3changeset_apply_v2: "_:p_pppppp_",
+	sqlite3rebaser_create: "_:p",
+	sqlite3rebaser_configure: "_:p_p",
+	sqlite3rebaser_rebase: "_:p_ppp",
+	sqlite3rebaser_delete: "_:p",
+	sqlite3changeset_apply_strm: "_:pppppp",
+	sqlite3changeset_apply_v2_strm: "_:pppppppp_",
+	sqlite3changeset_concat_strm: "_:pppppp",
+	sqlite3changeset_invert_strm: "_:pppp",
+	sqlite3changeset_start_strm: "_:ppp",
+	sqlite3changeset_start_v2_strm: "_:ppp_",
+	sqlite3session_changeset_strm: "_:ppp",
+	sqlite3session_patchset_strm: "_:ppp",
+	sqlite3changegroup_add_strm: "_:ppp",
+	sqlite3changegroup_output_strm: "_:ppp",
+	sqlite3rebaser_rebase_strm: "_:ppppp",
+	sqlite3session_config: "_:_p",
+	sqlite3_ext_init: "_:",
+	sqlite3_ext_vfs_register: "_:p_p",
+	sqlite3_ext_vfs_unregister: "_:_",
+	sqlite3_ext_exec: "_:pp_p",
+	sqlite3_ext_progress_handler: "_:p__",
+	sqlite3_ext_bind_blob_free: "_:p_p_",
+	sqlite3_ext_stmt_json: "_:p_pp",
+	sqlite3_ext_fts5_tokenizer_register: "_:pp_",
+	sqlite3_ext_rtree_load: "_:pp__p",
+	sqlite3_ext_os_init: "_:",
+	sqlite3_ext_os_end: "_:",
+	sqlite3_ext_exec_callback: "_:__pp",
+	sqlite3_ext_progress_callback: "_:_",
+	sqlite3_ext_io_close: "_:__",
+	sqlite3_ext_io_read: "_:__p__",
+	sqlite3_ext_io_write: "_:__p__",
+	sqlite3_ext_io_truncate: "_:___",
+	sqlite3_ext_io_sync: "_:___",
+	sqlite3_ext_io_file_size: "_:__p",
+	sqlite3_ext_io_lock: "_:___",
+	sqlite3_ext_io_unlock: "_:___",
+	sqlite3_ext_io_check_reserved_lock: "_:__p",
+	sqlite3_ext_io_file_control: "_:___p",
+	sqlite3_ext_io_sector_size: "_:__",
+	sqlite3_ext_io_device_characteristics: "_:__",
+	sqlite3_ext_vfs_open: "_:_pp_p",
+	sqlite3_ext_vfs_delete: "_:_p_",
+	sqlite3_ext_vfs_access: "_:_p_p",
+	sqlite3_ext_vfs_full_pathname: "_:_p_p",
+	sqlite3_ext_vfs_randomness: "_:__p",
+	sqlite3_ext_vfs_sleep: "_:__",
+	sqlite3_ext_vfs_current_time: "_:_p",
+	sqlite3_ext_vfs_get_last_error: "_:__p",
+	sqlite3_ext_fts5_tokenize: "_:__p_p",
+};
+
 export class SQLiteUnimplementedImportError extends Error {
 	constructor(api: string) {
 		super(api + " is not implemented");
@@ -350,6 +1040,7 @@ export const unimplementedImports: SQLiteImports = {
 	sqlite3_ext_os_init: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_os_init") },
 	sqlite3_ext_os_end: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_os_end") },
 	sqlite3_ext_exec_callback: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_exec_callback") },
+	sqlite3_ext_progress_callback: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_progress_callback") },
 	sqlite3_ext_io_close: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_io_close") },
 	sqlite3_ext_io_read: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_io_read") },
 	sqlite3_ext_io_write: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_io_write") },
@@ -370,4 +1061,5 @@ export const unimplementedImports: SQLiteImports = {
 	sqlite3_ext_vfs_sleep: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_vfs_sleep") },
 	sqlite3_ext_vfs_current_time: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_vfs_current_time") },
 	sqlite3_ext_vfs_get_last_error: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_vfs_get_last_error") },
+	sqlite3_ext_fts5_tokenize: () => { throw new SQLiteUnimplementedImportError("sqlite3_ext_fts5_tokenize") },
 };
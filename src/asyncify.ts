@@ -0,0 +1,89 @@
+import type { SQLite, SQLiteDB } from "./sqlite";
+
+// Exports added by `wasm-opt --asyncify`, see `make asyncify`
+interface AsyncifyExports {
+	asyncify_start_unwind(data: number): void;
+	asyncify_stop_unwind(): void;
+	asyncify_start_rewind(data: number): void;
+	asyncify_stop_rewind(): void;
+	asyncify_get_state(): number;
+}
+
+const ASYNCIFY_UNWINDING = 1;
+const ASYNCIFY_REWINDING = 2;
+
+// room for the saved wasm locals and call stack of a suspended sqlite3_step
+const ASYNCIFY_STACK_SIZE = 1 << 16;
+
+export const yieldMacrotask: () => Promise<void> = typeof setImmediate === "function"
+	? () => new Promise((resolve) => setImmediate(resolve))
+	: () => new Promise((resolve) => setTimeout(resolve, 0));
+
+// Suspends a call into an Asyncify build at sqlite3_ext_progress_callback and resumes it
+// on a later macrotask, so one long statement does not hold the event loop.
+export class SQLiteAsyncify {
+	private data = 0;
+	private queue: Promise<unknown> = Promise.resolve();
+
+	constructor(private readonly sqlite: SQLite, private readonly exports: AsyncifyExports) {
+	}
+
+	public static detect(sqlite: SQLite, exports: WebAssembly.Exports): SQLiteAsyncify | undefined {
+		if (typeof exports.asyncify_start_unwind !== "function") {
+			return undefined;
+		}
+		return new SQLiteAsyncify(sqlite, exports as unknown as AsyncifyExports);
+	}
+
+	// Runs call with a progress callback that unwinds once sliceMs has passed. check can still
+	// interrupt the statement by returning non-zero. Calls are serialized per instance because a
+	// suspended statement keeps its frames on the wasm stack.
+	public run<T>(db: SQLiteDB, call: () => T, check: () => number, sliceMs: number): Promise<T> {
+		const result = this.queue.then(() => this.runExclusive(db, call, check, sliceMs));
+		this.queue = result.catch(() => undefined);
+		return result;
+	}
+
+	private async runExclusive<T>(db: SQLiteDB, call: () => T, check: () => number, sliceMs: number): Promise<T> {
+		const exports = this.exports;
+		const u32 = () => this.sqlite.utils.u32;
+		if (this.data === 0) {
+			this.data = this.sqlite.utils.malloc(8 + ASYNCIFY_STACK_SIZE);
+		}
+		let sliceStart = performance.now();
+		// installProgress runs the handlers installed around the call, such as the deadline of
+		// interruptible, after this one
+		const unwind = () => {
+			if (exports.asyncify_get_state() === ASYNCIFY_REWINDING) {
+				exports.asyncify_stop_rewind();
+				return 0;
+			}
+			const rc = check();
+			if (rc !== 0 || performance.now() - sliceStart < sliceMs) {
+				return rc;
+			}
+			const view = u32();
+			view[this.data / 4] = this.data + 8;
+			view[this.data / 4 + 1] = this.data + 8 + ASYNCIFY_STACK_SIZE;
+			exports.asyncify_start_unwind(this.data);
+			return 0;
+		};
+		let restore = db.installProgress(unwind);
+		try {
+			let result = call();
+			while (exports.asyncify_get_state() === ASYNCIFY_UNWINDING) {
+				exports.asyncify_stop_unwind();
+				// other calls while suspended must not see the callback, it would unwind them instead
+				restore();
+				await yieldMacrotask();
+				restore = db.installProgress(unwind);
+				sliceStart = performance.now();
+				exports.asyncify_start_rewind(this.data);
+				result = call();
+			}
+			return result;
+		} finally {
+			restore();
+		}
+	}
+}
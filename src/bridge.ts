@@ -0,0 +1,316 @@
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError } from "./utils";
+import type { SQLiteVFS, SQLiteVFSFile } from "./vfs";
+
+export interface SQLiteAsyncVFSFile {
+	close(): Promise<void>;
+	// returns the number of bytes read
+	read(buf: Uint8Array, offset: number): Promise<number>;
+	write(buf: Uint8Array, offset: number): Promise<void>;
+	truncate(size: number): Promise<void>;
+	sync(flags: number): Promise<void>;
+	fileSize(): Promise<number>;
+	// locking is optional, a backend without it behaves like an exclusive single connection
+	lock?(level: number): Promise<boolean>;
+	unlock?(level: number): Promise<void>;
+	checkReservedLock?(): Promise<boolean>;
+}
+
+export interface SQLiteAsyncVFS {
+	open(name: string | null, flags: number): Promise<SQLiteAsyncVFSFile>;
+	delete(name: string, syncDir: boolean): Promise<void>;
+	access(name: string, flags: number): Promise<boolean>;
+	fullPathname?(name: string): Promise<string>;
+}
+
+const BridgeOps = {
+	OPEN: 1,
+	CLOSE: 2,
+	READ: 3,
+	WRITE: 4,
+	TRUNCATE: 5,
+	SYNC: 6,
+	FILE_SIZE: 7,
+	LOCK: 8,
+	UNLOCK: 9,
+	CHECK_RESERVED_LOCK: 10,
+	DELETE: 11,
+	ACCESS: 12,
+	FULL_PATHNAME: 13,
+} as const;
+
+// Header of a channel, in Int32 slots. The client fills in a request and flips STATE,
+// the host writes RESULT and VALUE back and flips it again.
+const BRIDGE_STATE = 0;
+const BRIDGE_OP = 1;
+const BRIDGE_FILE = 2;
+const BRIDGE_ARG = 3;
+const BRIDGE_OFFSET = 4;
+const BRIDGE_LENGTH = 5;
+const BRIDGE_RESULT = 6;
+const BRIDGE_VALUE = 7;
+const BRIDGE_HEADER_BYTES = 64;
+
+const BRIDGE_IDLE = 0;
+const BRIDGE_REQUEST = 1;
+const BRIDGE_RESPONSE = 2;
+const BRIDGE_CLOSED = 3;
+
+type WaitAsync = (typedArray: Int32Array, index: number, value: number) => { async: boolean; value: Promise<string> | string };
+const waitAsync = (Atomics as unknown as { waitAsync?: WaitAsync }).waitAsync;
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+// A request/response channel over a SharedArrayBuffer. Names and I/O buffers
+// go through the data region, so a request never allocates or clones.
+export class SQLiteBridgeChannel {
+	public readonly header: Int32Array;
+	public readonly data: Uint8Array;
+
+	constructor(public readonly buffer: SharedArrayBuffer) {
+		this.header = new Int32Array(buffer, 0, BRIDGE_HEADER_BYTES / 4);
+		this.data = new Uint8Array(buffer, BRIDGE_HEADER_BYTES);
+	}
+
+	// the data region bounds the largest single transfer, larger I/O is split
+	public static create(dataSize: number = 65536): SQLiteBridgeChannel {
+		return new SQLiteBridgeChannel(new SharedArrayBuffer(BRIDGE_HEADER_BYTES + dataSize));
+	}
+
+	public encodeString(s: string): number {
+		const { read, written } = textEncoder.encodeInto(s, this.data);
+		if (read! < s.length) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_CANTOPEN);
+		}
+		return written!;
+	}
+
+	public decodeString(length: number): string {
+		// TextDecoder does not accept views of shared memory
+		return textDecoder.decode(this.data.slice(0, length));
+	}
+
+	// Blocks the calling thread until the host answers, returns VALUE or throws RESULT.
+	public call(op: number, file: number, arg: number = 0, offset: number = 0, length: number = 0): number {
+		const header = this.header;
+		header[BRIDGE_OP] = op;
+		header[BRIDGE_FILE] = file;
+		header[BRIDGE_ARG] = arg;
+		header[BRIDGE_OFFSET] = offset;
+		header[BRIDGE_LENGTH] = length;
+		if (Atomics.compareExchange(header, BRIDGE_STATE, BRIDGE_IDLE, BRIDGE_REQUEST) !== BRIDGE_IDLE) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_IOERR);
+		}
+		Atomics.notify(header, BRIDGE_STATE);
+		while (Atomics.load(header, BRIDGE_STATE) === BRIDGE_REQUEST) {
+			Atomics.wait(header, BRIDGE_STATE, BRIDGE_REQUEST);
+		}
+		if (Atomics.load(header, BRIDGE_STATE) === BRIDGE_CLOSED) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_IOERR);
+		}
+		const result = header[BRIDGE_RESULT];
+		const value = header[BRIDGE_VALUE];
+		Atomics.store(header, BRIDGE_STATE, BRIDGE_IDLE);
+		if (result !== SQLiteResultCodes.SQLITE_OK) {
+			throw new SQLiteError(result);
+		}
+		return value;
+	}
+}
+
+class SQLiteBridgeFile implements SQLiteVFSFile {
+	constructor(private readonly channel: SQLiteBridgeChannel, private readonly fileId: number) {
+	}
+
+	public close(): void {
+		this.channel.call(BridgeOps.CLOSE, this.fileId);
+	}
+
+	public read(buf: Uint8Array, offset: number): number {
+		const data = this.channel.data;
+		let total = 0;
+		while (total < buf.length) {
+			const length = Math.min(buf.length - total, data.length);
+			const n = this.channel.call(BridgeOps.READ, this.fileId, 0, offset + total, length);
+			buf.set(data.subarray(0, n), total);
+			total += n;
+			if (n < length) {
+				break;
+			}
+		}
+		return total;
+	}
+
+	public write(buf: Uint8Array, offset: number): void {
+		const data = this.channel.data;
+		for (let total = 0; total < buf.length; total += data.length) {
+			const chunk = buf.subarray(total, total + data.length);
+			data.set(chunk);
+			this.channel.call(BridgeOps.WRITE, this.fileId, 0, offset + total, chunk.length);
+		}
+	}
+
+	public truncate(size: number): void {
+		this.channel.call(BridgeOps.TRUNCATE, this.fileId, 0, size);
+	}
+
+	public sync(flags: number): void {
+		this.channel.call(BridgeOps.SYNC, this.fileId, flags);
+	}
+
+	public fileSize(): number {
+		return this.channel.call(BridgeOps.FILE_SIZE, this.fileId);
+	}
+
+	public lock(level: number): boolean {
+		return this.channel.call(BridgeOps.LOCK, this.fileId, level) !== 0;
+	}
+
+	public unlock(level: number): void {
+		this.channel.call(BridgeOps.UNLOCK, this.fileId, level);
+	}
+
+	public checkReservedLock(): boolean {
+		return this.channel.call(BridgeOps.CHECK_RESERVED_LOCK, this.fileId) !== 0;
+	}
+}
+
+// Synchronous VFS for a worker that forwards every call to serveBridge() on another thread.
+// The worker blocks in Atomics.wait, so it must not be the thread running the host.
+export class SQLiteBridgeVFS implements SQLiteVFS {
+	public readonly channel: SQLiteBridgeChannel;
+
+	constructor(buffer: SharedArrayBuffer) {
+		this.channel = new SQLiteBridgeChannel(buffer);
+	}
+
+	public open(name: string | null, flags: number): SQLiteVFSFile {
+		const length = name === null ? -1 : this.channel.encodeString(name);
+		const fileId = this.channel.call(BridgeOps.OPEN, 0, flags, 0, length);
+		return new SQLiteBridgeFile(this.channel, fileId);
+	}
+
+	public delete(name: string, syncDir: boolean): void {
+		this.channel.call(BridgeOps.DELETE, 0, syncDir ? 1 : 0, 0, this.channel.encodeString(name));
+	}
+
+	public access(name: string, flags: number): boolean {
+		return this.channel.call(BridgeOps.ACCESS, 0, flags, 0, this.channel.encodeString(name)) !== 0;
+	}
+
+	public fullPathname(name: string): string {
+		const length = this.channel.call(BridgeOps.FULL_PATHNAME, 0, 0, 0, this.channel.encodeString(name));
+		return this.channel.decodeString(length);
+	}
+}
+
+export interface SQLiteBridgeHost {
+	readonly files: Map<number, SQLiteAsyncVFSFile>;
+	close(): void;
+}
+
+async function dispatch(channel: SQLiteBridgeChannel, vfs: SQLiteAsyncVFS, files: Map<number, SQLiteAsyncVFSFile>, nextFileId: () => number): Promise<number> {
+	const header = channel.header;
+	const op = header[BRIDGE_OP];
+	const arg = header[BRIDGE_ARG];
+	const offset = header[BRIDGE_OFFSET];
+	const length = header[BRIDGE_LENGTH];
+	if (op === BridgeOps.OPEN) {
+		const file = await vfs.open(length < 0 ? null : channel.decodeString(length), arg);
+		const fileId = nextFileId();
+		files.set(fileId, file);
+		return fileId;
+	}
+	if (op === BridgeOps.DELETE) {
+		await vfs.delete(channel.decodeString(length), arg !== 0);
+		return 0;
+	}
+	if (op === BridgeOps.ACCESS) {
+		return await vfs.access(channel.decodeString(length), arg) ? 1 : 0;
+	}
+	if (op === BridgeOps.FULL_PATHNAME) {
+		const name = channel.decodeString(length);
+		return channel.encodeString(await vfs.fullPathname?.(name) ?? name);
+	}
+	const file = files.get(header[BRIDGE_FILE]);
+	if (file === undefined) {
+		throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE);
+	}
+	switch (op) {
+		case BridgeOps.CLOSE:
+			files.delete(header[BRIDGE_FILE]);
+			await file.close();
+			return 0;
+		case BridgeOps.READ:
+			return await file.read(channel.data.subarray(0, length), offset);
+		case BridgeOps.WRITE:
+			await file.write(channel.data.subarray(0, length), offset);
+			return 0;
+		case BridgeOps.TRUNCATE:
+			await file.truncate(offset);
+			return 0;
+		case BridgeOps.SYNC:
+			await file.sync(arg);
+			return 0;
+		case BridgeOps.FILE_SIZE:
+			return await file.fileSize();
+		case BridgeOps.LOCK:
+			return (await file.lock?.(arg) ?? true) ? 1 : 0;
+		case BridgeOps.UNLOCK:
+			await file.unlock?.(arg);
+			return 0;
+		case BridgeOps.CHECK_RESERVED_LOCK:
+			return (await file.checkReservedLock?.() ?? false) ? 1 : 0;
+	}
+	throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE);
+}
+
+// Serves SQLiteBridgeVFS requests from an async VFS. Runs on its own event loop
+// turn per request, so it must live on a different thread than the client.
+export function serveBridge(buffer: SharedArrayBuffer, vfs: SQLiteAsyncVFS): SQLiteBridgeHost {
+	const channel = new SQLiteBridgeChannel(buffer);
+	const header = channel.header;
+	const files = new Map<number, SQLiteAsyncVFSFile>();
+	let fileId = 1;
+	let closed = false;
+	// a waitAsync wakeup can be lost while the thread's event loop has no active handles
+	const keepAlive = setInterval(() => {}, 1 << 30);
+	const loop = async () => {
+		while (!closed) {
+			const state = Atomics.load(header, BRIDGE_STATE);
+			if (state !== BRIDGE_REQUEST) {
+				if (waitAsync !== undefined) {
+					const result = waitAsync(header, BRIDGE_STATE, state);
+					if (result.async) {
+						await result.value;
+					}
+				} else {
+					await new Promise((resolve) => setTimeout(resolve, 0));
+				}
+				continue;
+			}
+			let result: number = SQLiteResultCodes.SQLITE_OK;
+			let value = 0;
+			try {
+				value = await dispatch(channel, vfs, files, () => fileId++);
+			} catch (e) {
+				result = e instanceof SQLiteError ? e.code : SQLiteResultCodes.SQLITE_IOERR;
+			}
+			header[BRIDGE_RESULT] = result;
+			header[BRIDGE_VALUE] = value;
+			Atomics.store(header, BRIDGE_STATE, BRIDGE_RESPONSE);
+			Atomics.notify(header, BRIDGE_STATE);
+		}
+	};
+	loop();
+	return {
+		files,
+		close: () => {
+			closed = true;
+			clearInterval(keepAlive);
+			Atomics.store(header, BRIDGE_STATE, BRIDGE_CLOSED);
+			Atomics.notify(header, BRIDGE_STATE);
+		},
+	};
+}
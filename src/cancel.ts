@@ -0,0 +1,21 @@
+// A cancellation flag in shared memory, so another thread can stop a statement
+// while the owning thread is busy inside sqlite3_step.
+export class SQLiteCancelToken {
+	private readonly flag: Int32Array;
+
+	constructor(public readonly buffer: SharedArrayBuffer = new SharedArrayBuffer(4)) {
+		this.flag = new Int32Array(buffer, 0, 1);
+	}
+
+	public get cancelled(): boolean {
+		return Atomics.load(this.flag, 0) !== 0;
+	}
+
+	public cancel(): void {
+		Atomics.store(this.flag, 0, 1);
+	}
+
+	public reset(): void {
+		Atomics.store(this.flag, 0, 0);
+	}
+}
@@ -51,3 +51,41 @@ export const SQLiteDatatypesStr: {
 	[key: number]: keyof typeof SQLiteDatatypes
 } = Object.fromEntries(Object.entries(SQLiteDatatypes)
 	.map(([key, value]) => [value, key as keyof typeof SQLiteDatatypes]));
+
+export const SQLiteOpenFlags = {
+	"SQLITE_OPEN_READONLY": 0x00000001,
+	"SQLITE_OPEN_READWRITE": 0x00000002,
+	"SQLITE_OPEN_CREATE": 0x00000004,
+	"SQLITE_OPEN_DELETEONCLOSE": 0x00000008,
+	"SQLITE_OPEN_EXCLUSIVE": 0x00000010,
+	"SQLITE_OPEN_URI": 0x00000040,
+	"SQLITE_OPEN_MEMORY": 0x00000080,
+	"SQLITE_OPEN_MAIN_DB": 0x00000100,
+	"SQLITE_OPEN_TEMP_DB": 0x00000200,
+	"SQLITE_OPEN_TRANSIENT_DB": 0x00000400,
+	"SQLITE_OPEN_MAIN_JOURNAL": 0x00000800,
+	"SQLITE_OPEN_TEMP_JOURNAL": 0x00001000,
+	"SQLITE_OPEN_SUBJOURNAL": 0x00002000,
+	"SQLITE_OPEN_SUPER_JOURNAL": 0x00004000,
+	"SQLITE_OPEN_NOMUTEX": 0x00008000,
+	"SQLITE_OPEN_FULLMUTEX": 0x00010000,
+	"SQLITE_OPEN_WAL": 0x00080000,
+} as const;
+
+export const SQLiteLockLevels = {
+	"SQLITE_LOCK_NONE": 0,
+	"SQLITE_LOCK_SHARED": 1,
+	"SQLITE_LOCK_RESERVED": 2,
+	"SQLITE_LOCK_PENDING": 3,
+	"SQLITE_LOCK_EXCLUSIVE": 4,
+} as const;
+
+export const SQLiteStatementStatus = {
+	"SQLITE_STMTSTATUS_FULLSCAN_STEP": 1,
+	"SQLITE_STMTSTATUS_SORT": 2,
+	"SQLITE_STMTSTATUS_AUTOINDEX": 3,
+	"SQLITE_STMTSTATUS_VM_STEP": 4,
+	"SQLITE_STMTSTATUS_REPREPARE": 5,
+	"SQLITE_STMTSTATUS_RUN": 6,
+	"SQLITE_STMTSTATUS_MEMUSED": 99,
+} as const;
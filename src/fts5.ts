@@ -0,0 +1,207 @@
+import type { SQLiteImports } from "./api";
+import type { ScalarOut, SQLiteDB } from "./sqlite";
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError, SQLiteUtils } from "./utils";
+
+// why FTS5 tokenizes a text, FTS5_TOKENIZE_* in sqlite3.h
+export const SQLiteFTS5TokenizeReasons = {
+	QUERY: 0x0001,
+	// a prefix query such as "term*", set along with QUERY
+	PREFIX: 0x0002,
+	DOCUMENT: 0x0004,
+	// highlight(), snippet() and other auxiliary functions
+	AUX: 0x0008,
+} as const;
+
+const FTS5_TOKEN_COLOCATED = 0x0001;
+
+export interface SQLiteFTS5Token {
+	term: string;
+	// UTF-16 offsets of the token in the text, end exclusive
+	start: number;
+	end: number;
+	// a synonym at the position of the previous token
+	colocated?: boolean;
+}
+
+// Tokenizes a whole document or query, reason is a mask of SQLiteFTS5TokenizeReasons.
+export type SQLiteFTS5Tokenizer = (text: string, reason: number) => SQLiteFTS5Token[];
+
+type FTS5Imports = Pick<SQLiteImports, "sqlite3_ext_fts5_tokenize">;
+
+// UTF-8 byte offset of every UTF-16 offset in text, FTS5 reports token positions in bytes
+function utf8Offsets(text: string): Uint32Array {
+	const offsets = new Uint32Array(text.length + 1);
+	let bytes = 0;
+	for (let i = 0; i < text.length; i++) {
+		offsets[i] = bytes;
+		const c = text.charCodeAt(i);
+		if (c < 0x80) {
+			bytes += 1;
+		} else if (c < 0x800) {
+			bytes += 2;
+		} else if (c >= 0xd800 && c < 0xdc00 && i + 1 < text.length) {
+			// the low surrogate starts in the middle of the same 4-byte sequence
+			bytes += 4;
+			offsets[++i] = bytes;
+		} else {
+			bytes += 3;
+		}
+	}
+	offsets[text.length] = bytes;
+	return offsets;
+}
+
+// JS tokenizers of one instance, FTS5 needs a build with SQLITE_ENABLE_FTS5 such as `make full`.
+export class SQLiteFTS5Registry {
+	public readonly tokenizers = new Map<number, SQLiteFTS5Tokenizer>();
+
+	constructor(private readonly getUtils: () => SQLiteUtils) {
+	}
+
+	// Registers tokenizer for `tokenize = 'name'` in CREATE VIRTUAL TABLE ... USING fts5 on db.
+	public create(db: SQLiteDB, name: string, tokenizer: SQLiteFTS5Tokenizer): void {
+		if (typeof db.exports.sqlite3_ext_fts5_tokenizer_register !== "function") {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "JS tokenizers need a build with FTS5, see `make full`");
+		}
+		// ids follow the map, which SQLiteSnapshot carries over
+		const id = Math.max(0, ...this.tokenizers.keys()) + 1;
+		this.tokenizers.set(id, tokenizer);
+		const zName = this.getUtils().cString(name);
+		const rc = db.exports.sqlite3_ext_fts5_tokenizer_register(db.pDb, zName, id);
+		this.getUtils().free(zName);
+		if (rc !== SQLiteResultCodes.SQLITE_OK) {
+			this.tokenizers.delete(id);
+		}
+		this.getUtils().checkError(rc, db.pDb);
+	}
+
+	private tokenize(id: number, flags: number, pText: number, nText: number, ppOut: number): number {
+		const tokenizer = this.tokenizers.get(id);
+		if (tokenizer === undefined) {
+			return SQLiteResultCodes.SQLITE_MISUSE;
+		}
+		const utils = this.getUtils();
+		const text = utils.textDecoder.decode(utils.u8.subarray(pText, pText + nText));
+		const tokens = tokenizer(text, flags);
+		// ASCII text has the same offsets in both encodings
+		const offsets = text.length === nText ? undefined : utf8Offsets(text);
+		const terms = tokens.map((token) => utils.textEncoder.encode(token.term));
+		const termBytes = terms.reduce((n, term) => n + term.length, 0);
+		const pOut = utils.malloc(4 + tokens.length * 16 + termBytes);
+		const i32 = new Int32Array(utils.u8.buffer, pOut, 1 + tokens.length * 4);
+		i32[0] = tokens.length;
+		let pTerm = pOut + 4 + tokens.length * 16;
+		for (let i = 0; i < tokens.length; i++) {
+			const { start, end, colocated } = tokens[i];
+			i32[1 + i * 4] = colocated ? FTS5_TOKEN_COLOCATED : 0;
+			i32[2 + i * 4] = offsets === undefined ? start : offsets[start];
+			i32[3 + i * 4] = offsets === undefined ? end : offsets[end];
+			i32[4 + i * 4] = terms[i].length;
+			utils.u8.set(terms[i], pTerm);
+			pTerm += terms[i].length;
+		}
+		if (utils.pointerSize === 8) {
+			utils.i64[ppOut / 8] = BigInt(pOut);
+		} else {
+			utils.u32[ppOut / 4] = pOut;
+		}
+		return SQLiteResultCodes.SQLITE_OK;
+	}
+
+	public imports(): FTS5Imports {
+		return {
+			sqlite3_ext_fts5_tokenize: (id, flags, pText, nText, ppOut) => {
+				try {
+					return this.tokenize(id, flags, pText, nText, ppOut);
+				} catch (e) {
+					return e instanceof SQLiteError ? e.code : SQLiteResultCodes.SQLITE_ERROR;
+				}
+			},
+		};
+	}
+}
+
+function quoteIdentifier(name: string): string {
+	return `"${name.replace(/"/g, "\"\"")}"`;
+}
+
+export interface SQLiteFTS5MarkupOptions {
+	// index of the column among the columns of the table
+	column: number;
+	open: string;
+	close: string;
+}
+
+export interface SQLiteFTS5SnippetOptions extends SQLiteFTS5MarkupOptions {
+	ellipsis: string;
+	// at most 64
+	tokens: number;
+}
+
+export interface SQLiteFTS5SearchOptions {
+	// bm25 weight of each column in declaration order, 1 for the ones left out
+	weights?: number[];
+	// columns to return in SQLiteFTS5Match.values
+	columns?: string[];
+	highlight?: SQLiteFTS5MarkupOptions;
+	snippet?: SQLiteFTS5SnippetOptions;
+	limit?: number;
+	offset?: number;
+}
+
+export interface SQLiteFTS5Match {
+	rowid: number;
+	// bm25() of the row, more negative is a better match
+	rank: number;
+	values: ScalarOut[];
+	highlight?: string;
+	snippet?: string;
+}
+
+// Runs a MATCH query on an FTS5 table, best bm25() match first.
+export function searchFTS5(db: SQLiteDB, table: string, query: string, options: SQLiteFTS5SearchOptions = {}): SQLiteFTS5Match[] {
+	const t = quoteIdentifier(table);
+	const params: (string | number)[] = [];
+	const weights = options.weights ?? [];
+	const select = [`rowid`, `bm25(${[t, ...weights.map(() => "?")].join(", ")})`];
+	params.push(...weights);
+	const { highlight, snippet } = options;
+	if (highlight !== undefined) {
+		select.push(`highlight(${t}, ?, ?, ?)`);
+		params.push(highlight.column, highlight.open, highlight.close);
+	}
+	if (snippet !== undefined) {
+		select.push(`snippet(${t}, ?, ?, ?, ?, ?)`);
+		params.push(snippet.column, snippet.open, snippet.close, snippet.ellipsis, snippet.tokens);
+	}
+	const columns = options.columns ?? [];
+	select.push(...columns.map(quoteIdentifier));
+	params.push(query, options.limit ?? -1, options.offset ?? 0);
+	const sql = `SELECT ${select.join(", ")} FROM ${t} WHERE ${t} MATCH ? ORDER BY 2 LIMIT ? OFFSET ?`;
+
+	const matches: SQLiteFTS5Match[] = [];
+	db.prepare(sql, (stmt) => {
+		for (let i = 0; i < params.length; i++) {
+			const value = params[i];
+			// LIMIT and OFFSET take integers
+			if (typeof value === "number" && Number.isInteger(value)) {
+				stmt.bindInt(i + 1, value);
+			} else {
+				stmt.bindValue(i + 1, value);
+			}
+		}
+		const first = select.length - columns.length;
+		while (stmt.step()) {
+			let i = 2;
+			matches.push({
+				rowid: Number(stmt.columnInt64(0)),
+				rank: stmt.columnDouble(1),
+				highlight: highlight !== undefined ? stmt.columnText(i++) : undefined,
+				snippet: snippet !== undefined ? stmt.columnText(i++) : undefined,
+				values: columns.map((_, c) => stmt.columnValue(first + c)),
+			});
+		}
+	});
+	return matches;
+}
@@ -1,3 +1,22 @@
 export * from "./sqlite";
+export * from "./snapshot";
 export * from "./api";
 export * from "./constants";
+export * from "./rows";
+export * from "./ring";
+export * from "./vfs";
+export * from "./cancel";
+export * from "./asyncify";
+export * from "./loader";
+export * from "./memory64";
+export * from "./native";
+export * from "./fts5";
+export * from "./rtree";
+export * from "./json";
+export * from "./vec";
+export * from "./maintenance";
+export * from "./bridge";
+export * from "./worker";
+export * from "./pool";
+export * from "./scheduler";
+export * from "./shards";
@@ -0,0 +1,30 @@
+// TEXT of a JSON column, parsed on the first read of value. Rows that are only passed along or
+// re-serialized never pay for JSON.parse, JSON.stringify writes the parsed value.
+export class SQLiteJSON {
+	private parsed = false;
+	private cached: unknown;
+
+	constructor(public readonly text: string) {
+	}
+
+	public get value(): unknown {
+		if (!this.parsed) {
+			this.cached = JSON.parse(this.text);
+			this.parsed = true;
+		}
+		return this.cached;
+	}
+
+	public toJSON(): unknown {
+		return this.value;
+	}
+
+	public toString(): string {
+		return this.text;
+	}
+}
+
+// whether a declared column type marks JSON, such as `data JSON` in CREATE TABLE
+export function isJSONDecltype(decltype: string | null): boolean {
+	return decltype !== null && decltype.toUpperCase() === "JSON";
+}
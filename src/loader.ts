@@ -0,0 +1,137 @@
+export interface SQLiteFlavor {
+	name: string;
+	// file name in sqlite/ after `make`, and in dist/wasm/ of the package
+	filename: string;
+	// whether the running engine can compile this flavor
+	supported(): boolean;
+}
+
+// A module with one function of the given type and body, and a memory if asked for.
+// All sections are shorter than 128 bytes, so every size fits in one LEB128 byte.
+function probeModule(type: number[], body: number[], memory?: "i32" | "i64"): Uint8Array {
+	const code = [0x00, ...body, 0x0b];
+	return new Uint8Array([
+		0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+		0x01, type.length + 2, 0x01, 0x60, ...type,
+		0x03, 0x02, 0x01, 0x00,
+		// limits flag 0x04 is a 64-bit index
+		...(memory !== undefined ? [0x05, 0x03, 0x01, memory === "i64" ? 0x04 : 0x00, 0x01] : []),
+		0x0a, code.length + 2, 0x01, code.length, ...code,
+	]);
+}
+
+const I32 = 0x7f;
+const F32 = 0x7d;
+const V128 = 0x7b;
+
+const probes = {
+	// i8x16.popcnt (i8x16.splat (i32.const 0))
+	simd128: probeModule([0, 1, V128], [0x41, 0x00, 0xfd, 0x0f, 0xfd, 0x62]),
+	// memory.copy 0 0 (i32.const 0) (i32.const 0) (i32.const 0)
+	bulkMemory: probeModule([0, 0], [0x41, 0x00, 0x41, 0x00, 0x41, 0x00, 0xfc, 0x0a, 0x00, 0x00], "i32"),
+	// i32.extend8_s (local.get 0)
+	signExt: probeModule([1, I32, 1, I32], [0x20, 0x00, 0xc0]),
+	// i32.trunc_sat_f32_s (local.get 0)
+	nontrappingFptoint: probeModule([1, F32, 1, I32], [0x20, 0x00, 0xfc, 0x00]),
+	// return_call 0
+	tailCall: probeModule([0, 0], [0x12, 0x00]),
+	// i32.load (i64.const 0), drop
+	memory64: probeModule([0, 0], [0x42, 0x00, 0x28, 0x02, 0x00, 0x1a], "i64"),
+};
+
+export type SQLiteWasmFeature = keyof typeof probes;
+
+const featureSupport = new Map<SQLiteWasmFeature, boolean>();
+
+// whether the running engine validates instructions of a post-MVP feature
+export function supportsFeature(feature: SQLiteWasmFeature): boolean {
+	let supported = featureSupport.get(feature);
+	if (supported === undefined) {
+		supported = WebAssembly.validate(probes[feature]);
+		featureSupport.set(feature, supported);
+	}
+	return supported;
+}
+
+// must match the -m flags of the flavor in the Makefile
+const POST_MVP_FEATURES: SQLiteWasmFeature[] = ["bulkMemory", "signExt", "nontrappingFptoint"];
+
+export const SQLiteFlavors: Record<string, SQLiteFlavor> = {
+	simd: {
+		name: "simd",
+		filename: "sqlite3.simd.wasm",
+		supported: () => supportsFeature("simd128") && POST_MVP_FEATURES.every(supportsFeature),
+	},
+	features: {
+		name: "features",
+		filename: "sqlite3.features.wasm",
+		supported: () => supportsFeature("tailCall") && POST_MVP_FEATURES.every(supportsFeature),
+	},
+	// -O3 build for servers, choose it with compileFlavor(read, ["fast", "default"])
+	fast: {
+		name: "fast",
+		filename: "sqlite3.fast.wasm",
+		supported: () => true,
+	},
+	// only the exports this library calls, smaller and quicker to compile for cold starts
+	trimmed: {
+		name: "trimmed",
+		filename: "sqlite3.trimmed.wasm",
+		supported: () => true,
+	},
+	// wasm64 build for more than 4 GiB of memory, choose it with compileFlavor(read, ["memory64", "default"])
+	memory64: {
+		name: "memory64",
+		filename: "sqlite3.memory64.wasm",
+		supported: () => supportsFeature("memory64"),
+	},
+	// FTS5 and the other optional extensions, choose it with compileFlavor(read, ["full"]). The
+	// vector kernels of sqlite3vec.c are SIMD128.
+	full: {
+		name: "full",
+		filename: "sqlite3.full.wasm",
+		supported: () => supportsFeature("simd128"),
+	},
+	default: {
+		name: "default",
+		filename: "sqlite3.wasm",
+		supported: () => true,
+	},
+};
+
+// fastest first, every engine runs the last one
+export const SQLiteFlavorPreference = ["simd", "features", "default"];
+
+export function selectFlavor(preference: string[] = SQLiteFlavorPreference): SQLiteFlavor {
+	for (const name of preference) {
+		const flavor = SQLiteFlavors[name];
+		if (flavor?.supported()) {
+			return flavor;
+		}
+	}
+	return SQLiteFlavors.default;
+}
+
+// Compiles the most preferred flavor that the engine supports and read can provide, for example
+// `(filename) => fs.readFile(path.join(wasmDir, filename))` or a fetch relative to the page.
+export async function compileFlavor(
+	read: (filename: string) => Promise<BufferSource>,
+	preference: string[] = SQLiteFlavorPreference,
+): Promise<{ flavor: SQLiteFlavor; module: WebAssembly.Module }> {
+	const candidates = preference
+		.map((name) => SQLiteFlavors[name])
+		.filter((flavor) => flavor?.supported());
+	let error: unknown;
+	for (const flavor of candidates) {
+		let bytes: BufferSource;
+		try {
+			bytes = await read(flavor.filename);
+		} catch (e) {
+			// not shipped, fall back to the next flavor
+			error = e;
+			continue;
+		}
+		return { flavor, module: await WebAssembly.compile(bytes) };
+	}
+	throw error ?? new Error(`No supported flavor among ${preference.join(", ")}`);
+}
@@ -0,0 +1,97 @@
+import type { SQLiteDB } from "./sqlite";
+
+export interface SQLiteMaintenanceOptions {
+	// rows ANALYZE samples per index, PRAGMA analysis_limit, 0 reads every row. Any limit skips
+	// the sqlite_stat4 samples, so builds with STAT4 default to 0 and the others to 400.
+	analysisLimit?: number;
+	// optimize once no row changed for this long after a change, 0 turns the timer off
+	idleMs?: number;
+	// optimize from afterBulkLoad() once this many rows changed since the last run
+	bulkChanges?: number;
+	// errors of runs from the timer, such as SQLITE_BUSY, which are retried on the next tick
+	onError?: (e: unknown) => void;
+}
+
+// Keeps the planner statistics of a connection fresh with PRAGMA optimize, which only runs
+// ANALYZE on tables whose statistics are missing or stale. With STAT4 (`make full`) the
+// sqlite_stat4 samples let the planner cost skewed keys. Statistics live in sqlite_stat
+// tables of the database, so serialize() carries them, and the planner reads them back when
+// the schema of a deserialized image is loaded.
+export class SQLiteMaintenance {
+	public readonly analysisLimit: number;
+	public readonly bulkChanges: number;
+	// total_changes at the last run and at the last tick of the idle timer
+	private optimizedAt: bigint;
+	private seenAt: bigint;
+	private timer: ReturnType<typeof setInterval> | undefined;
+
+	constructor(public readonly db: SQLiteDB, private readonly options: SQLiteMaintenanceOptions = {}) {
+		const stat4 = db.exec("SELECT sqlite_compileoption_used('ENABLE_STAT4')")[0][0].value === "1";
+		this.analysisLimit = options.analysisLimit ?? (stat4 ? 0 : 400);
+		this.bulkChanges = options.bulkChanges ?? 10000;
+		this.optimizedAt = this.totalChanges();
+		this.seenAt = this.optimizedAt;
+		const idleMs = options.idleMs ?? 5000;
+		if (idleMs > 0) {
+			this.timer = setInterval(() => this.tick(), idleMs);
+			// Node would otherwise stay alive for the timer
+			(this.timer as { unref?: () => void }).unref?.();
+		}
+	}
+
+	private totalChanges(): bigint {
+		return BigInt(this.db.exports.sqlite3_total_changes64(this.db.pDb));
+	}
+
+	// rows inserted, updated or deleted since the last run
+	public get pendingChanges(): number {
+		return Number(this.totalChanges() - this.optimizedAt);
+	}
+
+	public optimize(): void {
+		this.analyze("PRAGMA optimize");
+	}
+
+	private analyze(sql: string): void {
+		this.db.exec(`PRAGMA analysis_limit = ${this.analysisLimit | 0}; ${sql}`);
+		this.optimizedAt = this.totalChanges();
+	}
+
+	// Call after a large load, once at least bulkChanges rows changed it runs ANALYZE on tables or
+	// PRAGMA optimize without them. Optimize skips tables the connection has not queried yet, which
+	// freshly loaded tables often are. Returns whether it ran.
+	public afterBulkLoad(tables: string[] = []): boolean {
+		if (this.pendingChanges < this.bulkChanges || !this.db.exports.sqlite3_get_autocommit(this.db.pDb)) {
+			return false;
+		}
+		if (tables.length === 0) {
+			this.optimize();
+		} else {
+			this.analyze(tables.map((table) => `ANALYZE "${table.replace(/"/g, "\"\"")}"`).join("; "));
+		}
+		return true;
+	}
+
+	private tick(): void {
+		const changes = this.totalChanges();
+		const idle = changes === this.seenAt;
+		this.seenAt = changes;
+		// inside a transaction the statistics would be rolled back with it
+		if (!idle || changes === this.optimizedAt || this.db.suspended || !this.db.exports.sqlite3_get_autocommit(this.db.pDb)) {
+			return;
+		}
+		try {
+			this.optimize();
+		} catch (e) {
+			this.options.onError?.(e);
+		}
+	}
+
+	// stops the timer, close() runs a last optimize before closing the connection
+	public stop(): void {
+		if (this.timer !== undefined) {
+			clearInterval(this.timer);
+			this.timer = undefined;
+		}
+	}
+}
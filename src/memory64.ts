@@ -0,0 +1,68 @@
+import { pointerSignatures, SQLiteExports, SQLiteExports64, SQLiteImports, SQLiteImports64 } from "./api";
+
+// export of memory64 builds, see sqlite3wasm.c
+const MEMORY64_MARKER = "sqlite3_ext_memory64";
+
+export function isMemory64(module: WebAssembly.Module): boolean {
+	return WebAssembly.Module.exports(module).some((e) => e.name === MEMORY64_MARKER);
+}
+
+export function isMemory64Instance(exports: WebAssembly.Exports): boolean {
+	return typeof exports[MEMORY64_MARKER] === "function";
+}
+
+// positions of the pointer arguments and whether the result is one, undefined when none is
+function pointerPositions(name: string): { args: number[]; ret: boolean } | undefined {
+	const signature = pointerSignatures[name];
+	if (signature === undefined) {
+		return undefined;
+	}
+	const [ret, args] = signature.split(":");
+	const positions: number[] = [];
+	for (let i = 0; i < args.length; i++) {
+		if (args[i] === "p") {
+			positions.push(i);
+		}
+	}
+	if (positions.length === 0 && ret !== "p") {
+		return undefined;
+	}
+	return { args: positions, ret: ret === "p" };
+}
+
+type WasmFunction = (...values: unknown[]) => unknown;
+
+// Number pointers stay exact up to 2^53, far beyond any memory64 engine limit.
+function wrap(fn: WasmFunction, args: number[], ret: boolean, toArg: (v: unknown) => unknown, toRet: (v: unknown) => unknown): WasmFunction {
+	return (...values: unknown[]) => {
+		for (const i of args) {
+			values[i] = toArg(values[i]);
+		}
+		const result = fn(...values);
+		return ret ? toRet(result) : result;
+	};
+}
+
+const toBigInt = (v: unknown) => BigInt(v as number);
+const toNumber = (v: unknown) => Number(v);
+
+// Exports of a memory64 instance with the Number pointers of the wasm32 SQLiteExports, so the
+// rest of the library runs unchanged. Exports without pointers are passed through.
+export function adaptExports64(exports: SQLiteExports64): SQLiteExports {
+	const adapted: Record<string, unknown> = {};
+	for (const [name, value] of Object.entries(exports)) {
+		const positions = typeof value === "function" ? pointerPositions(name) : undefined;
+		adapted[name] = positions === undefined ? value : wrap(value as WasmFunction, positions.args, positions.ret, toBigInt, toNumber);
+	}
+	return adapted as SQLiteExports;
+}
+
+// Imports written against SQLiteImports for a memory64 instance.
+export function adaptImports64(imports: SQLiteImports): SQLiteImports64 {
+	const adapted: Record<string, unknown> = {};
+	for (const [name, value] of Object.entries(imports)) {
+		const positions = pointerPositions(name);
+		adapted[name] = positions === undefined ? value : wrap(value as WasmFunction, positions.args, positions.ret, toNumber, toBigInt);
+	}
+	return adapted as unknown as SQLiteImports64;
+}
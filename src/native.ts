@@ -0,0 +1,62 @@
+import type { SQLiteExports, SQLiteImports } from "./api";
+import { SQLiteUtils } from "./utils";
+import { SQLiteVFSRegistry } from "./vfs";
+
+// sqlite/sqlite3node.c, the exports of SQLiteExports that the build defines and setImports
+interface NativeAddon {
+	setImports(imports: SQLiteImports): void;
+	[name: string]: unknown;
+}
+
+type NativeFunction = (...values: unknown[]) => unknown;
+
+// a dlopen runs the addon's initializer again, which refuses a second copy of SQLite's globals
+const loaded = new Map<string, SQLiteNativeModule>();
+
+// Node addon from `make native` in place of a WebAssembly.Module for SQLite.instantiate. SQLite
+// runs as native code behind the same exports, pointers are offsets into an arena exposed as
+// memory.buffer. SQLite's heap and VFS list are per process, so every instance of the module
+// shares them and one VFS registry, and the addon can only be loaded by one thread.
+export class SQLiteNativeModule {
+	public readonly vfs: SQLiteVFSRegistry;
+	// imports of the instance that called in last, the addon calls back into them
+	private active: SQLiteImports | undefined;
+
+	private constructor(private readonly addon: NativeAddon) {
+		const utils = new SQLiteUtils(addon as unknown as SQLiteExports);
+		this.vfs = new SQLiteVFSRegistry(() => utils);
+	}
+
+	public static load(filename: string): SQLiteNativeModule {
+		let module = loaded.get(filename);
+		if (module === undefined) {
+			const addon = { exports: {} as NativeAddon };
+			process.dlopen(addon, filename);
+			module = new SQLiteNativeModule(addon.exports);
+			loaded.set(filename, module);
+		}
+		return module;
+	}
+
+	public instantiate(imports: SQLiteImports): WebAssembly.Instance {
+		const exports: Record<string, unknown> = {};
+		for (const [name, value] of Object.entries(this.addon)) {
+			if (name === "setImports") {
+				continue;
+			}
+			if (typeof value !== "function") {
+				exports[name] = value;
+				continue;
+			}
+			const fn = value as NativeFunction;
+			exports[name] = (...values: unknown[]) => {
+				if (this.active !== imports) {
+					this.addon.setImports(imports);
+					this.active = imports;
+				}
+				return fn(...values);
+			};
+		}
+		return { exports } as unknown as WebAssembly.Instance;
+	}
+}
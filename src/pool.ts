@@ -0,0 +1,470 @@
+import type { ScalarIn, ScalarOut, SQLiteExecValue } from "./sqlite";
+import type {
+	SQLiteRowBatch,
+	SQLiteRunResult,
+	SQLiteStatementStats,
+	SQLiteWorkerControl,
+	SQLiteWorkerData,
+	SQLiteWorkerPort,
+	SQLiteWorkerRequest,
+	SQLiteWorkerResponse,
+} from "./worker";
+import { decodeRows } from "./rows";
+import { SQLiteRing, SQLiteRowReader } from "./ring";
+import { SQLiteCancelToken } from "./cancel";
+import { SQLiteError } from "./utils";
+import type { SQLiteSharedImage } from "./vfs";
+
+type DistributiveOmit<T, K extends keyof any> = T extends any ? Omit<T, K> : never;
+
+export interface SQLiteRows {
+	columns: string[];
+	rows: ScalarOut[][];
+	stats?: SQLiteStatementStats;
+}
+
+export interface SQLiteRequestOptions {
+	// aborting interrupts the statement in the worker at its next progress check
+	signal?: AbortSignal;
+	// overrides SQLiteWorkerDB.timeoutMs
+	timeoutMs?: number;
+}
+
+export interface SQLiteQueryOptions extends SQLiteRequestOptions {
+	batch?: number;
+	noBigInt?: boolean;
+}
+
+export interface SQLiteStreamOptions extends SQLiteRequestOptions {
+	// ring capacity in bytes, must be a power of two
+	ringSize?: number;
+	noBigInt?: boolean;
+}
+
+interface PendingRequest {
+	resolve: (value: any) => void;
+	reject: (err: Error) => void;
+}
+
+export class SQLiteWorkerDB {
+	private readonly pending = new Map<number, PendingRequest>();
+	// removes the abort listener of each cancel token handed out by control()
+	private readonly aborts = new Map<SharedArrayBuffer, () => void>();
+	private nextId = 1;
+	private openCursors = 0;
+	// set once the worker failed or exited, later requests reject with it
+	private failure: Error | undefined;
+	public version = 0;
+	// default time limit for exec, run and queries, measured from when the request is sent
+	public timeoutMs: number | undefined;
+
+	constructor(public readonly port: SQLiteWorkerPort) {
+		port.on("message", (res: SQLiteWorkerResponse) => this.settle(res));
+		port.on("error", (err: Error) => this.fail(err));
+		// a worker that exits without an error would otherwise leave its requests pending forever
+		port.on("exit", (code: number) => this.fail(new Error(`SQLite worker exited with code ${code}`)));
+	}
+
+	public get closed(): boolean {
+		return this.failure !== undefined;
+	}
+
+	private fail(err: Error): void {
+		this.failure ??= err;
+		for (const { reject } of this.pending.values()) {
+			reject(err);
+		}
+		this.pending.clear();
+	}
+
+	public get inflight(): number {
+		return this.pending.size;
+	}
+
+	// iterators and streams whose statement is still open in the worker, also between requests
+	public get cursors(): number {
+		return this.openCursors;
+	}
+
+	private settle(res: SQLiteWorkerResponse): void {
+		const pending = this.pending.get(res.id);
+		if (pending === undefined) {
+			return;
+		}
+		this.pending.delete(res.id);
+		this.version = res.version;
+		if (res.error !== undefined) {
+			pending.reject(new SQLiteError(res.error.code, res.error.extendedCode, res.error.message));
+		} else {
+			pending.resolve(res.result);
+		}
+	}
+
+	public request<T>(req: DistributiveOmit<SQLiteWorkerRequest, "id">, transfer: ArrayBuffer[] = []): Promise<T> {
+		if (this.failure !== undefined) {
+			return Promise.reject(this.failure);
+		}
+		const id = this.nextId++;
+		return new Promise<T>((resolve, reject) => {
+			this.pending.set(id, { resolve, reject });
+			this.port.postMessage({ ...req, id }, transfer);
+		});
+	}
+
+	public control(options?: SQLiteRequestOptions): SQLiteWorkerControl {
+		const control: SQLiteWorkerControl = {};
+		const timeoutMs = options?.timeoutMs ?? this.timeoutMs;
+		if (timeoutMs !== undefined) {
+			control.deadline = Date.now() + timeoutMs;
+		}
+		const signal = options?.signal;
+		if (signal !== undefined) {
+			const token = new SQLiteCancelToken();
+			if (signal.aborted) {
+				token.cancel();
+			} else {
+				const abort = () => token.cancel();
+				signal.addEventListener("abort", abort, { once: true });
+				this.aborts.set(token.buffer, () => signal.removeEventListener("abort", abort));
+			}
+			control.cancel = token.buffer;
+		}
+		return control;
+	}
+
+	// detaches a control from its signal once every request using it has settled
+	public release(control: SQLiteWorkerControl): void {
+		if (control.cancel !== undefined) {
+			this.aborts.get(control.cancel)?.();
+			this.aborts.delete(control.cancel);
+		}
+	}
+
+	// a single request under the time limit and signal of options
+	public async send<T>(req: DistributiveOmit<SQLiteWorkerRequest, "id" | keyof SQLiteWorkerControl>, options?: SQLiteRequestOptions): Promise<T> {
+		const control = this.control(options);
+		try {
+			return await this.request<T>({ ...req, ...control });
+		} finally {
+			this.release(control);
+		}
+	}
+
+	public exec(sql: string, options?: SQLiteRequestOptions): Promise<SQLiteExecValue[][]> {
+		return this.send({ op: "exec", sql }, options);
+	}
+
+	public async prepare(sql: string): Promise<SQLiteWorkerStatement> {
+		const stmt = await this.request<number>({ op: "prepare", sql });
+		return new SQLiteWorkerStatement(this, stmt, sql);
+	}
+
+	public run(sql: string, params?: ScalarIn[], options?: SQLiteRequestOptions): Promise<SQLiteRunResult> {
+		return this.send({ op: "run", sql, params }, options);
+	}
+
+	public async all(sql: string, params?: ScalarIn[], options?: SQLiteQueryOptions): Promise<SQLiteRows> {
+		return collect(this.iterateBatches({ op: "query", sql, params, batch: options?.batch ?? Infinity, ...this.control(options) }), options);
+	}
+
+	public iterate(sql: string, params?: ScalarIn[], options?: SQLiteQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+		return rows(this.iterateBatches({ op: "query", sql, params, batch: options?.batch ?? 256, ...this.control(options) }), options);
+	}
+
+	public async *iterateBatches(start: DistributiveOmit<Extract<SQLiteWorkerRequest, { op: "query" }>, "id">): AsyncIterableIterator<SQLiteRowBatch> {
+		this.openCursors++;
+		let batch: SQLiteRowBatch | undefined;
+		try {
+			batch = await this.request<SQLiteRowBatch>(start);
+			yield batch;
+			while (!batch.done) {
+				batch = await this.request<SQLiteRowBatch>({
+					op: "next",
+					stmt: batch.stmt,
+					batch: start.batch,
+					cancel: start.cancel,
+					deadline: start.deadline,
+				});
+				yield batch;
+			}
+		} finally {
+			this.release(start);
+			try {
+				if (batch !== undefined && !batch.done) {
+					await this.request({ op: "reset", stmt: batch.stmt });
+				}
+			} finally {
+				this.openCursors--;
+			}
+		}
+	}
+
+	public stream(sql: string, params?: ScalarIn[], options?: SQLiteStreamOptions): AsyncIterableIterator<ScalarOut[]> {
+		return this.streamRows({ op: "stream", sql, params, ...this.control(options) }, options);
+	}
+
+	// Rows arrive through a SharedArrayBuffer ring as the worker steps, instead of batched messages.
+	public async *streamRows(
+		start: DistributiveOmit<Extract<SQLiteWorkerRequest, { op: "stream" }>, "id" | "ring">,
+		options?: SQLiteStreamOptions,
+	): AsyncIterableIterator<ScalarOut[]> {
+		const ring = SQLiteRing.create(options?.ringSize);
+		this.openCursors++;
+		const done = this.request<number>({ ...start, ring: ring.buffer });
+		// a failed request may never reach the ring, wake the reader up either way
+		done.catch(() => ring.close());
+		const reader = new SQLiteRowReader();
+		try {
+			while (true) {
+				const chunk = await ring.read();
+				if (chunk === null) {
+					break;
+				}
+				reader.push(chunk);
+				yield* reader.rows(options?.noBigInt);
+			}
+		} finally {
+			ring.cancel();
+			try {
+				await done;
+			} finally {
+				this.release(start);
+				this.openCursors--;
+			}
+		}
+	}
+
+	public async serialize(): Promise<ArrayBuffer | null> {
+		return this.request({ op: "serialize" });
+	}
+
+	// the image as of the last commit, undefined while the connection is inside a transaction
+	public snapshot(): Promise<ArrayBuffer | null | undefined> {
+		return this.request({ op: "serialize", committed: true });
+	}
+
+	public deserialize(data: ArrayBuffer, readonly: boolean = false): Promise<void> {
+		return this.request({ op: "deserialize", data, readonly });
+	}
+
+	public async close(): Promise<void> {
+		await this.request({ op: "close" });
+		this.fail(new Error("SQLite worker is closed"));
+		await this.port.terminate?.();
+		this.port.close?.();
+	}
+}
+
+export class SQLiteWorkerStatement {
+	constructor(
+		public readonly db: SQLiteWorkerDB,
+		public readonly stmt: number,
+		public readonly sql: string,
+	) {
+	}
+
+	public run(params?: ScalarIn[], options?: SQLiteRequestOptions): Promise<SQLiteRunResult> {
+		return this.db.send({ op: "run", stmt: this.stmt, params }, options);
+	}
+
+	public all(params?: ScalarIn[], options?: SQLiteQueryOptions): Promise<SQLiteRows> {
+		return collect(this.db.iterateBatches({ op: "query", stmt: this.stmt, params, batch: options?.batch ?? Infinity, ...this.db.control(options) }), options);
+	}
+
+	public iterate(params?: ScalarIn[], options?: SQLiteQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+		return rows(this.db.iterateBatches({ op: "query", stmt: this.stmt, params, batch: options?.batch ?? 256, ...this.db.control(options) }), options);
+	}
+
+	public stream(params?: ScalarIn[], options?: SQLiteStreamOptions): AsyncIterableIterator<ScalarOut[]> {
+		return this.db.streamRows({ op: "stream", stmt: this.stmt, params, ...this.db.control(options) }, options);
+	}
+
+	public finalize(): Promise<void> {
+		return this.db.request({ op: "finalize", stmt: this.stmt });
+	}
+}
+
+async function collect(batches: AsyncIterableIterator<SQLiteRowBatch>, options?: SQLiteQueryOptions): Promise<SQLiteRows> {
+	const result: SQLiteRows = { columns: [], rows: [] };
+	for await (const batch of batches) {
+		result.columns = batch.columns;
+		result.stats = batch.stats;
+		for (const row of decodeRows(batch.rows, batch.columns.length, options?.noBigInt)) {
+			result.rows.push(row);
+		}
+	}
+	return result;
+}
+
+async function* rows(batches: AsyncIterableIterator<SQLiteRowBatch>, options?: SQLiteQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+	for await (const batch of batches) {
+		yield* decodeRows(batch.rows, batch.columns.length, options?.noBigInt);
+	}
+}
+
+export interface SQLitePoolOptions {
+	module: WebAssembly.Module;
+	// script that calls runWorker(), used when no spawn function is given
+	workerScript?: string | URL;
+	spawn?: SQLiteSpawn;
+	readers?: number;
+	filename?: string;
+	image?: ArrayBuffer;
+	// serve every worker from one SharedArrayBuffer instead of per-reader snapshots
+	shared?: SQLiteSharedImage;
+	// PRAGMA cache_size for every worker, keep it small when the image is shared
+	cacheSize?: number;
+	// default SQLiteWorkerDB.timeoutMs for the writer and every reader
+	timeoutMs?: number;
+}
+
+export type SQLiteSpawn = (data: SQLiteWorkerData) => SQLiteWorkerPort;
+
+// the given spawn function, or one that starts workerScript in a worker thread
+export async function resolveSpawn(options: { spawn?: SQLiteSpawn; workerScript?: string | URL }): Promise<SQLiteSpawn> {
+	if (options.spawn !== undefined) {
+		return options.spawn;
+	}
+	if (options.workerScript === undefined) {
+		throw new Error("Workers require either spawn or workerScript");
+	}
+	const { Worker } = await import("worker_threads");
+	const script = options.workerScript;
+	return (workerData) => new Worker(script, { workerData });
+}
+
+export class SQLitePool {
+	private snapshot: Promise<ArrayBuffer | null | undefined> | undefined;
+	private snapshotVersion = -1;
+	private readonly replicaVersions: number[];
+
+	private constructor(
+		public readonly writer: SQLiteWorkerDB,
+		public readonly readers: SQLiteWorkerDB[],
+		public readonly shared: boolean = false,
+	) {
+		this.replicaVersions = readers.map(() => 0);
+	}
+
+	public static async create(options: SQLitePoolOptions): Promise<SQLitePool> {
+		const spawn = await resolveSpawn(options);
+		let readerCount = options.readers;
+		if (readerCount === undefined) {
+			const os = await import("os");
+			readerCount = Math.max(os.cpus().length - 1, 0);
+		}
+		const shared = options.shared?.buffer;
+		const writer = new SQLiteWorkerDB(spawn({
+			module: options.module,
+			filename: options.filename,
+			image: shared === undefined ? options.image : undefined,
+			shared,
+			cacheSize: options.cacheSize,
+		}));
+		const readers: SQLiteWorkerDB[] = [];
+		for (let i = 0; i < readerCount; i++) {
+			readers.push(new SQLiteWorkerDB(spawn({
+				module: options.module,
+				filename: shared === undefined ? undefined : options.filename,
+				image: shared === undefined ? options.image : undefined,
+				shared,
+				readonly: true,
+				cacheSize: options.cacheSize,
+			})));
+		}
+		for (const db of [writer, ...readers]) {
+			db.timeoutMs = options.timeoutMs;
+		}
+		return new SQLitePool(writer, readers, shared !== undefined);
+	}
+
+	private async reader(): Promise<SQLiteWorkerDB> {
+		if (this.readers.length === 0) {
+			return this.writer;
+		}
+		// the least busy reader that can be brought up to date, readers with open cursors keep
+		// their snapshot, so they are only picked when every reader has cursors open
+		let index = -1;
+		for (let i = 0; i < this.readers.length; i++) {
+			if (!this.current(i) && this.readers[i].cursors > 0) {
+				continue;
+			}
+			if (index < 0 || this.readers[i].inflight < this.readers[index].inflight) {
+				index = i;
+			}
+		}
+		if (index < 0) {
+			index = 0;
+			for (let i = 1; i < this.readers.length; i++) {
+				if (this.readers[i].inflight < this.readers[index].inflight) {
+					index = i;
+				}
+			}
+		}
+		await this.refresh(index);
+		return this.readers[index];
+	}
+
+	private current(index: number): boolean {
+		// readers of a shared image see committed writes as soon as they take a SHARED lock
+		return this.shared || this.replicaVersions[index] === this.writer.version;
+	}
+
+	// Brings reader index up to the writer's last commit. Deserializing would close the open
+	// cursors of the reader, and the snapshot waits while the writer is inside a transaction,
+	// the reader keeps its older snapshot in both cases.
+	public async refresh(index: number): Promise<void> {
+		const version = this.writer.version;
+		if (this.current(index) || this.readers[index].cursors > 0) {
+			return;
+		}
+		if (this.snapshot === undefined || this.snapshotVersion !== version) {
+			this.snapshot = this.writer.snapshot();
+			this.snapshotVersion = version;
+		}
+		const snapshot = this.snapshot;
+		const data = await snapshot;
+		if (data === undefined) {
+			if (this.snapshot === snapshot) {
+				this.snapshot = undefined;
+			}
+			return;
+		}
+		if (this.readers[index].cursors > 0) {
+			return;
+		}
+		if (data !== null) {
+			// every replica gets its own copy, the cached snapshot is shared
+			await this.readers[index].deserialize(data.slice(0), true);
+		}
+		this.replicaVersions[index] = version;
+	}
+
+	public sync(): Promise<void> {
+		return Promise.all(this.readers.map((_, i) => this.refresh(i))).then(() => undefined);
+	}
+
+	public exec(sql: string, options?: SQLiteRequestOptions): Promise<SQLiteExecValue[][]> {
+		return this.writer.exec(sql, options);
+	}
+
+	public run(sql: string, params?: ScalarIn[], options?: SQLiteRequestOptions): Promise<SQLiteRunResult> {
+		return this.writer.run(sql, params, options);
+	}
+
+	public async all(sql: string, params?: ScalarIn[], options?: SQLiteQueryOptions): Promise<SQLiteRows> {
+		return (await this.reader()).all(sql, params, options);
+	}
+
+	public async *iterate(sql: string, params?: ScalarIn[], options?: SQLiteQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+		yield* (await this.reader()).iterate(sql, params, options);
+	}
+
+	public async *stream(sql: string, params?: ScalarIn[], options?: SQLiteStreamOptions): AsyncIterableIterator<ScalarOut[]> {
+		yield* (await this.reader()).stream(sql, params, options);
+	}
+
+	public async close(): Promise<void> {
+		await Promise.all([this.writer, ...this.readers].map((db) => db.close()));
+	}
+}
@@ -0,0 +1,198 @@
+import type { ScalarOut } from "./sqlite";
+import { decodeRow, measureRow } from "./rows";
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError } from "./utils";
+
+// Header of a ring, in Int32 slots. HEAD and TAIL are free running byte counters,
+// DATA and SPACE are bumped on every publish so waiters never miss a wakeup.
+const RING_HEAD = 0;
+const RING_TAIL = 1;
+const RING_STATE = 2;
+const RING_DATA = 3;
+const RING_SPACE = 4;
+const RING_HEADER_BYTES = 64;
+
+const RING_OPEN = 0;
+const RING_CLOSED = 1;
+const RING_CANCELLED = 2;
+
+type WaitAsync = (typedArray: Int32Array, index: number, value: number) => { async: boolean; value: Promise<string> | string };
+const waitAsync = (Atomics as unknown as { waitAsync?: WaitAsync }).waitAsync;
+
+// Single producer, single consumer byte ring over a SharedArrayBuffer.
+// The producer blocks with Atomics.wait when the ring is full, the consumer
+// waits with Atomics.waitAsync so it can live on the main thread.
+export class SQLiteRing {
+	public readonly header: Int32Array;
+	public readonly data: Uint8Array;
+	public readonly capacity: number;
+
+	constructor(public readonly buffer: SharedArrayBuffer) {
+		this.header = new Int32Array(buffer, 0, RING_HEADER_BYTES / 4);
+		this.data = new Uint8Array(buffer, RING_HEADER_BYTES);
+		this.capacity = this.data.length;
+		if (this.capacity === 0 || (this.capacity & (this.capacity - 1)) !== 0) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "Ring capacity must be a power of two");
+		}
+	}
+
+	public static create(capacity: number = 1 << 20): SQLiteRing {
+		return new SQLiteRing(new SharedArrayBuffer(RING_HEADER_BYTES + capacity));
+	}
+
+	public get available(): number {
+		return (Atomics.load(this.header, RING_HEAD) - Atomics.load(this.header, RING_TAIL)) | 0;
+	}
+
+	public get closed(): boolean {
+		return Atomics.load(this.header, RING_STATE) === RING_CLOSED;
+	}
+
+	public get cancelled(): boolean {
+		return Atomics.load(this.header, RING_STATE) === RING_CANCELLED;
+	}
+
+	// Blocks until all of bytes is written, returns false if the consumer cancelled.
+	public write(bytes: Uint8Array): boolean {
+		const header = this.header;
+		const mask = this.capacity - 1;
+		let written = 0;
+		while (written < bytes.length) {
+			const space = Atomics.load(header, RING_SPACE);
+			if (Atomics.load(header, RING_STATE) === RING_CANCELLED) {
+				return false;
+			}
+			const head = Atomics.load(header, RING_HEAD);
+			const free = this.capacity - ((head - Atomics.load(header, RING_TAIL)) | 0);
+			if (free === 0) {
+				Atomics.wait(header, RING_SPACE, space);
+				continue;
+			}
+			const n = Math.min(free, bytes.length - written);
+			const start = (head >>> 0) & mask;
+			const first = Math.min(n, this.capacity - start);
+			this.data.set(bytes.subarray(written, written + first), start);
+			if (first < n) {
+				this.data.set(bytes.subarray(written + first, written + n), 0);
+			}
+			written += n;
+			Atomics.store(header, RING_HEAD, (head + n) | 0);
+			Atomics.add(header, RING_DATA, 1);
+			Atomics.notify(header, RING_DATA);
+		}
+		return true;
+	}
+
+	// Copies out everything currently readable, null if the ring is empty.
+	public tryRead(): Uint8Array | null {
+		const header = this.header;
+		const tail = Atomics.load(header, RING_TAIL);
+		const n = (Atomics.load(header, RING_HEAD) - tail) | 0;
+		if (n === 0) {
+			return null;
+		}
+		const start = (tail >>> 0) & (this.capacity - 1);
+		const first = Math.min(n, this.capacity - start);
+		const out = new Uint8Array(n);
+		out.set(this.data.subarray(start, start + first));
+		if (first < n) {
+			out.set(this.data.subarray(0, n - first), first);
+		}
+		Atomics.store(header, RING_TAIL, (tail + n) | 0);
+		Atomics.add(header, RING_SPACE, 1);
+		Atomics.notify(header, RING_SPACE);
+		return out;
+	}
+
+	// Resolves with the next chunk, or null once the producer closed the ring and it is drained.
+	public async read(): Promise<Uint8Array | null> {
+		while (true) {
+			const seq = Atomics.load(this.header, RING_DATA);
+			const chunk = this.tryRead();
+			if (chunk !== null) {
+				return chunk;
+			}
+			if (Atomics.load(this.header, RING_STATE) !== RING_OPEN) {
+				return null;
+			}
+			if (waitAsync !== undefined) {
+				const result = waitAsync(this.header, RING_DATA, seq);
+				if (result.async) {
+					await result.value;
+				}
+			} else {
+				await new Promise((resolve) => setTimeout(resolve, 1));
+			}
+		}
+	}
+
+	public close(): void {
+		Atomics.compareExchange(this.header, RING_STATE, RING_OPEN, RING_CLOSED);
+		Atomics.add(this.header, RING_DATA, 1);
+		Atomics.notify(this.header, RING_DATA);
+	}
+
+	public cancel(): void {
+		Atomics.compareExchange(this.header, RING_STATE, RING_OPEN, RING_CANCELLED);
+		Atomics.add(this.header, RING_SPACE, 1);
+		Atomics.notify(this.header, RING_SPACE);
+	}
+}
+
+// Incrementally decodes a row stream: a u32 column count, the column names
+// as one packed row of text cells, then packed rows.
+export class SQLiteRowReader {
+	private buf = new Uint8Array(0);
+	private start = 0;
+	private end = 0;
+	public columns: string[] | undefined;
+
+	public push(chunk: Uint8Array): void {
+		const pending = this.end - this.start;
+		if (this.end + chunk.length > this.buf.length) {
+			if (pending + chunk.length > this.buf.length) {
+				const buf = new Uint8Array(Math.max(pending + chunk.length, this.buf.length * 2));
+				buf.set(this.buf.subarray(this.start, this.end));
+				this.buf = buf;
+			} else {
+				this.buf.copyWithin(0, this.start, this.end);
+			}
+			this.start = 0;
+			this.end = pending;
+		}
+		this.buf.set(chunk, this.end);
+		this.end += chunk.length;
+	}
+
+	public *rows(noBigInt: boolean = false): Generator<ScalarOut[]> {
+		const view = new DataView(this.buf.buffer, this.buf.byteOffset, this.buf.byteLength);
+		if (this.columns === undefined) {
+			if (this.end - this.start < 4) {
+				return;
+			}
+			const count = view.getUint32(this.start, true);
+			const next = measureRow(view, this.start + 4, this.end, count);
+			if (next < 0) {
+				return;
+			}
+			const columns: ScalarOut[] = [];
+			decodeRow(view, this.start + 4, count, noBigInt, columns);
+			this.columns = columns as string[];
+			this.start = next;
+		}
+		const columnCount = this.columns.length;
+		if (columnCount === 0) {
+			return;
+		}
+		while (true) {
+			const next = measureRow(view, this.start, this.end, columnCount);
+			if (next < 0) {
+				return;
+			}
+			const row: ScalarOut[] = [];
+			decodeRow(view, this.start, columnCount, noBigInt, row);
+			this.start = next;
+			yield row;
+		}
+	}
+}
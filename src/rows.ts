@@ -0,0 +1,191 @@
+import { SQLiteDatatypes } from "./constants";
+import type { ScalarOut, SQLiteStatement } from "./sqlite";
+
+// Packed row format: every cell is a one byte tag followed by its payload.
+// Integers and floats are 8 bytes, text and blobs are a u32 length and the raw bytes.
+export const SQLiteRowTags = {
+	NULL: 0,
+	INTEGER: 1,
+	FLOAT: 2,
+	TEXT: 3,
+	BLOB: 4,
+} as const;
+
+export class SQLiteRowWriter {
+	private buf: ArrayBuffer;
+	private view: DataView;
+	private u8: Uint8Array;
+	public length = 0;
+	public count = 0;
+
+	constructor(initialSize: number = 65536) {
+		this.buf = new ArrayBuffer(initialSize);
+		this.view = new DataView(this.buf);
+		this.u8 = new Uint8Array(this.buf);
+	}
+
+	private reserve(n: number): void {
+		if (this.length + n <= this.buf.byteLength) {
+			return;
+		}
+		let size = this.buf.byteLength * 2;
+		while (size < this.length + n) {
+			size *= 2;
+		}
+		const buf = new ArrayBuffer(size);
+		const u8 = new Uint8Array(buf);
+		u8.set(this.u8.subarray(0, this.length));
+		this.buf = buf;
+		this.view = new DataView(buf);
+		this.u8 = u8;
+	}
+
+	private writeBytes(tag: number, bytes: Uint8Array): void {
+		this.reserve(5 + bytes.length);
+		this.u8[this.length] = tag;
+		this.view.setUint32(this.length + 1, bytes.length, true);
+		this.u8.set(bytes, this.length + 5);
+		this.length += 5 + bytes.length;
+	}
+
+	public writeRow(stmt: SQLiteStatement): void {
+		const exports = stmt.exports;
+		const pStmt = stmt.pStmt;
+		const count = exports.sqlite3_column_count(pStmt);
+		for (let i = 0; i < count; i++) {
+			const type = exports.sqlite3_column_type(pStmt, i);
+			switch (type) {
+				case SQLiteDatatypes.SQLITE_INTEGER:
+					this.reserve(9);
+					this.u8[this.length] = SQLiteRowTags.INTEGER;
+					this.view.setBigInt64(this.length + 1, exports.sqlite3_column_int64(pStmt, i), true);
+					this.length += 9;
+					break;
+				case SQLiteDatatypes.SQLITE_FLOAT:
+					this.reserve(9);
+					this.u8[this.length] = SQLiteRowTags.FLOAT;
+					this.view.setFloat64(this.length + 1, exports.sqlite3_column_double(pStmt, i), true);
+					this.length += 9;
+					break;
+				case SQLiteDatatypes.SQLITE_TEXT: {
+					const ptr = exports.sqlite3_column_text(pStmt, i);
+					const len = exports.sqlite3_column_bytes(pStmt, i);
+					this.writeBytes(SQLiteRowTags.TEXT, stmt.utils.u8.subarray(ptr, ptr + len));
+					break;
+				}
+				case SQLiteDatatypes.SQLITE_BLOB: {
+					const ptr = exports.sqlite3_column_blob(pStmt, i);
+					const len = exports.sqlite3_column_bytes(pStmt, i);
+					this.writeBytes(SQLiteRowTags.BLOB, stmt.utils.u8.subarray(ptr, ptr + len));
+					break;
+				}
+				default:
+					this.reserve(1);
+					this.u8[this.length] = SQLiteRowTags.NULL;
+					this.length += 1;
+					break;
+			}
+		}
+		this.count++;
+	}
+
+	public writeText(values: string[]): void {
+		for (const value of values) {
+			this.writeBytes(SQLiteRowTags.TEXT, textEncoder.encode(value));
+		}
+		this.count++;
+	}
+
+	// view of the rows written so far, valid until the next write or reset
+	public bytes(): Uint8Array {
+		return this.u8.subarray(0, this.length);
+	}
+
+	public reset(): void {
+		this.length = 0;
+		this.count = 0;
+	}
+
+	public finish(): ArrayBuffer {
+		const out = this.buf.slice(0, this.length);
+		this.reset();
+		return out;
+	}
+}
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+// returns the offset past the row starting at offset, or -1 if it extends beyond end
+export function measureRow(view: DataView, offset: number, end: number, columnCount: number): number {
+	for (let i = 0; i < columnCount; i++) {
+		if (offset >= end) {
+			return -1;
+		}
+		const tag = view.getUint8(offset);
+		offset += 1;
+		switch (tag) {
+			case SQLiteRowTags.INTEGER:
+			case SQLiteRowTags.FLOAT:
+				offset += 8;
+				break;
+			case SQLiteRowTags.TEXT:
+			case SQLiteRowTags.BLOB:
+				if (offset + 4 > end) {
+					return -1;
+				}
+				offset += 4 + view.getUint32(offset, true);
+				break;
+		}
+	}
+	return offset <= end ? offset : -1;
+}
+
+export function decodeRow(view: DataView, offset: number, columnCount: number, noBigInt: boolean, out: ScalarOut[]): number {
+	const u8 = new Uint8Array(view.buffer, view.byteOffset, view.byteLength);
+	for (let i = 0; i < columnCount; i++) {
+		const tag = u8[offset];
+		offset += 1;
+		switch (tag) {
+			case SQLiteRowTags.INTEGER: {
+				const value = view.getBigInt64(offset, true);
+				out.push(noBigInt ? Number(value) : value);
+				offset += 8;
+				break;
+			}
+			case SQLiteRowTags.FLOAT:
+				out.push(view.getFloat64(offset, true));
+				offset += 8;
+				break;
+			case SQLiteRowTags.TEXT: {
+				const len = view.getUint32(offset, true);
+				out.push(textDecoder.decode(u8.subarray(offset + 4, offset + 4 + len)));
+				offset += 4 + len;
+				break;
+			}
+			case SQLiteRowTags.BLOB: {
+				const len = view.getUint32(offset, true);
+				out.push(u8.slice(offset + 4, offset + 4 + len).buffer);
+				offset += 4 + len;
+				break;
+			}
+			default:
+				out.push(null);
+				break;
+		}
+	}
+	return offset;
+}
+
+export function* decodeRows(buf: ArrayBuffer, columnCount: number, noBigInt: boolean = false): Generator<ScalarOut[]> {
+	if (columnCount === 0) {
+		return;
+	}
+	const view = new DataView(buf);
+	let offset = 0;
+	while (offset < buf.byteLength) {
+		const row: ScalarOut[] = [];
+		offset = decodeRow(view, offset, columnCount, noBigInt, row);
+		yield row;
+	}
+}
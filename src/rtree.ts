@@ -0,0 +1,43 @@
+import type { SQLiteDB } from "./sqlite";
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError } from "./utils";
+
+// Inserts rows into an R*Tree table from one buffer, each row is the id and then the minimum and
+// maximum of every dimension, the layout of `CREATE VIRTUAL TABLE ... USING rtree(id, minX, maxX, ...)`.
+// R*Tree and Geopoly need a build with SQLITE_ENABLE_RTREE such as `make full`. Tables with
+// auxiliary "+name" columns still need INSERT statements.
+export function loadRTree(db: SQLiteDB, table: string, rows: Float64Array, dimensions: number): void {
+	if (typeof db.exports.sqlite3_ext_rtree_load !== "function") {
+		throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "R*Tree needs a build with SQLITE_ENABLE_RTREE, see `make full`");
+	}
+	const columns = 1 + dimensions * 2;
+	if (rows.length % columns !== 0) {
+		throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, `Expected rows of ${columns} values`);
+	}
+	if (rows.length === 0) {
+		return;
+	}
+	const utils = db.utils;
+	const zTable = utils.cString(table);
+	const pRows = utils.malloc(rows.byteLength);
+	if (pRows === 0) {
+		utils.free(zTable);
+		throw new SQLiteError(SQLiteResultCodes.SQLITE_NOMEM);
+	}
+	utils.f64.set(rows, pRows / 8);
+	db.exec("SAVEPOINT rtree_load");
+	try {
+		const rc = db.exports.sqlite3_ext_rtree_load(db.pDb, zTable, columns, rows.length / columns, pRows);
+		if (rc === SQLiteResultCodes.SQLITE_MISMATCH) {
+			throw new SQLiteError(rc, undefined, "R*Tree ids must be integers within the range of a 64-bit integer");
+		}
+		utils.checkError(rc, db.pDb);
+	} catch (e) {
+		db.exec("ROLLBACK TO rtree_load; RELEASE rtree_load");
+		throw e;
+	} finally {
+		utils.free(pRows);
+		utils.free(zTable);
+	}
+	db.exec("RELEASE rtree_load");
+}
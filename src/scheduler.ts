@@ -0,0 +1,383 @@
+import type { ScalarIn } from "./sqlite";
+import type { SQLitePool, SQLiteQueryOptions, SQLiteRows, SQLiteWorkerDB } from "./pool";
+import type { SQLiteStatementStats } from "./worker";
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError } from "./utils";
+
+export interface SQLiteQueryClass {
+	// lower values are dispatched first
+	priority: number;
+	// most queries of the class running at once, fast queries are not counted
+	concurrency?: number;
+	// running queries may be interrupted and requeued to free a worker for a higher priority
+	preemptible?: boolean;
+	// time limit measured from submission, so queueing counts against it
+	timeoutMs?: number;
+}
+
+export interface SQLiteSchedulerOptions {
+	classes: Record<string, SQLiteQueryClass>;
+	// class of queries that do not name one, defaults to the first
+	defaultClass?: string;
+	// statements averaging fewer VM steps than this skip class limits and may use the fast lanes
+	fastSteps?: number;
+	// workers that only run fast statements, at least one worker is always left for the rest
+	fastLanes?: number;
+	// weight of the latest run in the cost averages
+	alpha?: number;
+	// most statements to keep cost history for
+	historySize?: number;
+}
+
+export interface SQLiteScheduledOptions extends SQLiteQueryOptions {
+	class?: string;
+}
+
+// moving averages over completed runs of one SQL text
+export interface SQLiteStatementCost {
+	vmSteps: number;
+	fullscanSteps: number;
+	ms: number;
+	runs: number;
+}
+
+export interface SQLiteClassMetrics {
+	queued: number;
+	running: number;
+	completed: number;
+	failed: number;
+	preempted: number;
+	fast: number;
+	// over the most recent dispatches, in ms
+	queueP50: number;
+	queueP95: number;
+	queueMax: number;
+}
+
+// queue time samples kept per class for the percentiles
+const QUEUE_SAMPLES = 256;
+
+interface ClassState {
+	name: string;
+	spec: SQLiteQueryClass;
+	queue: Job[];
+	running: number;
+	// running queries that count against spec.concurrency
+	limited: number;
+	completed: number;
+	failed: number;
+	preempted: number;
+	fast: number;
+	samples: number[];
+	nextSample: number;
+}
+
+interface Job {
+	sql: string;
+	params: ScalarIn[] | undefined;
+	options: SQLiteScheduledOptions;
+	cls: ClassState;
+	enqueued: number;
+	started: number;
+	deadline: number | undefined;
+	resolve: (rows: SQLiteRows) => void;
+	reject: (err: Error) => void;
+	cleanup: () => void;
+	controller: AbortController | undefined;
+	fast: boolean;
+	preempted: boolean;
+}
+
+// Dispatches reads over the workers of a pool, one query per worker at a time, so a long scan
+// never sits in front of a point query in a worker's message queue. Statements are classified
+// by the sqlite3_stmt_status history of their SQL text.
+export class SQLiteScheduler {
+	private readonly classes: ClassState[];
+	private readonly byName = new Map<string, ClassState>();
+	private readonly defaultClass: ClassState;
+	private readonly workers: SQLiteWorkerDB[];
+	private readonly busy: (Job | undefined)[];
+	private readonly fastLanes: number;
+	private readonly fastSteps: number;
+	private readonly alpha: number;
+	private readonly historySize: number;
+	private readonly history = new Map<string, SQLiteStatementCost>();
+
+	constructor(public readonly pool: SQLitePool, options: SQLiteSchedulerOptions) {
+		this.classes = Object.entries(options.classes).map(([name, spec]) => ({
+			name,
+			spec,
+			queue: [],
+			running: 0,
+			limited: 0,
+			completed: 0,
+			failed: 0,
+			preempted: 0,
+			fast: 0,
+			samples: [],
+			nextSample: 0,
+		}));
+		if (this.classes.length === 0) {
+			throw new Error("SQLiteScheduler requires at least one class");
+		}
+		for (const cls of this.classes) {
+			this.byName.set(cls.name, cls);
+		}
+		this.defaultClass = this.classOf(options.defaultClass ?? this.classes[0].name);
+		this.classes.sort((a, b) => a.spec.priority - b.spec.priority);
+		this.workers = pool.readers.length > 0 ? pool.readers : [pool.writer];
+		this.busy = this.workers.map(() => undefined);
+		this.fastLanes = Math.min(options.fastLanes ?? 1, this.workers.length - 1);
+		this.fastSteps = options.fastSteps ?? 10000;
+		this.alpha = options.alpha ?? 0.2;
+		this.historySize = options.historySize ?? 1024;
+	}
+
+	private classOf(name: string): ClassState {
+		const cls = this.byName.get(name);
+		if (cls === undefined) {
+			throw new Error(`Unknown query class ${name}`);
+		}
+		return cls;
+	}
+
+	public cost(sql: string): SQLiteStatementCost | undefined {
+		return this.history.get(sql);
+	}
+
+	public isFast(sql: string): boolean {
+		const cost = this.history.get(sql);
+		return cost !== undefined && cost.vmSteps < this.fastSteps;
+	}
+
+	public all(sql: string, params?: ScalarIn[], options: SQLiteScheduledOptions = {}): Promise<SQLiteRows> {
+		const cls = options.class === undefined ? this.defaultClass : this.classOf(options.class);
+		return new Promise<SQLiteRows>((resolve, reject) => {
+			const signal = options.signal;
+			const timeoutMs = options.timeoutMs ?? cls.spec.timeoutMs;
+			const job: Job = {
+				sql,
+				params,
+				options,
+				cls,
+				enqueued: performance.now(),
+				started: 0,
+				deadline: timeoutMs === undefined ? undefined : Date.now() + timeoutMs,
+				resolve,
+				reject,
+				cleanup: () => {},
+				controller: undefined,
+				fast: false,
+				preempted: false,
+			};
+			if (signal?.aborted) {
+				this.fail(job, "cancelled");
+				return;
+			}
+			const onAbort = () => {
+				if (job.controller !== undefined) {
+					job.controller.abort();
+				} else if (this.dequeue(job)) {
+					this.fail(job, "cancelled");
+				}
+			};
+			signal?.addEventListener("abort", onAbort, { once: true });
+			const timer = timeoutMs === undefined ? undefined : setTimeout(() => {
+				// a running query is interrupted by its own deadline in the worker
+				if (job.controller === undefined && this.dequeue(job)) {
+					this.fail(job, "deadline exceeded");
+				}
+			}, timeoutMs);
+			job.cleanup = () => {
+				signal?.removeEventListener("abort", onAbort);
+				clearTimeout(timer);
+			};
+			cls.queue.push(job);
+			this.pump();
+		});
+	}
+
+	public metrics(): Record<string, SQLiteClassMetrics> {
+		const result: Record<string, SQLiteClassMetrics> = {};
+		for (const cls of this.classes) {
+			const samples = cls.samples.slice().sort((a, b) => a - b);
+			const percentile = (p: number) => samples.length === 0 ? 0 : samples[Math.min(Math.floor(samples.length * p), samples.length - 1)];
+			result[cls.name] = {
+				queued: cls.queue.length,
+				running: cls.running,
+				completed: cls.completed,
+				failed: cls.failed,
+				preempted: cls.preempted,
+				fast: cls.fast,
+				queueP50: percentile(0.5),
+				queueP95: percentile(0.95),
+				queueMax: samples.length === 0 ? 0 : samples[samples.length - 1],
+			};
+		}
+		return result;
+	}
+
+	private dequeue(job: Job): boolean {
+		const index = job.cls.queue.indexOf(job);
+		if (index < 0) {
+			return false;
+		}
+		job.cls.queue.splice(index, 1);
+		return true;
+	}
+
+	private fail(job: Job, reason: string): void {
+		job.cleanup();
+		job.cls.failed++;
+		job.reject(new SQLiteError(SQLiteResultCodes.SQLITE_INTERRUPT, SQLiteResultCodes.SQLITE_INTERRUPT, reason));
+	}
+
+	// Fast statements prefer the reserved lanes, everything else only runs on the shared workers.
+	private place(job: Job, fast: boolean): number {
+		const { spec, limited } = job.cls;
+		if (!fast && spec.concurrency !== undefined && limited >= spec.concurrency) {
+			return -1;
+		}
+		const shared = this.workers.length - this.fastLanes;
+		if (fast) {
+			for (let i = shared; i < this.workers.length; i++) {
+				if (this.busy[i] === undefined) {
+					return i;
+				}
+			}
+		}
+		for (let i = 0; i < shared; i++) {
+			if (this.busy[i] === undefined) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	private pump(): void {
+		const blocked: Job[] = [];
+		for (const cls of this.classes) {
+			for (let i = 0; i < cls.queue.length; i++) {
+				const job = cls.queue[i];
+				const fast = this.isFast(job.sql);
+				const worker = this.place(job, fast);
+				if (worker < 0) {
+					const { concurrency } = cls.spec;
+					if (fast || concurrency === undefined || cls.limited < concurrency) {
+						blocked.push(job);
+					}
+					continue;
+				}
+				cls.queue.splice(i--, 1);
+				this.execute(job, worker, fast);
+			}
+		}
+		this.preempt(blocked);
+	}
+
+	// Interrupts the lowest priority, most recently started preemptible query for each blocked job
+	// that is not already waiting on an earlier preemption.
+	private preempt(blocked: Job[]): void {
+		let pending = this.busy.filter((job) => job?.preempted).length;
+		for (const job of blocked) {
+			if (pending > 0) {
+				pending--;
+				continue;
+			}
+			let victim: Job | undefined;
+			for (let i = 0; i < this.workers.length - this.fastLanes; i++) {
+				const running = this.busy[i];
+				if (running === undefined || running.preempted || !running.cls.spec.preemptible || running.cls.spec.priority <= job.cls.spec.priority) {
+					continue;
+				}
+				if (victim === undefined || running.cls.spec.priority > victim.cls.spec.priority ||
+					(running.cls.spec.priority === victim.cls.spec.priority && running.started > victim.started)) {
+					victim = running;
+				}
+			}
+			if (victim === undefined) {
+				return;
+			}
+			victim.preempted = true;
+			victim.controller!.abort();
+		}
+	}
+
+	private async execute(job: Job, worker: number, fast: boolean): Promise<void> {
+		const { cls } = job;
+		const started = performance.now();
+		cls.samples[cls.nextSample] = started - job.enqueued;
+		cls.nextSample = (cls.nextSample + 1) % QUEUE_SAMPLES;
+		this.busy[worker] = job;
+		job.controller = new AbortController();
+		job.fast = fast;
+		job.started = started;
+		cls.running++;
+		if (fast) {
+			cls.fast++;
+		} else {
+			cls.limited++;
+		}
+		let rows: SQLiteRows | undefined;
+		let error: unknown;
+		try {
+			if (this.workers === this.pool.readers) {
+				await this.pool.refresh(worker);
+			}
+			const timeoutMs = job.deadline === undefined ? undefined : Math.max(job.deadline - Date.now(), 0);
+			rows = await this.workers[worker].all(job.sql, job.params, { ...job.options, signal: job.controller.signal, timeoutMs });
+		} catch (e) {
+			error = e;
+		}
+		this.busy[worker] = undefined;
+		job.controller = undefined;
+		cls.running--;
+		if (!fast) {
+			cls.limited--;
+		}
+		if (rows !== undefined) {
+			this.record(job.sql, rows.stats, performance.now() - started);
+			job.cleanup();
+			cls.completed++;
+			job.resolve(rows);
+		} else if (job.preempted && interrupted(error) && !job.options.signal?.aborted && (job.deadline === undefined || Date.now() < job.deadline)) {
+			// back to the front of its class, it restarts from scratch once a worker frees up
+			job.preempted = false;
+			job.enqueued = performance.now();
+			cls.preempted++;
+			cls.queue.unshift(job);
+		} else {
+			job.cleanup();
+			cls.failed++;
+			job.reject(error as Error);
+		}
+		this.pump();
+	}
+
+	private record(sql: string, stats: SQLiteStatementStats | undefined, ms: number): void {
+		if (stats === undefined) {
+			return;
+		}
+		const cost = this.history.get(sql);
+		if (cost === undefined) {
+			if (this.history.size >= this.historySize) {
+				this.history.delete(this.history.keys().next().value!);
+			}
+			this.history.set(sql, { vmSteps: stats.vmSteps, fullscanSteps: stats.fullscanSteps, ms, runs: 1 });
+			return;
+		}
+		const alpha = this.alpha;
+		cost.vmSteps += alpha * (stats.vmSteps - cost.vmSteps);
+		cost.fullscanSteps += alpha * (stats.fullscanSteps - cost.fullscanSteps);
+		cost.ms += alpha * (ms - cost.ms);
+		cost.runs++;
+		// keep recently used statements at the end, the oldest is evicted first
+		this.history.delete(sql);
+		this.history.set(sql, cost);
+	}
+}
+
+// errors that came from the preemption, others fail the job even when it was preempted
+function interrupted(e: unknown): boolean {
+	return e instanceof SQLiteError && e.code === SQLiteResultCodes.SQLITE_INTERRUPT;
+}
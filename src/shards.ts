@@ -0,0 +1,329 @@
+import type { ScalarIn, ScalarOut, SQLiteExecValue } from "./sqlite";
+import type { SQLiteRowBatch, SQLiteRunResult } from "./worker";
+import { resolveSpawn, SQLiteQueryOptions, SQLiteRows, SQLiteSpawn, SQLiteWorkerDB } from "./pool";
+import { decodeRows } from "./rows";
+
+export type SQLiteShardAggregate = "count" | "sum" | "min" | "max";
+
+export interface SQLiteShardOrder {
+	column: number;
+	desc?: boolean;
+}
+
+export interface SQLiteShardQueryOptions extends SQLiteQueryOptions {
+	// every shard returns its rows sorted by these columns, the merged rows keep that order
+	orderBy?: (number | SQLiteShardOrder)[];
+	// Partial aggregates by column index, rows with equal values in the other columns are
+	// combined. Shards must sort by the group columns, which are the default orderBy.
+	aggregates?: Record<number, SQLiteShardAggregate>;
+	limit?: number;
+}
+
+export interface SQLiteShardsOptions {
+	module: WebAssembly.Module;
+	workerScript?: string | URL;
+	spawn?: SQLiteSpawn;
+	// one worker per image
+	images: (ArrayBuffer | undefined)[];
+	cacheSize?: number;
+	timeoutMs?: number;
+}
+
+// SQLite sort order: NULL, numbers, text, then blobs. Text compares by code point like BINARY
+// collation on UTF-8, which differs from UTF-16 code unit order above the surrogates.
+export function compareValues(a: ScalarOut, b: ScalarOut): number {
+	const ra = rank(a);
+	const rb = rank(b);
+	if (ra !== rb) {
+		return ra - rb;
+	}
+	switch (ra) {
+		case 1:
+			return a! < b! ? -1 : a! > b! ? 1 : 0;
+		case 2:
+			return compareText(a as string, b as string);
+		case 3:
+			return compareBlobs(a as ArrayBuffer, b as ArrayBuffer);
+	}
+	return 0;
+}
+
+function rank(v: ScalarOut): number {
+	if (v === null) {
+		return 0;
+	}
+	if (typeof v === "number" || typeof v === "bigint") {
+		return 1;
+	}
+	return typeof v === "string" ? 2 : 3;
+}
+
+function codePointOrder(c: number): number {
+	return c >= 0xd800 && c < 0xe000 ? c + 0x2000 : c >= 0xe000 ? c - 0x800 : c;
+}
+
+function compareText(a: string, b: string): number {
+	const n = Math.min(a.length, b.length);
+	for (let i = 0; i < n; i++) {
+		const x = a.charCodeAt(i);
+		const y = b.charCodeAt(i);
+		if (x !== y) {
+			return codePointOrder(x) - codePointOrder(y);
+		}
+	}
+	return a.length - b.length;
+}
+
+function compareBlobs(a: ArrayBuffer, b: ArrayBuffer): number {
+	const x = new Uint8Array(a);
+	const y = new Uint8Array(b);
+	const n = Math.min(x.length, y.length);
+	for (let i = 0; i < n; i++) {
+		if (x[i] !== y[i]) {
+			return x[i] - y[i];
+		}
+	}
+	return x.length - y.length;
+}
+
+function combine(fn: SQLiteShardAggregate, a: ScalarOut, b: ScalarOut): ScalarOut {
+	if (a === null) {
+		return b;
+	}
+	if (b === null) {
+		return a;
+	}
+	switch (fn) {
+		case "count":
+		case "sum":
+			return typeof a === "bigint" && typeof b === "bigint" ? a + b : Number(a) + Number(b);
+		case "min":
+			return compareValues(a, b) <= 0 ? a : b;
+		case "max":
+			return compareValues(a, b) >= 0 ? a : b;
+	}
+}
+
+// Rows of one shard, the next batch is requested while the current one is consumed.
+class ShardCursor {
+	public columns: string[] | undefined;
+	private rows: ScalarOut[][] = [];
+	private index = 0;
+	private pending: Promise<IteratorResult<SQLiteRowBatch>> | undefined;
+
+	constructor(private readonly batches: AsyncIterableIterator<SQLiteRowBatch>, private readonly noBigInt: boolean) {
+		this.prefetch();
+	}
+
+	private prefetch(): void {
+		this.pending = this.batches.next();
+		// surfaced by peek(), but a cursor closed early never awaits it
+		this.pending.catch(() => undefined);
+	}
+
+	// the current row, undefined once the shard is exhausted
+	public async peek(): Promise<ScalarOut[] | undefined> {
+		while (this.index >= this.rows.length) {
+			if (this.pending === undefined) {
+				return undefined;
+			}
+			const { value, done } = await this.pending;
+			if (done) {
+				this.pending = undefined;
+				return undefined;
+			}
+			this.columns = value.columns;
+			this.rows = Array.from(decodeRows(value.rows, value.columns.length, this.noBigInt));
+			this.index = 0;
+			this.pending = undefined;
+			if (!value.done) {
+				this.prefetch();
+			}
+		}
+		return this.rows[this.index];
+	}
+
+	public take(): ScalarOut[] {
+		return this.rows[this.index++];
+	}
+
+	// resets the statement if the shard was not read to the end
+	public async close(): Promise<void> {
+		await this.batches.return?.();
+	}
+}
+
+// Fans a query out to one worker per shard and merges the partial results as they arrive:
+// concatenated in shard order, k-way merged when shards are sorted, and combined when
+// shards return partial aggregates.
+export class SQLiteShards {
+	constructor(public readonly shards: SQLiteWorkerDB[]) {
+	}
+
+	public static async create(options: SQLiteShardsOptions): Promise<SQLiteShards> {
+		const spawn = await resolveSpawn(options);
+		const shards = options.images.map((image) => {
+			const db = new SQLiteWorkerDB(spawn({ module: options.module, image, cacheSize: options.cacheSize }));
+			db.timeoutMs = options.timeoutMs;
+			return db;
+		});
+		return new SQLiteShards(shards);
+	}
+
+	public exec(sql: string, options?: SQLiteQueryOptions): Promise<SQLiteExecValue[][][]> {
+		return Promise.all(this.shards.map((db) => db.exec(sql, options)));
+	}
+
+	public run(sql: string, params?: ScalarIn[], options?: SQLiteQueryOptions): Promise<SQLiteRunResult[]> {
+		return Promise.all(this.shards.map((db) => db.run(sql, params, options)));
+	}
+
+	public async all(sql: string, params?: ScalarIn[], options?: SQLiteShardQueryOptions): Promise<SQLiteRows> {
+		const cursors = this.open(sql, params, options);
+		const rows: ScalarOut[][] = [];
+		for await (const row of this.merge(cursors, options)) {
+			rows.push(row);
+		}
+		return { columns: cursors.find((c) => c.columns !== undefined)?.columns ?? [], rows };
+	}
+
+	public async *stream(sql: string, params?: ScalarIn[], options?: SQLiteShardQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+		yield* this.merge(this.open(sql, params, options), options);
+	}
+
+	public async close(): Promise<void> {
+		await Promise.all(this.shards.map((db) => db.close()));
+	}
+
+	// every shard starts its first batch right away
+	private open(sql: string, params: ScalarIn[] | undefined, options?: SQLiteShardQueryOptions): ShardCursor[] {
+		return this.shards.map((db) => new ShardCursor(
+			db.iterateBatches({ op: "query", sql, params, batch: options?.batch ?? 1024, ...db.control(options) }),
+			options?.noBigInt ?? false,
+		));
+	}
+
+	private async *merge(cursors: ShardCursor[], options?: SQLiteShardQueryOptions): AsyncIterableIterator<ScalarOut[]> {
+		const aggregates = options?.aggregates;
+		let orderBy = options?.orderBy?.map((o) => typeof o === "number" ? { column: o } : o);
+		let rows: AsyncIterableIterator<ScalarOut[]>;
+		try {
+			if (aggregates !== undefined) {
+				const columns = await firstColumns(cursors);
+				const groups = columns.map((_, i) => i).filter((i) => aggregates[i] === undefined);
+				orderBy ??= groups.map((column) => ({ column }));
+				rows = combineGroups(kWayMerge(cursors, orderBy), groups, aggregates);
+			} else if (orderBy !== undefined) {
+				rows = kWayMerge(cursors, orderBy);
+			} else {
+				rows = concat(cursors);
+			}
+			let count = 0;
+			const limit = options?.limit ?? Infinity;
+			if (limit <= 0) {
+				return;
+			}
+			for await (const row of rows) {
+				yield row;
+				if (++count >= limit) {
+					return;
+				}
+			}
+		} finally {
+			await Promise.all(cursors.map((c) => c.close()));
+		}
+	}
+}
+
+async function firstColumns(cursors: ShardCursor[]): Promise<string[]> {
+	for (const cursor of cursors) {
+		await cursor.peek();
+		if (cursor.columns !== undefined) {
+			return cursor.columns;
+		}
+	}
+	return [];
+}
+
+async function* concat(cursors: ShardCursor[]): AsyncIterableIterator<ScalarOut[]> {
+	for (const cursor of cursors) {
+		while (await cursor.peek() !== undefined) {
+			yield cursor.take();
+		}
+	}
+}
+
+// Binary heap of cursors ordered by their current row.
+async function* kWayMerge(cursors: ShardCursor[], orderBy: SQLiteShardOrder[]): AsyncIterableIterator<ScalarOut[]> {
+	const compare = (a: ScalarOut[], b: ScalarOut[]) => {
+		for (const { column, desc } of orderBy) {
+			const c = compareValues(a[column], b[column]);
+			if (c !== 0) {
+				return desc ? -c : c;
+			}
+		}
+		return 0;
+	};
+	const heap: [ScalarOut[], ShardCursor][] = [];
+	const heads = await Promise.all(cursors.map((c) => c.peek()));
+	heads.forEach((row, i) => {
+		if (row !== undefined) {
+			heap.push([row, cursors[i]]);
+		}
+	});
+	const siftDown = (i: number) => {
+		while (true) {
+			let min = i;
+			for (const child of [2 * i + 1, 2 * i + 2]) {
+				if (child < heap.length && compare(heap[child][0], heap[min][0]) < 0) {
+					min = child;
+				}
+			}
+			if (min === i) {
+				return;
+			}
+			[heap[i], heap[min]] = [heap[min], heap[i]];
+			i = min;
+		}
+	};
+	for (let i = (heap.length >> 1) - 1; i >= 0; i--) {
+		siftDown(i);
+	}
+	while (heap.length > 0) {
+		const cursor = heap[0][1];
+		yield cursor.take();
+		const next = await cursor.peek();
+		if (next !== undefined) {
+			heap[0][0] = next;
+		} else {
+			heap[0] = heap[heap.length - 1];
+			heap.pop();
+		}
+		siftDown(0);
+	}
+}
+
+// Final aggregation over rows sorted by the group columns, one output row per group.
+async function* combineGroups(
+	rows: AsyncIterableIterator<ScalarOut[]>,
+	groups: number[],
+	aggregates: Record<number, SQLiteShardAggregate>,
+): AsyncIterableIterator<ScalarOut[]> {
+	let current: ScalarOut[] | undefined;
+	for await (const row of rows) {
+		if (current !== undefined && groups.every((i) => compareValues(current![i], row[i]) === 0)) {
+			for (const [column, fn] of Object.entries(aggregates)) {
+				const i = Number(column);
+				current[i] = combine(fn, current[i], row[i]);
+			}
+			continue;
+		}
+		if (current !== undefined) {
+			yield current;
+		}
+		current = row.slice();
+	}
+	if (current !== undefined) {
+		yield current;
+	}
+}
@@ -0,0 +1,117 @@
+import type { CPointer } from "./api";
+import type { SQLiteVFS } from "./vfs";
+import type { SQLiteFTS5Tokenizer } from "./fts5";
+import { SQLite, SQLiteDB, SQLiteStatement } from "./sqlite";
+import { SQLiteResultCodes } from "./constants";
+import { SQLiteError } from "./utils";
+
+const PAGE_SIZE = 65536;
+
+export interface SQLiteSnapshotOptions {
+	// template databases opened on the instance, carried over with their schema already parsed
+	databases?: SQLiteDB[];
+	// hot statements prepared on those databases, reset before the capture
+	statements?: SQLiteStatement[];
+}
+
+export interface SQLiteRestoredInstance {
+	sqlite: SQLite;
+	// in the order of SQLiteSnapshotOptions
+	databases: SQLiteDB[];
+	statements: SQLiteStatement[];
+}
+
+interface CapturedStatement {
+	db: number;
+	pStmt: CPointer;
+	sql?: string;
+	tail?: string;
+}
+
+// Linear memory of an initialized instance, in the spirit of Wizer. New instances copy the image
+// into fresh memory instead of running sqlite3_initialize, registering the VFS and parsing the
+// schema of template databases again. Only the memory is captured, so databases must live in
+// memory (":memory:" or deserialized), and module must be the one the instance was created from.
+export class SQLiteSnapshot {
+	private constructor(
+		public readonly module: WebAssembly.Module,
+		// up to the last non-zero byte, the rest of the pages are zero
+		private readonly image: Uint8Array,
+		private readonly pages: number,
+		private readonly vfs: [number, SQLiteVFS][],
+		// JS tokenizers registered on the captured databases
+		private readonly tokenizers: [number, SQLiteFTS5Tokenizer][],
+		private readonly databases: CPointer[],
+		private readonly statements: CapturedStatement[],
+	) {
+	}
+
+	public static capture(module: WebAssembly.Module, sqlite: SQLite, options: SQLiteSnapshotOptions = {}): SQLiteSnapshot {
+		if (WebAssembly.Module.imports(module).some((i) => i.kind === "memory")) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "Snapshots need a module that owns its memory");
+		}
+		if (sqlite.vfs.files.size > 0) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "Snapshots cannot carry files open through a JS VFS");
+		}
+		const databases = options.databases ?? [];
+		const statements = (options.statements ?? []).map((stmt) => {
+			const db = databases.indexOf(stmt.db);
+			if (db < 0) {
+				throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "Statement of a database that is not captured");
+			}
+			stmt.reset();
+			return { db, pStmt: stmt.pStmt, sql: stmt.sql, tail: stmt.tail };
+		});
+		const memory = sqlite.utils.u8;
+		let end = memory.length;
+		while (end > 0 && memory[end - 1] === 0) {
+			end--;
+		}
+		return new SQLiteSnapshot(
+			module,
+			memory.slice(0, end),
+			memory.length / PAGE_SIZE,
+			Array.from(sqlite.vfs.vfs.entries()),
+			Array.from(sqlite.fts5.tokenizers.entries()),
+			databases.map((db) => db.pDb),
+			statements,
+		);
+	}
+
+	public get byteLength(): number {
+		return this.image.byteLength;
+	}
+
+	public instantiate(): Promise<SQLiteRestoredInstance>;
+	public instantiate(async: true): Promise<SQLiteRestoredInstance>;
+	public instantiate(async: false): SQLiteRestoredInstance;
+	public instantiate(async: boolean = true): Promise<SQLiteRestoredInstance> | SQLiteRestoredInstance {
+		if (async) {
+			return SQLite.instantiate(this.module, true, { initialize: false }).then((sqlite) => this.restore(sqlite));
+		}
+		return this.restore(SQLite.instantiate(this.module, false, { initialize: false }));
+	}
+
+	private restore(sqlite: SQLite): SQLiteRestoredInstance {
+		const memory = sqlite.exports.memory;
+		const current = memory.buffer.byteLength / PAGE_SIZE;
+		if (current < this.pages) {
+			memory.grow(this.pages - current);
+		}
+		const u8 = sqlite.utils.u8;
+		// data segments of the fresh instance may lie past the image
+		u8.fill(0, this.image.length, current * PAGE_SIZE);
+		u8.set(this.image);
+		for (const [id, vfs] of this.vfs) {
+			sqlite.vfs.vfs.set(id, vfs);
+		}
+		for (const [id, tokenizer] of this.tokenizers) {
+			sqlite.fts5.tokenizers.set(id, tokenizer);
+		}
+		// every copy would otherwise continue the same random() sequence
+		sqlite.exports.sqlite3_randomness(0, 0);
+		const databases = this.databases.map((pDb) => new SQLiteDB(sqlite, pDb));
+		const statements = this.statements.map((s) => new SQLiteStatement(databases[s.db], s.pStmt, s.sql, s.tail));
+		return { sqlite, databases, statements };
+	}
+}
@@ -1,53 +1,152 @@
-import { SQLiteExports, CPointer, SQLiteImports, unimplementedImports } from "./api";
-import { SQLiteResultCodes, SQLiteDatatype, SQLiteDatatypes } from "./constants";
+import { SQLiteExports, SQLiteExports64, CPointer, SQLiteImports, unimplementedImports } from "./api";
+import { SQLiteResultCodes, SQLiteDatatype, SQLiteDatatypes, SQLiteOpenFlags } from "./constants";
 
 import { SQLiteError, SQLiteUtils } from "./utils";
+import { SQLiteDefaultVFS, SQLiteVFS, SQLiteVFSRegistry } from "./vfs";
+import { SQLiteCancelToken } from "./cancel";
+import { SQLiteAsyncify, yieldMacrotask } from "./asyncify";
+import { compileFlavor } from "./loader";
+import { adaptExports64, adaptImports64, isMemory64, isMemory64Instance } from "./memory64";
+import { SQLiteNativeModule } from "./native";
+import { SQLiteFTS5Registry, SQLiteFTS5Tokenizer } from "./fts5";
+import { SQLiteJSON, isJSONDecltype } from "./json";
+import { SQLiteMaintenance, SQLiteMaintenanceOptions } from "./maintenance";
+
+// Float32Array binds as a BLOB of float32s, the vectors of the vec_ functions in `make full`
+export type ScalarIn = string | number | boolean | bigint | ArrayBuffer | Float32Array | null;
+export type ScalarOut = string | number | bigint | ArrayBuffer | null;
+
+// SQLITE_EXT_JSON_ARRAYS in sqlite3wasm.h
+const SQLITE_EXT_JSON_ARRAYS = 0x0001;
+
+export interface SQLiteStepOptions {
+	// AbortSignal only takes effect between steps, a SQLiteCancelToken can be set from another thread
+	signal?: AbortSignal | SQLiteCancelToken;
+	// absolute Date.now() timestamp
+	deadlineMs?: number;
+}
+
+// Progress callback for signals and deadlines, remembers why it interrupted.
+class SQLiteProgressCheck {
+	public reason: string | undefined;
+
+	constructor(private readonly options: SQLiteStepOptions) {
+	}
+
+	public readonly check = (): number => {
+		const { signal, deadlineMs } = this.options;
+		if (signal !== undefined && (signal instanceof SQLiteCancelToken ? signal.cancelled : signal.aborted)) {
+			this.reason = "cancelled";
+		} else if (deadlineMs !== undefined && Date.now() >= deadlineMs) {
+			this.reason = "deadline exceeded";
+		}
+		return this.reason === undefined ? 0 : 1;
+	};
+
+	public throwIfInterrupted(): void {
+		if (this.check() !== 0) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_INTERRUPT, SQLiteResultCodes.SQLITE_INTERRUPT, this.reason);
+		}
+	}
+
+	public explain(e: unknown): unknown {
+		if (this.reason !== undefined && e instanceof SQLiteError && e.code === SQLiteResultCodes.SQLITE_INTERRUPT) {
+			return new SQLiteError(e.code, e.extendedCode, this.reason);
+		}
+		return e;
+	}
+}
 
-type ScalarIn = string | number | boolean | bigint | ArrayBuffer | null;
-type ScalarOut = string | number | bigint | ArrayBuffer | null;
+export interface SQLiteStepAsyncOptions extends SQLiteStepOptions {
+	// longest stretch of synchronous work before yielding to the event loop
+	sliceMs?: number;
+}
+
+export interface SQLiteInstantiateOptions {
+	// shared memory for modules built with --import-memory, see `make threads`
+	memory?: WebAssembly.Memory;
+	// false skips sqlite3_initialize, for instances whose memory is restored from a SQLiteSnapshot
+	initialize?: boolean;
+	// wasi_snapshot_preview1 for WASI commands such as `make shell`, see scripts/shell.ts
+	wasi?: WebAssembly.ModuleImports;
+}
+
+// must match --initial-memory and --max-memory of THREADS_LDFLAGS
+const THREADS_INITIAL_MEMORY = 256;
+const THREADS_MAXIMUM_MEMORY = 32768;
 
 export class SQLite {
-	private readonly instance: WebAssembly.Instance;
+	public readonly instance: WebAssembly.Instance;
 	public readonly utils: SQLiteUtils;
 	public readonly exports: SQLiteExports;
+	public readonly vfs: SQLiteVFSRegistry;
+	public readonly fts5: SQLiteFTS5Registry;
+	// present when the module was built with `make asyncify`
+	public readonly asyncify: SQLiteAsyncify | undefined;
 
 	public _execCallback: SQLiteImports["sqlite3_ext_exec_callback"] | undefined;
+	public _progressCallback: SQLiteImports["sqlite3_ext_progress_callback"] | undefined;
+	public _sliceStart = 0;
 
-	public static instantiate(module: WebAssembly.Module): Promise<SQLite>;
-	public static instantiate(module: WebAssembly.Module, async: true): Promise<SQLite>;
-	public static instantiate(module: WebAssembly.Module, async: false): SQLite;
-	public static instantiate(module: WebAssembly.Module, async: boolean = true): Promise<SQLite> | SQLite {
+	// Probes the engine and instantiates the fastest flavor that it supports and read can provide.
+	public static async load(read: (filename: string) => Promise<BufferSource>, preference?: string[]): Promise<SQLite> {
+		const { module } = await compileFlavor(read, preference);
+		return await SQLite.instantiate(module);
+	}
+
+	public static instantiate(module: WebAssembly.Module | SQLiteNativeModule): Promise<SQLite>;
+	public static instantiate(module: WebAssembly.Module | SQLiteNativeModule, async: true, options?: SQLiteInstantiateOptions): Promise<SQLite>;
+	public static instantiate(module: WebAssembly.Module | SQLiteNativeModule, async: false, options?: SQLiteInstantiateOptions): SQLite;
+	public static instantiate(module: WebAssembly.Module | SQLiteNativeModule, async: boolean = true, options?: SQLiteInstantiateOptions): Promise<SQLite> | SQLite {
 		let sqlite: SQLite;
 
-		const imports: SQLiteImports = {
+		let memory: WebAssembly.Memory | undefined;
+		if (!(module instanceof SQLiteNativeModule) && WebAssembly.Module.imports(module).some((i) => i.module === "env" && i.kind === "memory")) {
+			memory = options?.memory ?? new WebAssembly.Memory({
+				initial: THREADS_INITIAL_MEMORY,
+				maximum: THREADS_MAXIMUM_MEMORY,
+				shared: true,
+			});
+		}
+		const env = memory === undefined ? {} : { memory };
+		const wasi = options?.wasi === undefined ? {} : { wasi_snapshot_preview1: options.wasi };
+		// SQLite's VFS list is per process in the native addon
+		const vfs = module instanceof SQLiteNativeModule ? module.vfs : new SQLiteVFSRegistry(() => sqlite.utils);
+		const fts5 = new SQLiteFTS5Registry(() => sqlite.utils);
+
+		const wasmImports: SQLiteImports = {
 			...unimplementedImports,
+			...vfs.imports(),
+			...fts5.imports(),
 			sqlite3_ext_vfs_get_last_error: () => {
 				return SQLiteResultCodes.SQLITE_OK;
 			},
-			sqlite3_ext_vfs_full_pathname: () => {
-				return SQLiteResultCodes.SQLITE_CANTOPEN;
-			},
 			sqlite3_ext_vfs_current_time: (_, pTimeOut) => {
 				const f64 = sqlite.utils.f64;
 				f64[pTimeOut / 8] = Date.now() / 86400000 + 2440587.5;
 				return SQLiteResultCodes.SQLITE_OK;
 			},
+			// filled outside of memory, getRandomValues rejects views of shared memory
 			sqlite3_ext_vfs_randomness: globalThis?.crypto?.getRandomValues !== undefined ? (_, nByte, zOut) => {
 				const u8 = new Uint8Array(nByte);
-				globalThis.crypto.getRandomValues(u8.slice(zOut, zOut + nByte));
+				globalThis.crypto.getRandomValues(u8);
+				sqlite.utils.u8.set(u8, zOut);
 				return SQLiteResultCodes.SQLITE_OK;
 			} : (_, nByte, zOut) => {
 				const u8 = new Uint8Array(nByte);
 				for (let i = 0; i < nByte; i++) {
-					u8[zOut + i] = Math.floor(Math.random() * 256);
+					u8[i] = Math.floor(Math.random() * 256);
 				}
+				sqlite.utils.u8.set(u8, zOut);
 				return SQLiteResultCodes.SQLITE_OK;
 			},
 			sqlite3_ext_os_init: () => {
 				const pId = sqlite.utils.malloc(4);
 				const rc = sqlite.exports.sqlite3_ext_vfs_register(0, 1, pId);
+				const id = sqlite.utils.deref32(pId);
 				sqlite.utils.free(pId);
 				sqlite.utils.checkError(rc);
+				vfs.vfs.set(id, new SQLiteDefaultVFS());
 				return SQLiteResultCodes.SQLITE_OK;
 			},
 			sqlite3_ext_os_end: () => {
@@ -56,18 +155,36 @@ export class SQLite {
 			sqlite3_ext_exec_callback: (i, nCols, azCols, azColNames) => {
 				return sqlite._execCallback!(i, nCols, azCols, azColNames);
 			},
+			sqlite3_ext_progress_callback: (id) => {
+				return sqlite._progressCallback?.(id) ?? 0;
+			},
 		};
 
+		if (module instanceof SQLiteNativeModule) {
+			sqlite = new SQLite(module.instantiate(wasmImports), undefined, vfs, fts5);
+			if (options?.initialize ?? true) {
+				sqlite.initialize();
+			}
+			return async ? Promise.resolve(sqlite) : sqlite;
+		}
+
+		// memory64 builds take the same imports with BigInt pointers
+		const imports = isMemory64(module) ? adaptImports64(wasmImports) : wasmImports;
+
 		if (async) {
 			return (async () => {
 				const instance = await WebAssembly.instantiate(module, {
 					imports: {
 						...imports,
 					},
+					env,
+					...wasi,
 				});
 		
-				sqlite = new SQLite(instance);
-				sqlite.initialize();
+				sqlite = new SQLite(instance, memory, vfs, fts5);
+				if (options?.initialize ?? true) {
+					sqlite.initialize();
+				}
 				return sqlite;
 			})();
 		} else {
@@ -75,34 +192,65 @@ export class SQLite {
 				imports: {
 					...imports,
 				},
+				env,
+				...wasi,
 			});
-			sqlite = new SQLite(instance);
-			sqlite.initialize();
+			sqlite = new SQLite(instance, memory, vfs, fts5);
+			if (options?.initialize ?? true) {
+				sqlite.initialize();
+			}
 			return sqlite;
 		}
 	}
 
-	public constructor(instance: WebAssembly.Instance) {
+	public constructor(instance: WebAssembly.Instance, memory?: WebAssembly.Memory, vfs?: SQLiteVFSRegistry, fts5?: SQLiteFTS5Registry) {
 		this.instance = instance;
-		this.exports = this.instance.exports as SQLiteExports;
-		this.utils = new SQLiteUtils(this.exports);
+		const memory64 = isMemory64Instance(instance.exports);
+		const exports = memory64 ? adaptExports64(instance.exports as SQLiteExports64) : instance.exports;
+		this.exports = (memory === undefined ? exports : { ...exports, memory }) as SQLiteExports;
+		this.utils = new SQLiteUtils(this.exports, memory64 ? 8 : 4);
+		this.vfs = vfs ?? new SQLiteVFSRegistry(() => this.utils);
+		this.fts5 = fts5 ?? new SQLiteFTS5Registry(() => this.utils);
+		this.asyncify = SQLiteAsyncify.detect(this, instance.exports);
 	}
 
 	public initialize(): void {
+		this.utils.checkError(this.exports.sqlite3_ext_init());
 		const rc = this.exports.sqlite3_initialize();
 		this.utils.checkError(rc);
 	}
 
-	public open(filename: string): SQLiteDB {
+	public registerVFS(name: string, vfs: SQLiteVFS, makeDefault: boolean = false): number {
+		const zName = this.utils.cString(name);
+		const pId = this.utils.malloc(4);
+		const rc = this.exports.sqlite3_ext_vfs_register(zName, makeDefault ? 1 : 0, pId);
+		const id = this.utils.deref32(pId);
+		this.utils.free(pId);
+		this.utils.free(zName);
+		this.utils.checkError(rc);
+		this.vfs.vfs.set(id, vfs);
+		return id;
+	}
+
+	public open(filename: string, flags?: number, vfs?: string): SQLiteDB {
 		const filenamePtr = this.utils.cString(filename);
-		const ppDb = this.exports.sqlite3_malloc(4);
-		const rc = this.exports.sqlite3_open(filenamePtr, ppDb);
+		const ppDb = this.exports.sqlite3_malloc(this.utils.pointerSize);
+		let rc: number;
+		if (flags === undefined && vfs === undefined) {
+			rc = this.exports.sqlite3_open(filenamePtr, ppDb);
+		} else {
+			const zVfs = vfs === undefined ? 0 : this.utils.cString(vfs);
+			flags ??= SQLiteOpenFlags.SQLITE_OPEN_READWRITE | SQLiteOpenFlags.SQLITE_OPEN_CREATE;
+			rc = this.exports.sqlite3_open_v2(filenamePtr, ppDb, flags, zVfs);
+			this.utils.free(zVfs);
+		}
 		this.utils.free(filenamePtr);
+		const pDb = this.utils.derefPointer(ppDb);
+		this.utils.free(ppDb);
 		if (rc !== SQLiteResultCodes.SQLITE_OK) {
+			this.exports.sqlite3_close_v2(pDb);
 			throw new SQLiteError(rc);
 		}
-		const pDb = this.utils.deref32(ppDb);
-		this.utils.free(ppDb);
 		return new SQLiteDB(this, pDb);
 	}
 
@@ -140,11 +288,96 @@ export class SQLiteDB {
 	public readonly utils: SQLiteUtils;
 	public readonly exports: SQLiteExports;
 
+	// VDBE opcodes between cancellation and deadline checks
+	public progressOps = 1000;
+	// planner statistics upkeep from scheduleMaintenance
+	public maintenance: SQLiteMaintenance | undefined;
+	// suspendable calls that have not settled yet
+	private suspendableCalls = 0;
+	// the callback of the progress handler installed on this connection by installProgress
+	private progressCallback: ((id: number) => number) | undefined;
+
 	constructor(public readonly sqlite: SQLite, public pDb: CPointer) {
 		this.utils = sqlite.utils;
 		this.exports = sqlite.exports;
 	}
 
+	// Installs callback as the progress handler of this connection and returns a function that
+	// puts back the handler installed before it. The enclosing handlers still run after callback,
+	// so the deadline of an outer interruptible holds inside an inner one.
+	public installProgress(callback: (id: number) => number): () => void {
+		const previous = this.progressCallback;
+		const previousGlobal = this.sqlite._progressCallback;
+		const chained = previous === undefined ? callback : (id: number) => callback(id) || previous(id);
+		this.progressCallback = chained;
+		this.sqlite._progressCallback = chained;
+		this.exports.sqlite3_ext_progress_handler(this.pDb, this.progressOps, 0);
+		return () => {
+			this.progressCallback = previous;
+			this.sqlite._progressCallback = previous ?? previousGlobal;
+			this.exports.sqlite3_ext_progress_handler(this.pDb, previous === undefined ? 0 : this.progressOps, 0);
+		};
+	}
+
+	// Runs fn with a progress handler that interrupts it once the signal fires or the deadline passes.
+	// When fn returns a promise, as stepAsync does, the handler stays installed until it settles.
+	public interruptible<T>(options: SQLiteStepOptions, fn: () => T): T {
+		if (options.signal === undefined && options.deadlineMs === undefined) {
+			return fn();
+		}
+		const progress = new SQLiteProgressCheck(options);
+		progress.throwIfInterrupted();
+		const restore = this.installProgress(progress.check);
+		let result: T;
+		try {
+			result = fn();
+		} catch (e) {
+			restore();
+			throw progress.explain(e);
+		}
+		if (result instanceof Promise) {
+			return result.then((value) => {
+				restore();
+				return value;
+			}, (e) => {
+				restore();
+				throw progress.explain(e);
+			}) as unknown as T;
+		}
+		restore();
+		return result;
+	}
+
+	// Like interruptible, but on an Asyncify build fn is suspended once it has run for sliceMs
+	// and resumed on a later macrotask. Until it settles, synchronous calls on this connection
+	// throw SQLITE_MISUSE, they would run between the frames of the suspended statement.
+	public async suspendable<T>(options: SQLiteStepOptions, sliceMs: number, fn: () => T): Promise<T> {
+		const asyncify = this.sqlite.asyncify;
+		if (asyncify === undefined) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "suspendable() requires an Asyncify build");
+		}
+		const progress = new SQLiteProgressCheck(options);
+		progress.throwIfInterrupted();
+		this.suspendableCalls++;
+		try {
+			return await asyncify.run(this, fn, progress.check, sliceMs);
+		} catch (e) {
+			throw progress.explain(e);
+		} finally {
+			this.suspendableCalls--;
+		}
+	}
+
+	public get suspended(): boolean {
+		return this.suspendableCalls > 0;
+	}
+
+	public throwIfSuspended(): void {
+		if (this.suspendableCalls > 0) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE, undefined, "a suspendable call on this connection is pending");
+		}
+	}
+
 	public prepare(sql: string): SQLiteStatement | null;
 	public prepare(sql: string, callback: (stmt: SQLiteStatement) => void): void;
 	public prepare(sql: string, callback?: (stmt: SQLiteStatement) => void): SQLiteStatement | null | void {
@@ -165,9 +398,10 @@ export class SQLiteDB {
 				nextSql = stmt.tail ?? "";
 			}
 		}
+		this.throwIfSuspended();
 		const zSql = this.utils.cString(sql);
-		const ppStmt = this.exports.sqlite3_malloc(4);
-		const pzTail = this.exports.sqlite3_malloc(4);
+		const ppStmt = this.exports.sqlite3_malloc(this.utils.pointerSize);
+		const pzTail = this.exports.sqlite3_malloc(this.utils.pointerSize);
 		const rc = this.exports.sqlite3_prepare_v2(this.pDb, zSql, -1, ppStmt, pzTail);
 		if (rc !== SQLiteResultCodes.SQLITE_OK) {
 			this.utils.free(zSql);
@@ -175,8 +409,8 @@ export class SQLiteDB {
 			this.utils.free(pzTail);
 			throw this.utils.lastError(this.pDb);
 		}
-		const pStmt = this.utils.deref32(ppStmt);
-		const zTail = this.utils.deref32(pzTail);
+		const pStmt = this.utils.derefPointer(ppStmt);
+		const zTail = this.utils.derefPointer(pzTail);
 		let tail: string | undefined;
 		if (zTail !== 0) {
 			tail = this.utils.decodeString(zTail);
@@ -192,16 +426,17 @@ export class SQLiteDB {
 	}
 
 	public exec(sql: string): SQLiteExecValue[][] {
+		this.throwIfSuspended();
 		const results: SQLiteExecValue[][] = [];
 		const pSql = this.utils.cString(sql);
-		const pzErr = this.utils.malloc(4);
+		const pzErr = this.utils.malloc(this.utils.pointerSize);
 	
 		this.sqlite._execCallback = (i, nCols, azCols, azColNames) => {
 			const result: SQLiteExecValue[] = [];
 			results.push(result);
 			for (let i = 0; i < nCols; i++) {
-				const zCol = this.utils.deref32(azCols + i * 4);
-				const zColName = this.utils.deref32(azColNames + i * 4);
+				const zCol = this.utils.derefPointer(azCols + i * this.utils.pointerSize);
+				const zColName = this.utils.derefPointer(azColNames + i * this.utils.pointerSize);
 				const colName = this.utils.decodeString(zColName);
 				result.push({ name: colName, value: zCol === 0 ? null : this.utils.decodeString(zCol) });
 			}
@@ -214,11 +449,19 @@ export class SQLiteDB {
 		return results;
 	}
 
-	public serialize(schema: string = "main", mFlags: number = 0): ArrayBuffer | null {
+	// optimize first runs the pending PRAGMA optimize of scheduleMaintenance, so the sqlite_stat
+	// tables in the image are fresh. It writes, so it is skipped inside a transaction and on
+	// read-only connections.
+	public serialize(schema: string = "main", mFlags: number = 0, optimize: boolean = false): ArrayBuffer | null {
+		this.throwIfSuspended();
+		if (optimize && this.maintenance !== undefined && this.maintenance.pendingChanges > 0 &&
+			this.exports.sqlite3_get_autocommit(this.pDb) !== 0 && !this.readonly(schema)) {
+			this.maintenance.optimize();
+		}
 		const zSchema = this.utils.cString(schema);
 		const piSize = this.exports.sqlite3_malloc(8);
 		const pOut = this.exports.sqlite3_serialize(this.pDb, zSchema, piSize, mFlags);
-		const size = this.utils.deref32(piSize);
+		const size = Number(this.utils.deref64(piSize));
 		this.utils.free(zSchema);
 		this.utils.free(piSize);
 		let out: Uint8Array | null = null;
@@ -230,7 +473,15 @@ export class SQLiteDB {
 		return out;
 	}
 
+	private readonly(schema: string): boolean {
+		const zSchema = this.utils.cString(schema);
+		const readonly = this.exports.sqlite3_db_readonly(this.pDb, zSchema);
+		this.utils.free(zSchema);
+		return readonly !== 0;
+	}
+
 	public deserialize(data: ArrayBuffer, schema: string = "main", mFlags: number = 0): void {
+		this.throwIfSuspended();
 		const zSchema = this.utils.cString(schema);
 		const pData = this.utils.malloc(data.byteLength);
 		this.utils.u8.set(new Uint8Array(data), pData);
@@ -246,19 +497,41 @@ export class SQLiteDB {
 		this.utils.checkError(rc, this.pDb);
 	}
 
+	// JS tokenizer for FTS5 tables of this connection, see SQLiteFTS5Registry
+	public createTokenizer(name: string, tokenizer: SQLiteFTS5Tokenizer): void {
+		this.sqlite.fts5.create(this, name, tokenizer);
+	}
+
+	// Runs PRAGMA optimize when idle, after bulk loads and on close, see SQLiteMaintenance.
+	public scheduleMaintenance(options?: SQLiteMaintenanceOptions): SQLiteMaintenance {
+		this.maintenance?.stop();
+		this.maintenance = new SQLiteMaintenance(this, options);
+		return this.maintenance;
+	}
+
 	public close(): void {
-		const rc = this.exports.sqlite3_close(this.pDb);
-		this.utils.checkError(rc);
+		this.throwIfSuspended();
+		const maintenance = this.maintenance;
+		this.maintenance = undefined;
+		try {
+			maintenance?.stop();
+			maintenance?.optimize();
+		} finally {
+			const rc = this.exports.sqlite3_close(this.pDb);
+			this.utils.checkError(rc);
+		}
 	}
 }
 
 export class SQLiteStatement {
 	public readonly utils: SQLiteUtils;
 	public readonly exports: SQLiteExports;
+	// columns declared JSON, looked up on the first columns(noBigInt, true)
+	private jsonColumns: boolean[] | undefined;
 
 	constructor(
 		public readonly db: SQLiteDB,
-		private pStmt: CPointer,
+		public pStmt: CPointer,
 		public readonly sql?: string,
 		public readonly tail?: string
 	) {
@@ -286,6 +559,24 @@ export class SQLiteStatement {
 		this.utils.checkError(rc, this.db.pDb);
 	}
 
+	// Binds the bytes of a vector as a BLOB. A view into the heap, such as one over utils.malloc
+	// memory, is bound in place and must stay untouched until the statement is reset or rebound.
+	// Others are copied once into a buffer that SQLite frees.
+	public bindFloat32Array(i: number, vector: Float32Array): void {
+		let rc: number;
+		if (vector.buffer === this.exports.memory.buffer) {
+			rc = this.exports.sqlite3_bind_blob(this.pStmt, i, vector.byteOffset, vector.byteLength, 0);
+		} else {
+			const ptr = this.utils.malloc(vector.byteLength || 1);
+			if (ptr === 0) {
+				throw new SQLiteError(SQLiteResultCodes.SQLITE_NOMEM);
+			}
+			this.utils.u8.set(new Uint8Array(vector.buffer, vector.byteOffset, vector.byteLength), ptr);
+			rc = this.exports.sqlite3_ext_bind_blob_free(this.pStmt, i, ptr, vector.byteLength);
+		}
+		this.utils.checkError(rc, this.db.pDb);
+	}
+
 	public bindDouble(i: number, d: number): void {
 		const rc = this.exports.sqlite3_bind_double(this.pStmt, i, d);
 		this.utils.checkError(rc, this.db.pDb);
@@ -325,17 +616,43 @@ export class SQLiteStatement {
 		if (value instanceof ArrayBuffer) {
 			return this.bindBlob(i, value);
 		}
+		if (value instanceof Float32Array) {
+			return this.bindFloat32Array(i, value);
+		}
 		throw new Error(`Unsupported type ${typeof value}: ${value}`);
 	}
 
 	public bindValues(values: ScalarIn[]): void {
+		this.db.throwIfSuspended();
 		for (let i = 0; i < values.length; i++) {
 			this.bindValue(i + 1, values[i]);
 		}
 	}
 
-	public step(): boolean {
-		const rc = this.exports.sqlite3_step(this.pStmt);
+	public step(options?: SQLiteStepOptions): boolean {
+		if (options !== undefined) {
+			return this.db.interruptible(options, () => this.step());
+		}
+		this.db.throwIfSuspended();
+		return this.stepResult(this.exports.sqlite3_step(this.pStmt));
+	}
+
+	// Steps without holding the event loop for more than sliceMs. Asyncify builds suspend inside
+	// sqlite3_step, other builds can only yield between steps.
+	public async stepAsync(options: SQLiteStepAsyncOptions = {}): Promise<boolean> {
+		const sliceMs = options.sliceMs ?? 10;
+		if (this.db.sqlite.asyncify !== undefined) {
+			return this.stepResult(await this.db.suspendable(options, sliceMs, () => this.exports.sqlite3_step(this.pStmt)));
+		}
+		const sqlite = this.db.sqlite;
+		if (performance.now() - sqlite._sliceStart >= sliceMs) {
+			await yieldMacrotask();
+			sqlite._sliceStart = performance.now();
+		}
+		return this.step(options);
+	}
+
+	private stepResult(rc: number): boolean {
 		if (rc === SQLiteResultCodes.SQLITE_ROW) {
 			return true;
 		} else if (rc === SQLiteResultCodes.SQLITE_OK || rc === SQLiteResultCodes.SQLITE_DONE) {
@@ -346,6 +663,7 @@ export class SQLiteStatement {
 	}
 
 	public reset(): void {
+		this.db.throwIfSuspended();
 		const rc = this.exports.sqlite3_reset(this.pStmt);
 		this.utils.checkError(rc, this.db.pDb);
 	}
@@ -362,8 +680,9 @@ export class SQLiteStatement {
 
 	public columnText(i: number): string {
 		const ptr = this.exports.sqlite3_column_text(this.pStmt, i);
-		const text = this.utils.decodeString(ptr);
-		return text;
+		// SQLite already knows the length, no need to scan for the terminator
+		const len = this.exports.sqlite3_column_bytes(this.pStmt, i);
+		return this.utils.textDecoder.decode(this.utils.u8.slice(ptr, ptr + len));
 	}
 
 	public columnBlob(i: number): ArrayBuffer {
@@ -375,6 +694,13 @@ export class SQLiteStatement {
 		return buf.buffer;
 	}
 
+	// a BLOB of float32s as a vector, copied out of the heap
+	public columnFloat32Array(i: number): Float32Array {
+		const ptr = this.exports.sqlite3_column_blob(this.pStmt, i);
+		const len = this.exports.sqlite3_column_bytes(this.pStmt, i);
+		return new Float32Array(this.utils.u8.slice(ptr, ptr + (len & ~3)).buffer);
+	}
+
 	public columnDouble(i: number): number {
 		return this.exports.sqlite3_column_double(this.pStmt, i);
 	}
@@ -421,22 +747,66 @@ export class SQLiteStatement {
 		}
 	}
 
+	// the TEXT of column i, parsed on first use of SQLiteJSON.value
+	public columnJSON(i: number): SQLiteJSON | null {
+		if (this.columnType(i) === SQLiteDatatypes.SQLITE_NULL) {
+			return null;
+		}
+		return new SQLiteJSON(this.columnText(i));
+	}
+
 	public columns(): ScalarOut[];
 	public columns(noBigInt: true): (string | number | ArrayBuffer | null)[];
 	public columns(noBigInt: false): ScalarOut[];
 	public columns(noBigInt: boolean): ScalarOut[];
-	public columns(noBigInt?: boolean): ScalarOut[] {
+	// with lazyJSON, TEXT of columns declared JSON comes back as SQLiteJSON
+	public columns(noBigInt: boolean, lazyJSON: true): (ScalarOut | SQLiteJSON)[];
+	public columns(noBigInt?: boolean, lazyJSON?: boolean): (ScalarOut | SQLiteJSON)[] {
 		const columns = [];
 		const count = this.columnCount();
+		if (lazyJSON && this.jsonColumns === undefined) {
+			this.jsonColumns = Array.from({ length: count }, (_, i) => isJSONDecltype(this.columnDecltype(i)));
+		}
 		for (let i = 0; i < count; i++) {
-			columns.push(this.columnValue(i, noBigInt ?? false));
+			if (lazyJSON && this.jsonColumns![i] && this.columnType(i) === SQLiteDatatypes.SQLITE_TEXT) {
+				columns.push(new SQLiteJSON(this.columnText(i)));
+			} else {
+				columns.push(this.columnValue(i, noBigInt ?? false));
+			}
 		}
 		return columns;
 	}
 
+	// Steps to the end and returns every row as one JSON text built in C, an array of objects
+	// keyed by column name or with arrays, of arrays. TEXT of columns declared JSON is embedded
+	// as it is, BLOBs have no JSON form and throw SQLITE_MISMATCH.
+	public resultJSON(arrays: boolean = false): string {
+		this.db.throwIfSuspended();
+		const ppOut = this.utils.malloc(this.utils.pointerSize + 4);
+		const pnOut = ppOut + this.utils.pointerSize;
+		const rc = this.exports.sqlite3_ext_stmt_json(this.pStmt, arrays ? SQLITE_EXT_JSON_ARRAYS : 0, ppOut, pnOut);
+		const pOut = this.utils.derefPointer(ppOut);
+		const nOut = this.utils.deref32(pnOut);
+		this.utils.free(ppOut);
+		if (rc === SQLiteResultCodes.SQLITE_MISMATCH) {
+			throw new SQLiteError(rc, undefined, "JSON cannot hold BLOB values");
+		}
+		this.utils.checkError(rc, this.db.pDb);
+		const text = this.utils.textDecoder.decode(this.utils.u8.subarray(pOut, pOut + nOut));
+		this.utils.free(pOut);
+		return text;
+	}
+
+	// one of SQLiteStatementStatus, reset clears the counter after reading it
+	public status(op: number, reset: boolean = false): number {
+		return this.exports.sqlite3_stmt_status(this.pStmt, op, reset ? 1 : 0);
+	}
+
 	public finalize(): void {
+		this.db.throwIfSuspended();
+		// the statement is freed even if finalize reports the error of the last step
 		const rc = this.exports.sqlite3_finalize(this.pStmt);
-		this.utils.checkError(rc, this.db.pDb);
 		this.pStmt = 0;
+		this.utils.checkError(rc, this.db.pDb);
 	}
 }
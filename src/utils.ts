@@ -11,7 +11,8 @@ export class SQLiteUtils {
 	public readonly textEncoder: TextEncoder;
 	public readonly textDecoder: TextDecoder;
 
-	constructor(private exports: SQLiteExports) {
+	// sizeof(void *), 8 for memory64 builds
+	constructor(private exports: SQLiteExports, public readonly pointerSize: 4 | 8 = 4) {
 		this.textEncoder = new TextEncoder();
 		this.textDecoder = new TextDecoder();
 	}
@@ -24,6 +25,10 @@ export class SQLiteUtils {
 		return new Uint32Array(this.exports.memory.buffer);
 	}
 
+	public get i64() {
+		return new BigInt64Array(this.exports.memory.buffer);
+	}
+
 	public get f64() {
 		return new Float64Array(this.exports.memory.buffer);
 	}
@@ -60,6 +65,15 @@ export class SQLiteUtils {
 		return view[(ptr / 4) | 0];
 	}
 
+	public deref64(ptr: number): bigint {
+		return this.i64[(ptr / 8) | 0];
+	}
+
+	// reads a pointer stored in memory, such as the output of a T** argument
+	public derefPointer(ptr: number): number {
+		return this.pointerSize === 8 ? Number(this.deref64(ptr)) : this.deref32(ptr);
+	}
+
 	public lastError(dbPtr: number): SQLiteError | undefined {
 		const code = this.exports.sqlite3_errcode(dbPtr);
 		if (code === SQLiteResultCodes.SQLITE_OK) {
@@ -0,0 +1,62 @@
+import type { SQLiteDB } from "./sqlite";
+
+// ascending distances for every metric: Euclidean, 1 - cosine similarity, or the negated inner product
+export type SQLiteVectorMetric = "l2" | "cosine" | "dot";
+
+export interface SQLiteVectorMatch {
+	rowid: number;
+	distance: number;
+}
+
+export interface SQLiteVectorSearchOptions {
+	// defaults to 10
+	k?: number;
+	metric?: SQLiteVectorMetric;
+}
+
+export interface SQLiteVectorIndexSearchOptions {
+	// defaults to 10
+	k?: number;
+	// lists of a vec_ivf table to scan, more find more of the exact nearest rows and take longer,
+	// defaults to sqrt(lists)
+	probes?: number;
+}
+
+function collect(db: SQLiteDB, sql: string, params: (string | number | Float32Array)[]): SQLiteVectorMatch[] {
+	const matches: SQLiteVectorMatch[] = [];
+	db.prepare(sql, (stmt) => {
+		for (let i = 0; i < params.length; i++) {
+			const value = params[i];
+			// k and probes take integers
+			if (typeof value === "number") {
+				stmt.bindInt(i + 1, value);
+			} else {
+				stmt.bindValue(i + 1, value);
+			}
+		}
+		while (stmt.step()) {
+			matches.push({ rowid: Number(stmt.columnInt64(0)), distance: stmt.columnDouble(1) });
+		}
+	});
+	return matches;
+}
+
+// The k rows of a table whose float32 vectors in column are nearest to query, nearest first. It
+// scans the whole column with vec_topk in C, which needs a build with the vector search such as
+// `make full`, the rows never reach JS.
+export function searchVectors(db: SQLiteDB, table: string, column: string, query: Float32Array, options: SQLiteVectorSearchOptions = {}): SQLiteVectorMatch[] {
+	return collect(db, "SELECT id, distance FROM vec_topk(?, ?, ?, ?, ?)", [table, column, query, options.k ?? 10, options.metric ?? "l2"]);
+}
+
+// The k nearest rows of a vec_ivf table, nearest first. Only the probed lists are scanned, so rows
+// of other lists can be missed, see vec_ivf in sqlite/sqlite3vec.c for creating and training one.
+export function searchVectorIndex(db: SQLiteDB, table: string, query: Float32Array, options: SQLiteVectorIndexSearchOptions = {}): SQLiteVectorMatch[] {
+	const t = `"${table.replace(/"/g, "\"\"")}"`;
+	const params: (number | Float32Array)[] = [query, options.k ?? 10];
+	let sql = `SELECT rowid, distance FROM ${t} WHERE vector MATCH ? AND k = ?`;
+	if (options.probes !== undefined) {
+		sql += " AND probes = ?";
+		params.push(options.probes);
+	}
+	return collect(db, `${sql} ORDER BY distance`, params);
+}
@@ -0,0 +1,404 @@
+import type { SQLiteImports } from "./api";
+import { SQLiteResultCodes, SQLiteOpenFlags, SQLiteLockLevels } from "./constants";
+import { SQLiteError, SQLiteUtils } from "./utils";
+
+const SQLITE_IOERR_SHORT_READ = 522;
+
+export interface SQLiteVFSFile {
+	close(): void;
+	// returns the number of bytes read, the rest of buf is zero-filled
+	read(buf: Uint8Array, offset: number): number;
+	write(buf: Uint8Array, offset: number): void;
+	truncate(size: number): void;
+	sync(flags: number): void;
+	fileSize(): number;
+	// returns false if the lock is busy
+	lock(level: number): boolean;
+	unlock(level: number): void;
+	checkReservedLock(): boolean;
+	fileControl?(op: number, pArg: number): number;
+	sectorSize?(): number;
+	deviceCharacteristics?(): number;
+}
+
+export interface SQLiteVFS {
+	// name is null for temporary files
+	open(name: string | null, flags: number): SQLiteVFSFile;
+	delete(name: string, syncDir: boolean): void;
+	access(name: string, flags: number): boolean;
+	fullPathname?(name: string): string;
+}
+
+export class SQLiteMemoryFile implements SQLiteVFSFile {
+	private data = new Uint8Array(0);
+	private size = 0;
+
+	public close(): void {
+		this.data = new Uint8Array(0);
+		this.size = 0;
+	}
+
+	public read(buf: Uint8Array, offset: number): number {
+		const n = Math.max(Math.min(buf.length, this.size - offset), 0);
+		buf.set(this.data.subarray(offset, offset + n));
+		return n;
+	}
+
+	public write(buf: Uint8Array, offset: number): void {
+		const end = offset + buf.length;
+		if (end > this.data.length) {
+			const data = new Uint8Array(Math.max(end, this.data.length * 2));
+			data.set(this.data.subarray(0, this.size));
+			this.data = data;
+		}
+		this.data.set(buf, offset);
+		this.size = Math.max(this.size, end);
+	}
+
+	public truncate(size: number): void {
+		if (size < this.size) {
+			this.data.fill(0, size, this.size);
+			this.size = size;
+		}
+	}
+
+	public sync(): void {
+	}
+
+	public fileSize(): number {
+		return this.size;
+	}
+
+	public lock(): boolean {
+		return true;
+	}
+
+	public unlock(): void {
+	}
+
+	public checkReservedLock(): boolean {
+		return false;
+	}
+}
+
+// The VFS registered by sqlite3_os_init. It only provides temporary files,
+// which the sorter and statement journals need even for in-memory databases.
+export class SQLiteDefaultVFS implements SQLiteVFS {
+	public open(name: string | null): SQLiteVFSFile {
+		if (name !== null) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_CANTOPEN);
+		}
+		return new SQLiteMemoryFile();
+	}
+
+	public delete(): void {
+	}
+
+	public access(): boolean {
+		return false;
+	}
+
+	public fullPathname(): string {
+		throw new SQLiteError(SQLiteResultCodes.SQLITE_CANTOPEN);
+	}
+}
+
+type VFSImports = Pick<SQLiteImports,
+	| "sqlite3_ext_io_close"
+	| "sqlite3_ext_io_read"
+	| "sqlite3_ext_io_write"
+	| "sqlite3_ext_io_truncate"
+	| "sqlite3_ext_io_sync"
+	| "sqlite3_ext_io_file_size"
+	| "sqlite3_ext_io_lock"
+	| "sqlite3_ext_io_unlock"
+	| "sqlite3_ext_io_check_reserved_lock"
+	| "sqlite3_ext_io_file_control"
+	| "sqlite3_ext_io_sector_size"
+	| "sqlite3_ext_io_device_characteristics"
+	| "sqlite3_ext_vfs_open"
+	| "sqlite3_ext_vfs_delete"
+	| "sqlite3_ext_vfs_access"
+	| "sqlite3_ext_vfs_full_pathname"
+>;
+
+function errorCode(e: unknown): number {
+	if (e instanceof SQLiteError) {
+		return e.code;
+	}
+	return SQLiteResultCodes.SQLITE_IOERR;
+}
+
+export class SQLiteVFSRegistry {
+	public readonly vfs = new Map<number, SQLiteVFS>();
+	public readonly files = new Map<number, SQLiteVFSFile>();
+	private nextFileId = 1;
+
+	constructor(private readonly getUtils: () => SQLiteUtils) {
+	}
+
+	private getVFS(id: number): SQLiteVFS {
+		const vfs = this.vfs.get(id);
+		if (vfs === undefined) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE);
+		}
+		return vfs;
+	}
+
+	private getFile(id: number): SQLiteVFSFile {
+		const file = this.files.get(id);
+		if (file === undefined) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_MISUSE);
+		}
+		return file;
+	}
+
+	private call(fn: () => number | void): number {
+		try {
+			return fn() ?? SQLiteResultCodes.SQLITE_OK;
+		} catch (e) {
+			return errorCode(e);
+		}
+	}
+
+	public imports(): VFSImports {
+		const u32 = (ptr: number, value: number) => {
+			this.getUtils().u32[ptr / 4] = value;
+		};
+		return {
+			sqlite3_ext_io_close: (_, fileId) => this.call(() => {
+				const file = this.getFile(fileId);
+				this.files.delete(fileId);
+				file.close();
+			}),
+			sqlite3_ext_io_read: (_, fileId, pBuf, iAmt, iOfst) => this.call(() => {
+				const buf = this.getUtils().u8.subarray(pBuf, pBuf + iAmt);
+				const n = this.getFile(fileId).read(buf, iOfst);
+				if (n < iAmt) {
+					buf.fill(0, n);
+					return SQLITE_IOERR_SHORT_READ;
+				}
+			}),
+			sqlite3_ext_io_write: (_, fileId, pBuf, iAmt, iOfst) => this.call(() => {
+				this.getFile(fileId).write(this.getUtils().u8.subarray(pBuf, pBuf + iAmt), iOfst);
+			}),
+			sqlite3_ext_io_truncate: (_, fileId, size) => this.call(() => {
+				this.getFile(fileId).truncate(size);
+			}),
+			sqlite3_ext_io_sync: (_, fileId, flags) => this.call(() => {
+				this.getFile(fileId).sync(flags);
+			}),
+			sqlite3_ext_io_file_size: (_, fileId, pSize) => this.call(() => {
+				u32(pSize, this.getFile(fileId).fileSize());
+			}),
+			sqlite3_ext_io_lock: (_, fileId, locktype) => this.call(() => {
+				if (!this.getFile(fileId).lock(locktype)) {
+					return SQLiteResultCodes.SQLITE_BUSY;
+				}
+			}),
+			sqlite3_ext_io_unlock: (_, fileId, locktype) => this.call(() => {
+				this.getFile(fileId).unlock(locktype);
+			}),
+			sqlite3_ext_io_check_reserved_lock: (_, fileId, pResOut) => this.call(() => {
+				u32(pResOut, this.getFile(fileId).checkReservedLock() ? 1 : 0);
+			}),
+			sqlite3_ext_io_file_control: (_, fileId, op, pArg) => this.call(() => {
+				const file = this.getFile(fileId);
+				return file.fileControl?.(op, pArg) ?? SQLiteResultCodes.SQLITE_NOTFOUND;
+			}),
+			sqlite3_ext_io_sector_size: (_, fileId) => {
+				return this.files.get(fileId)?.sectorSize?.() ?? 4096;
+			},
+			sqlite3_ext_io_device_characteristics: (_, fileId) => {
+				return this.files.get(fileId)?.deviceCharacteristics?.() ?? 0;
+			},
+			sqlite3_ext_vfs_open: (id, zName, pOutFileId, flags, pOutFlags) => this.call(() => {
+				const name = zName === 0 ? null : this.getUtils().decodeString(zName);
+				const file = this.getVFS(id).open(name, flags);
+				const fileId = this.nextFileId++;
+				this.files.set(fileId, file);
+				u32(pOutFileId, fileId);
+				if (pOutFlags !== 0) {
+					u32(pOutFlags, flags);
+				}
+			}),
+			sqlite3_ext_vfs_delete: (id, zName, syncDir) => this.call(() => {
+				this.getVFS(id).delete(this.getUtils().decodeString(zName), syncDir !== 0);
+			}),
+			sqlite3_ext_vfs_access: (id, zName, flags, pResOut) => this.call(() => {
+				u32(pResOut, this.getVFS(id).access(this.getUtils().decodeString(zName), flags) ? 1 : 0);
+			}),
+			sqlite3_ext_vfs_full_pathname: (id, zName, nOut, zOut) => this.call(() => {
+				const utils = this.getUtils();
+				const vfs = this.getVFS(id);
+				const name = utils.decodeString(zName);
+				const path = utils.textEncoder.encode(vfs.fullPathname?.(name) ?? name);
+				if (path.length + 1 > nOut) {
+					return SQLiteResultCodes.SQLITE_CANTOPEN;
+				}
+				const u8 = utils.u8;
+				u8.set(path, zOut);
+				u8[zOut + path.length] = 0;
+			}),
+		};
+	}
+}
+
+// Header of a shared image, in Int32 slots
+const SHARED_LOCK = 0;
+const SHARED_READERS = 1;
+const SHARED_SIZE = 2;
+const SHARED_HEADER_BYTES = 64;
+
+// A database image in a SharedArrayBuffer, opened by every worker through SQLiteSharedVFS.
+// Reads copy straight out of the shared buffer without locking, writes happen under
+// SQLite's EXCLUSIVE lock which is arbitrated with Atomics on the header.
+export class SQLiteSharedImage {
+	public readonly header: Int32Array;
+	public readonly data: Uint8Array;
+
+	constructor(public readonly buffer: SharedArrayBuffer) {
+		this.header = new Int32Array(buffer, 0, SHARED_HEADER_BYTES / 4);
+		this.data = new Uint8Array(buffer, SHARED_HEADER_BYTES);
+	}
+
+	public static create(capacity: number, image?: ArrayBuffer): SQLiteSharedImage {
+		const shared = new SQLiteSharedImage(new SharedArrayBuffer(SHARED_HEADER_BYTES + capacity));
+		if (image !== undefined) {
+			if (image.byteLength > capacity) {
+				throw new SQLiteError(SQLiteResultCodes.SQLITE_FULL);
+			}
+			shared.data.set(new Uint8Array(image));
+			Atomics.store(shared.header, SHARED_SIZE, image.byteLength);
+		}
+		return shared;
+	}
+
+	public get size(): number {
+		return Atomics.load(this.header, SHARED_SIZE);
+	}
+
+	public set size(size: number) {
+		Atomics.store(this.header, SHARED_SIZE, size);
+	}
+}
+
+class SQLiteSharedFile implements SQLiteVFSFile {
+	private level: number = SQLiteLockLevels.SQLITE_LOCK_NONE;
+
+	constructor(private readonly image: SQLiteSharedImage) {
+	}
+
+	public close(): void {
+		this.unlock(SQLiteLockLevels.SQLITE_LOCK_NONE);
+	}
+
+	public read(buf: Uint8Array, offset: number): number {
+		const n = Math.max(Math.min(buf.length, this.image.size - offset), 0);
+		buf.set(this.image.data.subarray(offset, offset + n));
+		return n;
+	}
+
+	public write(buf: Uint8Array, offset: number): void {
+		const end = offset + buf.length;
+		if (end > this.image.data.length) {
+			throw new SQLiteError(SQLiteResultCodes.SQLITE_FULL);
+		}
+		this.image.data.set(buf, offset);
+		if (end > this.image.size) {
+			this.image.size = end;
+		}
+	}
+
+	public truncate(size: number): void {
+		if (size < this.image.size) {
+			this.image.size = size;
+		}
+	}
+
+	public sync(): void {
+	}
+
+	public fileSize(): number {
+		return this.image.size;
+	}
+
+	public lock(level: number): boolean {
+		const header = this.image.header;
+		if (level <= this.level) {
+			return true;
+		}
+		if (level === SQLiteLockLevels.SQLITE_LOCK_SHARED) {
+			if (Atomics.load(header, SHARED_LOCK) >= SQLiteLockLevels.SQLITE_LOCK_PENDING) {
+				return false;
+			}
+			Atomics.add(header, SHARED_READERS, 1);
+			if (Atomics.load(header, SHARED_LOCK) >= SQLiteLockLevels.SQLITE_LOCK_PENDING) {
+				Atomics.sub(header, SHARED_READERS, 1);
+				return false;
+			}
+		} else if (level === SQLiteLockLevels.SQLITE_LOCK_RESERVED) {
+			if (Atomics.compareExchange(header, SHARED_LOCK, SQLiteLockLevels.SQLITE_LOCK_NONE, level) !== SQLiteLockLevels.SQLITE_LOCK_NONE) {
+				return false;
+			}
+		} else {
+			// PENDING keeps new readers out while existing ones drain
+			if (this.level < SQLiteLockLevels.SQLITE_LOCK_RESERVED) {
+				if (Atomics.compareExchange(header, SHARED_LOCK, SQLiteLockLevels.SQLITE_LOCK_NONE, SQLiteLockLevels.SQLITE_LOCK_PENDING) !== SQLiteLockLevels.SQLITE_LOCK_NONE) {
+					return false;
+				}
+			} else {
+				Atomics.store(header, SHARED_LOCK, SQLiteLockLevels.SQLITE_LOCK_PENDING);
+			}
+			this.level = SQLiteLockLevels.SQLITE_LOCK_PENDING;
+			if (level === SQLiteLockLevels.SQLITE_LOCK_PENDING) {
+				return true;
+			}
+			if (Atomics.load(header, SHARED_READERS) > 1) {
+				return false;
+			}
+			Atomics.store(header, SHARED_LOCK, SQLiteLockLevels.SQLITE_LOCK_EXCLUSIVE);
+		}
+		this.level = level;
+		return true;
+	}
+
+	public unlock(level: number): void {
+		const header = this.image.header;
+		if (level >= this.level) {
+			return;
+		}
+		if (this.level >= SQLiteLockLevels.SQLITE_LOCK_RESERVED) {
+			Atomics.store(header, SHARED_LOCK, SQLiteLockLevels.SQLITE_LOCK_NONE);
+		}
+		if (level === SQLiteLockLevels.SQLITE_LOCK_NONE && this.level >= SQLiteLockLevels.SQLITE_LOCK_SHARED) {
+			Atomics.sub(header, SHARED_READERS, 1);
+		}
+		this.level = level;
+	}
+
+	public checkReservedLock(): boolean {
+		return Atomics.load(this.image.header, SHARED_LOCK) >= SQLiteLockLevels.SQLITE_LOCK_RESERVED;
+	}
+}
+
+// Serves the main database from a shared image. Journals and temporary files stay
+// private to the connection, so the shared image is the only copy of the data.
+export class SQLiteSharedVFS implements SQLiteVFS {
+	constructor(public readonly image: SQLiteSharedImage) {
+	}
+
+	public open(name: string | null, flags: number): SQLiteVFSFile {
+		if (name !== null && (flags & SQLiteOpenFlags.SQLITE_OPEN_MAIN_DB) !== 0) {
+			return new SQLiteSharedFile(this.image);
+		}
+		return new SQLiteMemoryFile();
+	}
+
+	public delete(): void {
+	}
+
+	public access(): boolean {
+		return false;
+	}
+}
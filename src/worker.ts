@@ -0,0 +1,380 @@
+import { SQLite, SQLiteDB, SQLiteStatement, ScalarIn } from "./sqlite";
+import { SQLiteRowWriter } from "./rows";
+import { SQLiteRing } from "./ring";
+import { SQLiteCancelToken } from "./cancel";
+import { SQLiteOpenFlags, SQLiteStatementStatus } from "./constants";
+import { SQLiteError } from "./utils";
+import { SQLiteSharedImage, SQLiteSharedVFS } from "./vfs";
+
+export interface SQLiteWorkerData {
+	module: WebAssembly.Module;
+	filename?: string;
+	image?: ArrayBuffer;
+	// database image shared by all workers, see SQLiteSharedImage
+	shared?: SharedArrayBuffer;
+	readonly?: boolean;
+	cacheSize?: number;
+}
+
+// cancel is a SQLiteCancelToken buffer, deadline an absolute Date.now() timestamp
+export interface SQLiteWorkerControl {
+	cancel?: SharedArrayBuffer;
+	deadline?: number;
+}
+
+export type SQLiteWorkerRequest = SQLiteWorkerControl & (
+	| { id: number; op: "exec"; sql: string }
+	| { id: number; op: "prepare"; sql: string }
+	| { id: number; op: "run"; stmt?: number; sql?: string; params?: ScalarIn[] }
+	| { id: number; op: "query"; stmt?: number; sql?: string; params?: ScalarIn[]; batch: number }
+	| { id: number; op: "next"; stmt: number; batch: number }
+	| { id: number; op: "stream"; stmt?: number; sql?: string; params?: ScalarIn[]; ring: SharedArrayBuffer }
+	| { id: number; op: "reset"; stmt: number }
+	| { id: number; op: "finalize"; stmt: number }
+	// committed skips the image while a transaction is open and returns undefined instead
+	| { id: number; op: "serialize"; committed?: boolean }
+	| { id: number; op: "deserialize"; data: ArrayBuffer; readonly?: boolean }
+	| { id: number; op: "close" }
+);
+
+export interface SQLiteWorkerErrorInfo {
+	code: number;
+	extendedCode?: number;
+	message: string;
+}
+
+export interface SQLiteWorkerResponse {
+	id: number;
+	version: number;
+	result?: unknown;
+	error?: SQLiteWorkerErrorInfo;
+}
+
+// sqlite3_stmt_status counters of one complete run of a statement
+export interface SQLiteStatementStats {
+	vmSteps: number;
+	fullscanSteps: number;
+	sorts: number;
+}
+
+export interface SQLiteRunResult {
+	changes: number;
+	lastInsertRowid: bigint;
+	stats: SQLiteStatementStats;
+}
+
+export interface SQLiteRowBatch {
+	stmt: number;
+	columns: string[];
+	rows: ArrayBuffer;
+	count: number;
+	done: boolean;
+	// set on the last batch
+	stats?: SQLiteStatementStats;
+}
+
+export interface SQLiteWorkerPort {
+	postMessage(message: any, transferList?: ReadonlyArray<any>): void;
+	on(event: "message", listener: (message: any) => void): unknown;
+	on(event: "error", listener: (err: Error) => void): unknown;
+	on(event: "exit", listener: (code: number) => void): unknown;
+	terminate?(): unknown;
+	close?(): unknown;
+}
+
+const SQLITE_DESERIALIZE_READONLY = 4;
+// rows are pushed into a stream ring once this many bytes are buffered, or right away if the ring is empty
+const STREAM_FLUSH_BYTES = 16384;
+
+interface WorkerStatement {
+	stmt: SQLiteStatement;
+	temporary: boolean;
+}
+
+export class SQLiteWorkerHost {
+	private readonly statements = new Map<number, WorkerStatement>();
+	private nextStmtId = 1;
+	// bumped once writes are committed, writes inside an explicit transaction wait for its end
+	public version = 0;
+	private changed = false;
+
+	constructor(public readonly db: SQLiteDB) {
+	}
+
+	public static open(data: SQLiteWorkerData): SQLiteWorkerHost {
+		const sqlite = SQLite.instantiate(data.module, false);
+		let db: SQLiteDB;
+		if (data.shared !== undefined) {
+			sqlite.registerVFS("shared", new SQLiteSharedVFS(new SQLiteSharedImage(data.shared)));
+			const flags = data.readonly
+				? SQLiteOpenFlags.SQLITE_OPEN_READONLY
+				: SQLiteOpenFlags.SQLITE_OPEN_READWRITE | SQLiteOpenFlags.SQLITE_OPEN_CREATE;
+			db = sqlite.open(data.filename ?? "shared.db", flags, "shared");
+		} else {
+			db = sqlite.open(data.filename ?? ":memory:");
+			if (data.image !== undefined) {
+				db.deserialize(data.image, "main", data.readonly ? SQLITE_DESERIALIZE_READONLY : 0);
+			}
+		}
+		if (data.cacheSize !== undefined) {
+			db.exec(`PRAGMA cache_size = ${data.cacheSize}`);
+		}
+		return new SQLiteWorkerHost(db);
+	}
+
+	private register(stmt: SQLiteStatement, temporary: boolean): number {
+		const id = this.nextStmtId++;
+		this.statements.set(id, { stmt, temporary });
+		return id;
+	}
+
+	private statement(id: number): WorkerStatement {
+		const entry = this.statements.get(id);
+		if (entry === undefined) {
+			throw new Error(`Unknown statement ${id}`);
+		}
+		return entry;
+	}
+
+	private prepareOne(sql: string): SQLiteStatement {
+		const stmt = this.db.prepare(sql);
+		if (stmt === null) {
+			throw new Error("No statement to prepare");
+		}
+		return stmt;
+	}
+
+	private bind(stmt: SQLiteStatement, params?: ScalarIn[]): void {
+		if (this.db.exports.sqlite3_stmt_readonly(stmt.pStmt) === 0) {
+			this.changed = true;
+		}
+		this.db.exports.sqlite3_reset(stmt.pStmt);
+		this.db.exports.sqlite3_clear_bindings(stmt.pStmt);
+		if (params !== undefined) {
+			stmt.bindValues(params);
+		}
+	}
+
+	private autocommit(): boolean {
+		return this.db.exports.sqlite3_get_autocommit(this.db.pDb) !== 0;
+	}
+
+	// reads and clears the counters, so prepared statements report each run separately
+	private stats(stmt: SQLiteStatement): SQLiteStatementStats {
+		return {
+			vmSteps: stmt.status(SQLiteStatementStatus.SQLITE_STMTSTATUS_VM_STEP, true),
+			fullscanSteps: stmt.status(SQLiteStatementStatus.SQLITE_STMTSTATUS_FULLSCAN_STEP, true),
+			sorts: stmt.status(SQLiteStatementStatus.SQLITE_STMTSTATUS_SORT, true),
+		};
+	}
+
+	private release(id: number): void {
+		const entry = this.statements.get(id);
+		if (entry === undefined) {
+			return;
+		}
+		// errors of the last step were already reported, so the return codes are ignored here
+		if (entry.temporary) {
+			this.statements.delete(id);
+			this.db.exports.sqlite3_finalize(entry.stmt.pStmt);
+			entry.stmt.pStmt = 0;
+		} else {
+			this.db.exports.sqlite3_reset(entry.stmt.pStmt);
+		}
+	}
+
+	private fetch(id: number, batch: number): [SQLiteRowBatch, ArrayBuffer[]] {
+		const { stmt } = this.statement(id);
+		const writer = new SQLiteRowWriter();
+		const columns: string[] = [];
+		for (let i = 0; i < stmt.columnCount(); i++) {
+			columns.push(stmt.columnName(i));
+		}
+		let done = false;
+		try {
+			while (writer.count < batch) {
+				if (!stmt.step()) {
+					done = true;
+					break;
+				}
+				writer.writeRow(stmt);
+			}
+		} catch (e) {
+			this.release(id);
+			throw e;
+		}
+		const result: SQLiteRowBatch = { stmt: id, columns, rows: writer.finish(), count: writer.count, done };
+		if (done) {
+			result.stats = this.stats(stmt);
+			this.release(id);
+		}
+		return [result, [result.rows]];
+	}
+
+	// Steps the statement into the ring until it is done or the consumer cancels.
+	// Returns the number of rows written.
+	private stream(id: number, ring: SQLiteRing): number {
+		const { stmt } = this.statement(id);
+		const writer = new SQLiteRowWriter();
+		let count = 0;
+		try {
+			const columns: string[] = [];
+			for (let i = 0; i < stmt.columnCount(); i++) {
+				columns.push(stmt.columnName(i));
+			}
+			const header = new Uint8Array(4);
+			new DataView(header.buffer).setUint32(0, columns.length, true);
+			writer.writeText(columns);
+			if (!ring.write(header) || !ring.write(writer.bytes())) {
+				return count;
+			}
+			writer.reset();
+			while (stmt.step()) {
+				writer.writeRow(stmt);
+				count++;
+				if (count === 1 || writer.length >= STREAM_FLUSH_BYTES || ring.available === 0) {
+					if (!ring.write(writer.bytes())) {
+						return count;
+					}
+					writer.reset();
+				}
+			}
+			ring.write(writer.bytes());
+		} finally {
+			ring.close();
+			this.release(id);
+		}
+		return count;
+	}
+
+	public handle(req: SQLiteWorkerRequest): [unknown, ArrayBuffer[]] {
+		switch (req.op) {
+			case "exec":
+				this.changed = true;
+				return [this.db.exec(req.sql), []];
+			case "prepare":
+				return [this.register(this.prepareOne(req.sql), false), []];
+			case "run": {
+				const id = req.stmt ?? this.register(this.prepareOne(req.sql!), true);
+				const { stmt } = this.statement(id);
+				let stats: SQLiteStatementStats;
+				try {
+					this.bind(stmt, req.params);
+					while (stmt.step()) {
+						// drain rows, run() only reports changes
+					}
+					stats = this.stats(stmt);
+				} finally {
+					this.release(id);
+				}
+				const result: SQLiteRunResult = {
+					changes: this.db.exports.sqlite3_changes(this.db.pDb),
+					lastInsertRowid: this.db.exports.sqlite3_last_insert_rowid(this.db.pDb),
+					stats,
+				};
+				return [result, []];
+			}
+			case "query": {
+				const id = req.stmt ?? this.register(this.prepareOne(req.sql!), true);
+				try {
+					this.bind(this.statement(id).stmt, req.params);
+				} catch (e) {
+					this.release(id);
+					throw e;
+				}
+				return this.fetch(id, req.batch);
+			}
+			case "next":
+				return this.fetch(req.stmt, req.batch);
+			case "stream": {
+				const ring = new SQLiteRing(req.ring);
+				let id: number | undefined;
+				try {
+					id = req.stmt ?? this.register(this.prepareOne(req.sql!), true);
+					this.bind(this.statement(id).stmt, req.params);
+				} catch (e) {
+					ring.close();
+					if (id !== undefined) {
+						this.release(id);
+					}
+					throw e;
+				}
+				return [this.stream(id, ring), []];
+			}
+			case "reset":
+				this.release(req.stmt);
+				return [undefined, []];
+			case "finalize": {
+				// the entry goes first, finalize frees the statement even when it reports the error of the last step
+				const { stmt } = this.statement(req.stmt);
+				this.statements.delete(req.stmt);
+				stmt.finalize();
+				return [undefined, []];
+			}
+			case "serialize": {
+				if (req.committed && !this.autocommit()) {
+					return [undefined, []];
+				}
+				const data = this.db.serialize();
+				if (data === null) {
+					return [null, []];
+				}
+				const buf = new Uint8Array(data).buffer;
+				return [buf, [buf]];
+			}
+			case "deserialize":
+				this.changed = true;
+				this.db.deserialize(req.data, "main", req.readonly ? SQLITE_DESERIALIZE_READONLY : 0);
+				return [undefined, []];
+			case "close":
+				// as in release(), errors of the last steps must not keep the connection open
+				for (const { stmt } of this.statements.values()) {
+					this.db.exports.sqlite3_finalize(stmt.pStmt);
+					stmt.pStmt = 0;
+				}
+				this.statements.clear();
+				this.changed = false;
+				this.db.close();
+				return [undefined, []];
+		}
+	}
+
+	public respond(req: SQLiteWorkerRequest): [SQLiteWorkerResponse, ArrayBuffer[]] {
+		const res: SQLiteWorkerResponse = { id: req.id, version: this.version };
+		let transfer: ArrayBuffer[] = [];
+		try {
+			const signal = req.cancel === undefined ? undefined : new SQLiteCancelToken(req.cancel);
+			[res.result, transfer] = this.db.interruptible({ signal, deadlineMs: req.deadline }, () => this.handle(req));
+		} catch (e) {
+			const err = e as SQLiteError;
+			res.error = {
+				code: err.code ?? 1,
+				extendedCode: err.extendedCode,
+				message: err.message,
+			};
+		}
+		if (this.changed && this.autocommit()) {
+			this.changed = false;
+			this.version++;
+		}
+		res.version = this.version;
+		return [res, transfer];
+	}
+}
+
+export function serveWorker(port: SQLiteWorkerPort, data: SQLiteWorkerData): SQLiteWorkerHost {
+	const host = SQLiteWorkerHost.open(data);
+	port.on("message", (req: SQLiteWorkerRequest) => {
+		const [res, transfer] = host.respond(req);
+		port.postMessage(res, transfer);
+	});
+	return host;
+}
+
+export async function runWorker(): Promise<SQLiteWorkerHost> {
+	const { parentPort, workerData } = await import("worker_threads");
+	if (parentPort === null) {
+		throw new Error("runWorker() must be called from a worker thread");
+	}
+	return serveWorker(parentPort, workerData as SQLiteWorkerData);
+}
@@ -1,29 +1,97 @@
 import * as fs from "fs/promises";
+import * as path from "path";
 
 import * as assert from "assert";
-import { SQLite, SQLiteResultCodes } from "../src";
+import { EventEmitter, getEventListeners } from "events";
+import { MessageChannel, Worker } from "worker_threads";
+import {
+	SQLite,
+	SQLiteDB,
+	SQLiteDatatypes,
+	SQLiteFlavors,
+	SQLiteResultCodes,
+	SQLitePool,
+	SQLitePoolOptions,
+	SQLiteBridgeChannel,
+	SQLiteBridgeVFS,
+	SQLiteCancelToken,
+	SQLiteRing,
+	SQLiteRowReader,
+	SQLiteRowWriter,
+	SQLiteScheduler,
+	SQLiteSharedImage,
+	SQLiteSharedVFS,
+	SQLiteShards,
+	SQLiteSnapshot,
+	SQLiteNativeModule,
+	SQLiteFTS5Token,
+	SQLiteFTS5TokenizeReasons,
+	searchFTS5,
+	loadRTree,
+	searchVectors,
+	searchVectorIndex,
+	SQLiteJSON,
+	SQLiteExports64,
+	SQLiteImports,
+	adaptExports64,
+	adaptImports64,
+	compileFlavor,
+	selectFlavor,
+	supportsFeature,
+	SQLiteWorkerData,
+	SQLiteWorkerDB,
+	SQLiteWorkerHost,
+	ScalarIn,
+	serveWorker,
+	yieldMacrotask,
+} from "../src";
 
-async function initModule() {
-	const wasm = await fs.readFile("./sqlite/sqlite3.wasm");
+async function initModule(filename: string = "./sqlite/sqlite3.wasm") {
+	const wasm = await fs.readFile(filename);
 	const module = await WebAssembly.compile(wasm);
 	return module;
 }
 
 const modulePromise = initModule();
+// the extension tests run against `make full`, or `make native`, which has the same extensions
+let fullModulePromise: Promise<WebAssembly.Module | SQLiteNativeModule> | undefined;
+// the memory64 marker is only defined in wasm64 builds, FTS5 and R*Tree only in `make full`
+const optionalExports = ["sqlite3_ext_memory64", "sqlite3_ext_fts5_tokenizer_register", "sqlite3_ext_rtree_load"];
+
+// SQLITE_BACKEND=native runs the SQLite tests against `make native`, workers still take the wasm module
+const backendPromise = process.env.SQLITE_BACKEND === "native"
+	? Promise.resolve(SQLiteNativeModule.load(path.resolve("./sqlite/sqlite3.node")))
+	: modulePromise;
 
 async function initSQLite() {
-	const module = await modulePromise;
+	const module = await backendPromise;
 	return await SQLite.instantiate(module);
 }
 
+async function initFullSQLite() {
+	fullModulePromise ??= process.env.SQLITE_BACKEND === "native" ? backendPromise : initModule("./sqlite/sqlite3.full.wasm");
+	return await SQLite.instantiate(await fullModulePromise);
+}
+
 async function initDb() {
 	const sqlite = await initSQLite();
 	return sqlite.open(":memory:");
 }
 
+function spawnInThread(data: SQLiteWorkerData) {
+	const { port1, port2 } = new MessageChannel();
+	serveWorker(port1, data);
+	return port2;
+}
+
+async function initPool(readers: number, options?: Partial<SQLitePoolOptions>) {
+	const module = await modulePromise;
+	return await SQLitePool.create({ module, spawn: spawnInThread, readers, ...options });
+}
+
 describe("SQLite", function () {
 	it("should support synchronous init", async function() {
-		const module = await modulePromise;
+		const module = await backendPromise;
 		const sqlite = SQLite.instantiate(module, false);
 		const db = sqlite.open(":memory:");
 		const stmt = db.prepare("SELECT SQLITE_VERSION()")!;
@@ -43,7 +111,7 @@ describe("SQLite", function () {
 	});
 
 	it("should crash on file open", async function() {
-		const module = await modulePromise;
+		const module = await backendPromise;
 		const sqlite = await SQLite.instantiate(module);
 		assert.throws(() => {
 			sqlite.open("nosuchfile");
@@ -119,7 +187,7 @@ describe("SQLite", function () {
 	});
 
 	it("should support randomness with crypto", async function() {
-		const module = await modulePromise;
+		const module = await backendPromise;
 		globalThis.crypto = {
 			getRandomValues: (x: ArrayBuffer) => require("crypto").randomFillSync(x)
 		} as any;
@@ -367,6 +435,889 @@ describe("SQLite", function () {
 		db.close();
 	});
 
+	it("should interrupt a statement past its deadline", async function() {
+		const db = await initDb();
+		const stmt = db.prepare("WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s) SELECT count(*) FROM s")!;
+		assert.throws(() => stmt.step({ deadlineMs: Date.now() + 50 }), /deadline exceeded/);
+		assert.throws(() => stmt.reset(), /interrupted/);
+		const token = new SQLiteCancelToken();
+		token.cancel();
+		assert.throws(() => stmt.step({ signal: token }), /cancelled/);
+		// a step with options of its own keeps the deadline of the enclosing call
+		stmt.reset();
+		assert.throws(() => db.interruptible({ deadlineMs: Date.now() + 50 }, () => stmt.step({ signal: new SQLiteCancelToken() })), /deadline exceeded/);
+		assert.throws(() => stmt.finalize(), /interrupted/);
+		assert.deepEqual(db.exec("SELECT 1 AS one"), [[{ name: "one", value: "1" }]]);
+		db.close();
+	});
+
+	it("should yield to the event loop in stepAsync", async function() {
+		const db = await initDb();
+		const stmt = db.prepare("WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 100) SELECT i FROM s")!;
+		let ticks = 0;
+		const timer = setInterval(() => ticks++, 0);
+		let rows = 0;
+		while (await stmt.stepAsync({ sliceMs: 0 })) {
+			rows++;
+		}
+		clearInterval(timer);
+		stmt.finalize();
+		assert.equal(rows, 100);
+		assert(ticks > 0);
+		const forever = db.prepare("WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s) SELECT count(*) FROM s")!;
+		await assert.rejects(forever.stepAsync({ deadlineMs: Date.now() + 50 }), /deadline exceeded/);
+		assert.throws(() => forever.reset(), /interrupted/);
+		// the handler of interruptible stays installed until the promise of stepAsync settles
+		await assert.rejects(db.interruptible({ deadlineMs: Date.now() + 50 }, () => forever.stepAsync()), /deadline exceeded/);
+		assert.throws(() => forever.finalize(), /interrupted/);
+		db.close();
+	});
+
+	it("should reject synchronous calls while a statement is suspended", async function() {
+		let wasm: Buffer;
+		try {
+			wasm = await fs.readFile("./sqlite/sqlite3.asyncify.wasm");
+		} catch (e) {
+			// only with `make asyncify`
+			this.skip();
+		}
+		const sqlite = await SQLite.instantiate(await WebAssembly.compile(wasm!));
+		if (sqlite.asyncify === undefined) {
+			this.skip();
+		}
+		const db = sqlite.open(":memory:");
+		const stmt = db.prepare("WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 200000) SELECT count(*) FROM s")!;
+		const counted = stmt.stepAsync({ sliceMs: 0 });
+		await yieldMacrotask();
+		assert.throws(() => db.exec("SELECT 1"), /suspendable call/);
+		assert.throws(() => stmt.step(), /suspendable call/);
+		// other connections of the instance run while it is suspended
+		const other = sqlite.open(":memory:");
+		assert.equal(other.exec("SELECT count(*) FROM (WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 100000) SELECT i FROM s)")[0][0].value, "100000");
+		other.close();
+		assert.ok(await counted);
+		assert.equal(stmt.columnInt(0), 200000);
+		stmt.finalize();
+		// a deadline set up around stepAsync holds across its slices and outlives it
+		const forever = db.prepare("WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s) SELECT count(*) FROM s")!;
+		await assert.rejects(db.interruptible({ deadlineMs: Date.now() + 50 }, () => forever.stepAsync({ sliceMs: 0 })), /deadline exceeded/);
+		assert.throws(() => forever.reset(), /interrupted/);
+		await assert.rejects(db.interruptible({ deadlineMs: Date.now() + 50 }, async () => {
+			const one = db.prepare("SELECT 1")!;
+			assert.ok(await one.stepAsync({ sliceMs: 0 }));
+			one.finalize();
+			forever.step();
+		}), /deadline exceeded/);
+		assert.throws(() => forever.finalize(), /interrupted/);
+		db.close();
+	});
+
+	describe("Pool", () => {
+		it("should route writes to the writer and reads to replicas", async function() {
+			const pool = await initPool(2);
+			await pool.exec("CREATE TABLE test (id INTEGER PRIMARY KEY, value TEXT)");
+			const result = await pool.run("INSERT INTO test (value) VALUES (?)", ["hello"]);
+			assert.equal(result.changes, 1);
+			assert.equal(result.lastInsertRowid, BigInt(1));
+			const { columns, rows } = await pool.all("SELECT id, value FROM test");
+			assert.deepEqual(columns, ["id", "value"]);
+			assert.deepEqual(rows, [[BigInt(1), "hello"]]);
+			await pool.run("INSERT INTO test (value) VALUES (?)", ["world"]);
+			const second = await pool.all("SELECT value FROM test ORDER BY id");
+			assert.deepEqual(second.rows, [["hello"], ["world"]]);
+			await pool.close();
+		});
+
+		it("should iterate in batches", async function() {
+			const pool = await initPool(1);
+			await pool.exec("CREATE TABLE test (id INTEGER PRIMARY KEY, value BLOB, score REAL)");
+			const stmt = await pool.writer.prepare("INSERT INTO test (value, score) VALUES (?, ?)");
+			for (let i = 0; i < 10; i++) {
+				await stmt.run([new Uint8Array([i]).buffer, i / 2]);
+			}
+			await stmt.finalize();
+			const seen: number[] = [];
+			for await (const [value, score] of pool.iterate("SELECT value, score FROM test ORDER BY id", [], { batch: 3 })) {
+				assert.equal(new Uint8Array(value as ArrayBuffer)[0] / 2, score);
+				seen.push(score as number);
+				if (seen.length === 5) {
+					break;
+				}
+			}
+			assert.deepEqual(seen, [0, 0.5, 1, 1.5, 2]);
+			await pool.close();
+		});
+
+		it("should only hand committed writes to readers", async function() {
+			const pool = await initPool(1);
+			await pool.exec("CREATE TABLE test (value TEXT); INSERT INTO test VALUES ('a')");
+			assert.deepEqual((await pool.all("SELECT value FROM test")).rows, [["a"]]);
+			await pool.exec("BEGIN; INSERT INTO test VALUES ('b')");
+			assert.deepEqual((await pool.all("SELECT value FROM test")).rows, [["a"]]);
+			await pool.run("INSERT INTO test VALUES (?)", ["c"]);
+			await pool.exec("COMMIT");
+			assert.deepEqual((await pool.all("SELECT value FROM test ORDER BY value")).rows, [["a"], ["b"], ["c"]]);
+			await pool.close();
+		});
+
+		it("should keep the snapshot of readers with open cursors", async function() {
+			const pool = await initPool(1);
+			await pool.exec("CREATE TABLE test (value INTEGER); INSERT INTO test VALUES (1), (2), (3)");
+			const rows = pool.iterate("SELECT value FROM test ORDER BY value", [], { batch: 1 });
+			assert.deepEqual((await rows.next()).value, [BigInt(1)]);
+			await pool.run("INSERT INTO test VALUES (4)");
+			// the only reader is in the middle of the iteration, it answers from its snapshot
+			assert.deepEqual((await pool.all("SELECT count(*) FROM test")).rows, [[BigInt(3)]]);
+			const rest: unknown[] = [];
+			for await (const [value] of rows) {
+				rest.push(value);
+			}
+			assert.deepEqual(rest, [BigInt(2), BigInt(3)]);
+			assert.deepEqual((await pool.all("SELECT count(*) FROM test")).rows, [[BigInt(4)]]);
+			await pool.close();
+		});
+
+		it("should reject with the SQLite error", async function() {
+			const pool = await initPool(0);
+			await assert.rejects(pool.all("SELECT * FROM nope"), /no such table/);
+			await pool.close();
+		});
+
+		it("should finalize temporary statements that fail to bind", async function() {
+			const host = SQLiteWorkerHost.open({ module: await modulePromise });
+			const [res] = host.respond({ id: 1, op: "query", sql: "SELECT ?", params: [{} as unknown as ScalarIn], batch: 1 });
+			assert.match(res.error!.message, /Unsupported type/);
+			assert.equal(host.db.exports.sqlite3_next_stmt(host.db.pDb, 0), 0);
+			host.db.close();
+		});
+
+		it("should forget and close statements whose last step failed", async function() {
+			const host = SQLiteWorkerHost.open({ module: await modulePromise });
+			const failing = (id: number) => {
+				const [res] = host.respond({ id, op: "prepare", sql: "SELECT abs(-9223372036854775808)" });
+				// steps behind the host, so the error is still pending when the statement is finalized
+				assert.equal(host.db.exports.sqlite3_step(host.db.exports.sqlite3_next_stmt(host.db.pDb, 0)), SQLiteResultCodes.SQLITE_ERROR);
+				return res.result as number;
+			};
+			const stmt = failing(1);
+			assert.match(host.respond({ id: 2, op: "finalize", stmt })[0].error!.message, /integer overflow/);
+			assert.match(host.respond({ id: 3, op: "next", stmt, batch: 1 })[0].error!.message, /Unknown statement/);
+			failing(4);
+			assert.equal(host.respond({ id: 5, op: "close" })[0].error, undefined);
+		});
+
+		it("should enforce timeouts and cancellation", async function() {
+			const pool = await initPool(1, { timeoutMs: 50 });
+			const forever = "WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s) SELECT count(*) FROM s";
+			await assert.rejects(pool.all(forever), /deadline exceeded/);
+			await assert.rejects(pool.exec(forever), /deadline exceeded/);
+			const controller = new AbortController();
+			controller.abort();
+			await assert.rejects(pool.all("SELECT 1", [], { signal: controller.signal }), /cancelled/);
+			assert.deepEqual((await pool.all("SELECT 1")).rows, [[BigInt(1)]]);
+			await pool.close();
+		});
+
+		it("should detach from long-lived signals once requests settle", async function() {
+			const pool = await initPool(1);
+			const { signal } = new AbortController();
+			await pool.exec("CREATE TABLE test (id INTEGER PRIMARY KEY)", { signal });
+			await pool.run("INSERT INTO test VALUES (1), (2)", [], { signal });
+			await pool.all("SELECT id FROM test", [], { signal, batch: 1 });
+			for await (const _ of pool.writer.stream("SELECT id FROM test", [], { signal })) {
+				break;
+			}
+			await assert.rejects(pool.writer.run("INSERT INTO test VALUES (1)", [], { signal }), /UNIQUE/);
+			assert.equal(getEventListeners(signal, "abort").length, 0);
+			await pool.close();
+		});
+
+		it("should reject pending requests when the worker exits", async function() {
+			const port = Object.assign(new EventEmitter(), { postMessage() {} });
+			const db = new SQLiteWorkerDB(port);
+			const pending = db.exec("SELECT 1");
+			port.emit("exit", 0);
+			await assert.rejects(pending, /exited with code 0/);
+			assert.ok(db.closed);
+			await assert.rejects(db.exec("SELECT 1"), /exited with code 0/);
+		});
+
+		it("should serve readers from a shared image", async function() {
+			const shared = SQLiteSharedImage.create(1 << 20);
+			const pool = await initPool(2, { shared, cacheSize: 16 });
+			await pool.exec("CREATE TABLE test (id INTEGER PRIMARY KEY, value TEXT)");
+			await pool.run("INSERT INTO test (value) VALUES (?)", ["hello"]);
+			assert.deepEqual((await pool.all("SELECT value FROM test")).rows, [["hello"]]);
+			await pool.run("INSERT INTO test (value) VALUES (?)", ["world"]);
+			assert.deepEqual((await pool.readers[1].all("SELECT value FROM test ORDER BY id")).rows, [["hello"], ["world"]]);
+			await assert.rejects(pool.readers[0].exec("DELETE FROM test"), /readonly/);
+			await pool.close();
+		});
+	});
+
+	describe("Scheduler", () => {
+		it("should learn costs, prioritize and preempt", async function() {
+			const pool = await initPool(1);
+			await pool.exec("CREATE TABLE test (id INTEGER PRIMARY KEY, value TEXT)");
+			await pool.run("INSERT INTO test (value) VALUES ('a'), ('b'), ('c')");
+			const scheduler = new SQLiteScheduler(pool, {
+				classes: { interactive: { priority: 0 }, batch: { priority: 1, preemptible: true } },
+			});
+			const point = "SELECT value FROM test WHERE id = ?";
+			assert.equal(scheduler.isFast(point), false);
+			assert.deepEqual((await scheduler.all(point, [1])).rows, [["a"]]);
+			assert.ok(scheduler.cost(point)!.vmSteps > 0);
+			assert.ok(scheduler.isFast(point));
+			const order: string[] = [];
+			const scan = scheduler.all("SELECT count(*) FROM test", [], { class: "batch" }).then(() => order.push("batch"));
+			const lookup = scheduler.all(point, [2], { class: "interactive" }).then(() => order.push("interactive"));
+			await Promise.all([scan, lookup]);
+			assert.deepEqual(order, ["interactive", "batch"]);
+			const metrics = scheduler.metrics();
+			assert.equal(metrics.batch.preempted, 1);
+			assert.equal(metrics.batch.completed, 1);
+			assert.equal(metrics.interactive.completed, 2);
+			await pool.close();
+		});
+
+		it("should fail preempted queries whose error was not the interrupt", async function() {
+			// a stand-in worker whose error arrives after the query was picked for preemption
+			let runs = 0;
+			const worker = {
+				all: (sql: string) => {
+					runs++;
+					if (sql === "SELECT 1") {
+						return Promise.resolve({ columns: ["1"], rows: [[BigInt(1)]] });
+					}
+					return new Promise((_, reject) => setTimeout(() => reject(new Error("no such table: nope")), 20));
+				},
+			};
+			const pool = { readers: [], writer: worker } as unknown as SQLitePool;
+			const scheduler = new SQLiteScheduler(pool, {
+				classes: { interactive: { priority: 0 }, batch: { priority: 1, preemptible: true } },
+			});
+			const failed = scheduler.all("SELECT * FROM nope", [], { class: "batch" });
+			const lookup = scheduler.all("SELECT 1", [], { class: "interactive" });
+			await assert.rejects(failed, /no such table/);
+			assert.deepEqual((await lookup).rows, [[BigInt(1)]]);
+			assert.equal(runs, 2);
+			assert.equal(scheduler.metrics().batch.preempted, 0);
+			assert.equal(scheduler.metrics().batch.failed, 1);
+		});
+
+		it("should enforce class concurrency and cancel queued queries", async function() {
+			const pool = await initPool(2);
+			const scheduler = new SQLiteScheduler(pool, {
+				classes: { batch: { priority: 1, concurrency: 1 } },
+				fastLanes: 0,
+			});
+			const controller = new AbortController();
+			const first = scheduler.all("SELECT 1");
+			const second = scheduler.all("SELECT 2", [], { signal: controller.signal });
+			assert.equal(scheduler.metrics().batch.running, 1);
+			assert.equal(scheduler.metrics().batch.queued, 1);
+			controller.abort();
+			await assert.rejects(second, /cancelled/);
+			assert.deepEqual((await first).rows, [[BigInt(1)]]);
+			await pool.close();
+		});
+	});
+
+	describe("Shards", () => {
+		it("should merge partial results across shards", async function() {
+			const module = await modulePromise;
+			const shards = await SQLiteShards.create({ module, spawn: spawnInThread, images: [undefined, undefined, undefined] });
+			await shards.exec("CREATE TABLE test (g TEXT, x INTEGER)");
+			const single = await initDb();
+			single.exec("CREATE TABLE test (g TEXT, x INTEGER)");
+			for (let i = 0; i < 30; i++) {
+				const params = [["a", "b", "c"][i % 4] ?? null, (i * 7919) % 101];
+				await shards.shards[i % 3].run("INSERT INTO test VALUES (?, ?)", params);
+				single.prepare("INSERT INTO test VALUES (?, ?)", (stmt) => {
+					stmt.bindValues(params);
+					stmt.step();
+				});
+			}
+			const expect = (sql: string) => {
+				const rows: unknown[][] = [];
+				single.prepare(sql, (stmt) => {
+					while (stmt.step()) {
+						rows.push(stmt.columns());
+					}
+				});
+				return rows;
+			};
+			const all = await shards.all("SELECT x FROM test");
+			assert.deepEqual(all.columns, ["x"]);
+			assert.equal(all.rows.length, 30);
+			const ordered = await shards.all("SELECT x, g FROM test ORDER BY x DESC", [], { orderBy: [{ column: 0, desc: true }] });
+			assert.deepEqual(ordered.rows.map((r) => r[0]), expect("SELECT x FROM test ORDER BY x DESC").map((r) => r[0]));
+			const groups = "SELECT g, count(*), sum(x), min(x), max(x) FROM test GROUP BY g ORDER BY g";
+			const grouped = await shards.all(groups, [], { aggregates: { 1: "count", 2: "sum", 3: "min", 4: "max" } });
+			assert.deepEqual(grouped.rows, expect(groups));
+			const limited = await shards.all("SELECT x FROM test ORDER BY x", [], { orderBy: [0], limit: 3 });
+			assert.deepEqual(limited.rows, expect("SELECT x FROM test ORDER BY x LIMIT 3"));
+			single.close();
+			await shards.close();
+		});
+	});
+
+	describe("Ring", () => {
+		it("should wrap around and cancel", async function() {
+			const ring = SQLiteRing.create(64);
+			const bytes = new Uint8Array(40).map((_, i) => i);
+			for (let i = 0; i < 3; i++) {
+				assert(ring.write(bytes));
+				assert.deepEqual(ring.tryRead(), bytes);
+			}
+			assert.equal(ring.tryRead(), null);
+			assert(ring.write(new Uint8Array(64)));
+			ring.cancel();
+			assert.equal(ring.write(new Uint8Array(1)), false);
+		});
+
+		it("should decode rows split across chunks", async function() {
+			const writer = new SQLiteRowWriter();
+			writer.writeText(["a", "b"]);
+			writer.writeText(["hello", "world"]);
+			const rows = writer.finish();
+			const stream = new Uint8Array(4 + rows.byteLength);
+			new DataView(stream.buffer).setUint32(0, 2, true);
+			stream.set(new Uint8Array(rows), 4);
+			const reader = new SQLiteRowReader();
+			const seen: unknown[] = [];
+			for (let i = 0; i < stream.length; i += 3) {
+				reader.push(stream.subarray(i, i + 3));
+				seen.push(...reader.rows());
+			}
+			assert.deepEqual(reader.columns, ["a", "b"]);
+			assert.deepEqual(seen, [["hello", "world"]]);
+		});
+
+		it("should stream rows from a worker", async function() {
+			const pool = await initPool(1);
+			await pool.exec(`
+				CREATE TABLE test (id INTEGER PRIMARY KEY, value TEXT);
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 2000)
+				INSERT INTO test (value) SELECT 'row ' || i FROM s;
+			`);
+			let count = 0;
+			for await (const [id, value] of pool.stream("SELECT id, value FROM test ORDER BY id", [], { noBigInt: true })) {
+				count++;
+				assert.equal(value, `row ${id}`);
+			}
+			assert.equal(count, 2000);
+			for await (const [id] of pool.stream("SELECT id FROM test WHERE id > ?", [1990])) {
+				assert.equal(id, BigInt(1991));
+				break;
+			}
+			await assert.rejects(async () => {
+				for await (const _ of pool.stream("SELECT * FROM nope")) {
+					// unreachable
+				}
+			}, /no such table/);
+			await pool.close();
+		});
+	});
+
+	describe("VFS", () => {
+		it("should spill sorts to temporary files", async function() {
+			const db = await initDb();
+			db.exec("PRAGMA cache_size = 8");
+			db.exec(`
+				CREATE TABLE test (value TEXT);
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 5000)
+				INSERT INTO test SELECT hex(randomblob(32)) FROM s;
+				CREATE INDEX test_value ON test (value);
+			`);
+			const [[{ value }]] = db.exec("SELECT count(*) FROM (SELECT value FROM test ORDER BY value DESC)");
+			assert.equal(value, "5000");
+			db.close();
+		});
+
+		it("should bridge to an async backend in another thread", async function() {
+			const channel = SQLiteBridgeChannel.create(4096);
+			const host = new Worker("./scripts/bridge-host.ts", { workerData: { channel: channel.buffer } });
+			await new Promise((resolve) => host.once("message", resolve));
+			const sqlite = await initSQLite();
+			sqlite.registerVFS("bridge", new SQLiteBridgeVFS(channel.buffer));
+			const db = sqlite.open("test.db", undefined, "bridge");
+			db.exec("CREATE TABLE test (value TEXT); INSERT INTO test VALUES (hex(randomblob(8192)))");
+			db.close();
+			const reopened = sqlite.open("test.db", undefined, "bridge");
+			assert.deepEqual(reopened.exec("SELECT length(value) AS n FROM test"), [[{ name: "n", value: "16384" }]]);
+			reopened.close();
+			await host.terminate();
+		});
+
+		it("should share an image between instances", async function() {
+			const image = SQLiteSharedImage.create(1 << 20);
+			const [a, b] = await Promise.all([initSQLite(), initSQLite()]);
+			a.registerVFS("shared", new SQLiteSharedVFS(image));
+			const writer = a.open("test.db", undefined, "shared");
+			b.registerVFS("shared", new SQLiteSharedVFS(image));
+			const reader = b.open("test.db", undefined, "shared");
+			writer.exec("CREATE TABLE test (value INTEGER); INSERT INTO test VALUES (1), (2)");
+			assert.deepEqual(reader.exec("SELECT sum(value) AS total FROM test"), [[{ name: "total", value: "3" }]]);
+			writer.exec("BEGIN EXCLUSIVE");
+			assert.throws(() => reader.exec("SELECT * FROM test"), /locked/);
+			writer.exec("INSERT INTO test VALUES (3); COMMIT");
+			assert.deepEqual(reader.exec("SELECT sum(value) AS total FROM test"), [[{ name: "total", value: "6" }]]);
+			assert(image.size > 0);
+			writer.close();
+			reader.close();
+		});
+	});
+
+	describe("Loader", () => {
+		it("should fall back to a flavor that can be loaded", async function() {
+			assert.equal(selectFlavor(["nope", "default"]), SQLiteFlavors.default);
+			assert.equal(selectFlavor(["fast", "default"]), SQLiteFlavors.fast);
+			assert.equal(selectFlavor(), [SQLiteFlavors.simd, SQLiteFlavors.features].find((f) => f.supported()) ?? SQLiteFlavors.default);
+			assert.ok(supportsFeature("bulkMemory"));
+			// only the default flavor is built for the tests
+			const requested: string[] = [];
+			const read = async (filename: string) => {
+				requested.push(filename);
+				if (filename !== "sqlite3.wasm") {
+					throw new Error(`${filename} not shipped`);
+				}
+				return await fs.readFile("./sqlite/sqlite3.wasm");
+			};
+			const { flavor } = await compileFlavor(read);
+			assert.equal(flavor, SQLiteFlavors.default);
+			assert.equal(requested[0], selectFlavor().filename);
+			assert.equal(requested[requested.length - 1], "sqlite3.wasm");
+			const sqlite = await SQLite.load(read);
+			assert.equal(sqlite.open(":memory:").exec("SELECT 'ok'")[0][0].value, "ok");
+		});
+		it("should only list exports of the full build for the trimmed flavor", async function() {
+			const exported = new Set(WebAssembly.Module.exports(await modulePromise).map((e) => e.name));
+			const lists = await fs.readdir("./sqlite/exports");
+			for (const list of lists) {
+				const names = (await fs.readFile(`./sqlite/exports/${list}`, "utf-8")).split("\n").filter((line) => line !== "" && !line.startsWith("#"));
+				const missing = names.filter((name) => !exported.has(name) && !optionalExports.includes(name));
+				assert.deepEqual(missing, [], list);
+			}
+		});
+		it("should define every export src/ calls in the native addon", async function() {
+			if (process.env.SQLITE_BACKEND !== "native") {
+				this.skip();
+			}
+			const sqlite = await initSQLite();
+			const core = (await fs.readFile("./sqlite/exports/core.txt", "utf-8")).split("\n").filter((line) => line !== "" && !line.startsWith("#"));
+			const missing = core.filter((name) => typeof (sqlite.exports as unknown as Record<string, unknown>)[name] !== "function" && !optionalExports.includes(name));
+			assert.deepEqual(missing, []);
+			assert.equal(sqlite.utils.decodeString(sqlite.exports.sqlite3_libversion()), "3.37.2");
+		});
+		it("should convert pointers at the memory64 boundary", async function() {
+			const exports = adaptExports64({
+				sqlite3_malloc: (n: number) => BigInt(n) * 2n,
+				sqlite3_prepare_v2: (...args: unknown[]) => args.map((a) => typeof a).join(),
+				sqlite3_libversion_number: () => 3037002,
+			} as unknown as SQLiteExports64);
+			assert.equal(exports.sqlite3_malloc(8), 16);
+			assert.equal(exports.sqlite3_prepare_v2(1, 2, -1, 3, 4), "bigint,bigint,number,bigint,bigint");
+			assert.equal(exports.sqlite3_libversion_number(), 3037002);
+			const imports = adaptImports64({
+				sqlite3_ext_exec_callback: (...args: unknown[]) => args.filter((a) => typeof a === "number").length,
+			} as unknown as SQLiteImports) as unknown as Record<string, (...args: unknown[]) => unknown>;
+			assert.equal(imports.sqlite3_ext_exec_callback(0, 2, 8n, 24n), 4);
+			const sqlite = await initSQLite();
+			assert.equal(sqlite.utils.pointerSize, 4);
+			const ptr = sqlite.utils.malloc(8);
+			sqlite.utils.i64[ptr / 8] = -2n;
+			assert.equal(sqlite.utils.deref64(ptr), -2n);
+			sqlite.utils.free(ptr);
+		});
+	});
+
+	describe("JSON", () => {
+		it("should return JSON columns parsed lazily", async function() {
+			const sqlite = await initSQLite();
+			const db = sqlite.open(":memory:");
+			db.exec(`
+				CREATE TABLE docs (id INTEGER PRIMARY KEY, data JSON, note TEXT);
+				INSERT INTO docs (data, note) VALUES (json_object('a', 1, 'b', json_array(2, 3)), '{"not": "json"}'), (NULL, 'x');
+			`);
+			assert.equal(db.exec("SELECT json_extract(data, '$.b[1]') FROM docs WHERE id = 1")[0][0].value, "3");
+			db.prepare("SELECT data, note FROM docs ORDER BY id", (stmt) => {
+				assert.ok(stmt.step());
+				const [data, note] = stmt.columns(false, true);
+				assert.ok(data instanceof SQLiteJSON);
+				assert.equal(data.text, "{\"a\":1,\"b\":[2,3]}");
+				assert.deepEqual(data.value, { a: 1, b: [2, 3] });
+				assert.equal(note, "{\"not\": \"json\"}");
+				assert.equal(JSON.stringify({ data }), "{\"data\":{\"a\":1,\"b\":[2,3]}}");
+				assert.ok(stmt.step());
+				assert.deepEqual(stmt.columns(false, true), [null, "x"]);
+				assert.equal(stmt.columnJSON(0), null);
+			});
+		});
+		it("should write result sets as JSON text", async function() {
+			const sqlite = await initSQLite();
+			const db = sqlite.open(":memory:");
+			db.exec(`
+				CREATE TABLE t (i INTEGER, r REAL, s TEXT, j JSON);
+				INSERT INTO t VALUES (1, 0.1, 'quote " slash \\ tab \t nul' || char(1) || ' é', '[1,{"x":true}]'), (9007199254740993, 1e300, NULL, NULL);
+			`);
+			const rows = [
+				{ i: 1, r: 0.1, s: "quote \" slash \\ tab \t nul\u0001 é", j: [1, { x: true }] },
+				{ i: 9007199254740992, r: 1e300, s: null, j: null },
+			];
+			db.prepare("SELECT * FROM t", (stmt) => {
+				const text = stmt.resultJSON();
+				assert.deepEqual(JSON.parse(text), rows);
+				assert.ok(text.includes("9007199254740993"));
+				stmt.reset();
+				assert.deepEqual(JSON.parse(stmt.resultJSON(true)), rows.map((row) => Object.values(row)));
+			});
+			db.prepare("SELECT * FROM t WHERE 0", (stmt) => {
+				assert.equal(stmt.resultJSON(), "[]");
+			});
+			db.prepare("SELECT x'00'", (stmt) => {
+				assert.throws(() => stmt.resultJSON(), /BLOB/);
+			});
+			const stmt = db.prepare("SELECT abs(-9223372036854775807 - 1)")!;
+			assert.throws(() => stmt.resultJSON(), /overflow/);
+			// finalize reports the error of the last step again
+			assert.throws(() => stmt.finalize(), /overflow/);
+		});
+	});
+
+	describe("Maintenance", () => {
+		it("should keep planner statistics fresh and carry them across serialize", async function() {
+			const sqlite = await initSQLite();
+			const db = sqlite.open(":memory:");
+			const maintenance = db.scheduleMaintenance({ idleMs: 0, bulkChanges: 1000 });
+			db.exec(`
+				CREATE TABLE t (a INTEGER, b INTEGER);
+				CREATE INDEX t_a ON t (a);
+				CREATE INDEX t_b ON t (b);
+			`);
+			assert.equal(maintenance.afterBulkLoad(["t"]), false);
+			// half of the rows share a = 0, every other a is unique, which sqlite_stat1 averages away
+			db.exec(`
+				WITH RECURSIVE s(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM s WHERE i < 10000)
+				INSERT INTO t SELECT CASE WHEN i % 2 = 0 THEN 0 ELSE i END, i % 100 FROM s
+			`);
+			assert.equal(maintenance.pendingChanges, 10000);
+			assert.ok(maintenance.afterBulkLoad(["t"]));
+			assert.equal(maintenance.pendingChanges, 0);
+			const plan = (db: SQLiteDB) => db.exec("EXPLAIN QUERY PLAN SELECT * FROM t WHERE a = 0 AND b = 5").map((row) => row[3].value).join();
+			const stat4 = maintenance.analysisLimit === 0;
+			if (stat4) {
+				// the sqlite_stat4 samples show a = 0 matches half of the table
+				assert.match(plan(db), /INDEX t_b/);
+			}
+			const stats = db.exec("SELECT count(*) FROM sqlite_stat1")[0][0].value;
+			assert.notEqual(stats, "0");
+			// serialize only optimizes when asked to, and never inside a transaction
+			db.exec("BEGIN; INSERT INTO t VALUES (1, 1)");
+			db.serialize("main", 0, true);
+			assert.equal(maintenance.pendingChanges, 1);
+			db.exec("COMMIT");
+			db.serialize();
+			assert.equal(maintenance.pendingChanges, 1);
+			const image = db.serialize("main", 0, true)!;
+			assert.equal(maintenance.pendingChanges, 0);
+			db.close();
+			const copy = sqlite.open(":memory:");
+			copy.deserialize(image);
+			assert.equal(copy.exec("SELECT count(*) FROM sqlite_stat1")[0][0].value, stats);
+			if (stat4) {
+				assert.match(plan(copy), /INDEX t_b/);
+			}
+			copy.close();
+		});
+		it("should optimize once the connection goes idle", async function() {
+			const sqlite = await initSQLite();
+			const db = sqlite.open(":memory:");
+			const maintenance = db.scheduleMaintenance({ idleMs: 10 });
+			db.exec("CREATE TABLE t (a INTEGER); INSERT INTO t VALUES (1), (2)");
+			assert.equal(maintenance.pendingChanges, 2);
+			await new Promise((resolve) => setTimeout(resolve, 50));
+			assert.equal(maintenance.pendingChanges, 0);
+			db.close();
+		});
+	});
+
+	describe("Extensions", () => {
+		it("should register the ext/misc functions on every connection", async function() {
+			const sqlite = await initFullSQLite();
+			const db = sqlite.open(":memory:");
+			const value = (sql: string) => db.exec(sql)[0][0].value;
+			assert.equal(value("SELECT sqrt(16) + log10(100) + pow(2, 3)"), "14.0");
+			assert.equal(value("SELECT group_concat(value) FROM generate_series(1, 10, 3)"), "1,4,7,10");
+			assert.equal(value("SELECT median(value) FROM generate_series(1, 4)"), "2.5");
+			assert.equal(value("SELECT percentile(value, 90) FROM generate_series(1, 11)"), "10.0");
+			assert.equal(value("SELECT percentile(value, 50) FROM generate_series(1, 0)"), null);
+			assert.throws(() => db.exec("SELECT percentile('x', 50)"), /not numeric/);
+			assert.equal(value("SELECT count(*) FROM generate_series(1, 100) WHERE value REGEXP '^[1-3]0?$'"), "6");
+			assert.equal(value("SELECT decimal_add('0.1', '0.2')"), "0.3");
+			assert.equal(value("SELECT decimal_sum(value) FROM (SELECT '0.1' AS value FROM generate_series(1, 10))"), "1.0");
+			db.close();
+			// connections opened later get the functions too
+			const other = sqlite.open(":memory:");
+			assert.equal(other.exec("SELECT median(value) FROM generate_series(1, 3)")[0][0].value, "2.0");
+			other.close();
+		});
+
+		it("should approximate aggregates and merge their sketches", async function() {
+			const sqlite = await initFullSQLite();
+			const db = sqlite.open(":memory:");
+			const value = (sql: string) => db.exec(sql)[0][0].value;
+			db.exec(`CREATE TABLE t(shard, x, y);
+				WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < 19999)
+				INSERT INTO t SELECT i % 4, i % 5000, CASE WHEN i % 10 < 5 THEN 'a' WHEN i % 10 < 8 THEN 'b' ELSE 'c' || i END FROM n;`);
+			const distinct = Number(value("SELECT approx_count_distinct(x) FROM t"));
+			assert.ok(Math.abs(distinct - 5000) < 250, `${distinct}`);
+			assert.equal(value("SELECT approx_count_distinct(v) FROM (SELECT 1 AS v UNION ALL SELECT 1.0 UNION ALL SELECT '1')"), "2");
+			const median = Number(value("SELECT approx_percentile(x, 0.5) FROM t"));
+			assert.ok(Math.abs(median - 2500) < 50, `${median}`);
+			assert.equal(value("SELECT approx_percentile(x, 1) FROM t"), "4999.0");
+			assert.equal(value("SELECT approx_percentile(x, 0.5) FROM t WHERE 0"), null);
+			assert.throws(() => db.exec("SELECT approx_percentile(x, 50) FROM t"), /between 0.0 and 1.0/);
+			// counts of the count-min sketch are upper bounds
+			const top = JSON.parse(value("SELECT approx_top_k(y, 2) FROM t")!) as { value: string, count: number }[];
+			assert.deepEqual(top.map((row) => row.value), ["a", "b"]);
+			assert.ok(top[0].count >= 10000 && top[0].count < 10100 && top[1].count >= 6000 && top[1].count < 6100, JSON.stringify(top));
+			// per shard sketches merge into the same results
+			db.exec(`CREATE TABLE rollup AS SELECT shard, hll_sketch(x) AS hll, tdigest_sketch(x) AS digest, topk_sketch(y, 2) AS topk FROM t GROUP BY shard`);
+			assert.equal(value("SELECT hll_count(hll_merge(hll)) FROM rollup"), String(distinct));
+			const merged = Number(value("SELECT tdigest_percentile(tdigest_merge(digest), 0.5) FROM rollup"));
+			assert.ok(Math.abs(merged - 2500) < 50, `${merged}`);
+			assert.deepEqual(JSON.parse(value("SELECT topk_values(topk_merge(topk), 1) FROM rollup")!), [top[0]]);
+			assert.throws(() => db.exec("SELECT hll_count(x'00')"), /hll_sketch/);
+			const corrupt = (sql: string, sketch: DataView, message: RegExp) => assert.throws(() => db.prepare(sql, (stmt) => {
+				stmt.bindBlob(1, sketch.buffer);
+				stmt.step();
+			}), (e: { code: number, message: string }) => e.code === SQLiteResultCodes.SQLITE_CORRUPT && message.test(e.message));
+			// a forged centroid count whose size would overflow an int
+			const forged = new DataView(new ArrayBuffer(64));
+			new Uint8Array(forged.buffer).set([0x54, 0x44, 1]);
+			forged.setFloat64(4, 100, true);
+			forged.setInt32(28, 0x10000002, true);
+			corrupt("SELECT tdigest_percentile(tdigest_merge(?), 0.5)", forged, /tdigest_sketch/);
+			// more centroids than the merge allocates, with weights that never merge
+			const weightless = new DataView(new ArrayBuffer(32 + 700 * 16));
+			new Uint8Array(weightless.buffer).set([0x54, 0x44, 1]);
+			weightless.setFloat64(4, 100, true);
+			weightless.setInt32(28, 700, true);
+			for (let i = 0; i < 700; i++) {
+				weightless.setFloat64(32 + i * 16, i, true);
+				weightless.setFloat64(40 + i * 16, NaN, true);
+			}
+			corrupt("SELECT tdigest_percentile(tdigest_merge(?), 0.5)", weightless, /tdigest_sketch/);
+			// an INTEGER candidate shorter than the 8 bytes it is read as
+			const short = new DataView(new ArrayBuffer(24 + 4 * 512 * 8 + 9));
+			new Uint8Array(short.buffer).set([0x54, 0x4b, 2]);
+			short.setInt32(4, 1, true);
+			short.setInt32(8, 1, true);
+			short.setBigInt64(16, 1n, true);
+			short.setInt32(24 + 4 * 512 * 8, SQLiteDatatypes.SQLITE_INTEGER, true);
+			short.setInt32(28 + 4 * 512 * 8, 1, true);
+			corrupt("SELECT topk_values(?)", short, /topk_sketch/);
+			db.close();
+		});
+	});
+
+	describe("FTS5", () => {
+		it("should search with a JS tokenizer", async function() {
+			const sqlite = await initFullSQLite();
+			const db = sqlite.open(":memory:");
+			const reasons: number[] = [];
+			db.createTokenizer("words", (text, reason) => {
+				reasons.push(reason);
+				const tokens: SQLiteFTS5Token[] = [];
+				for (const m of text.matchAll(/[^\s,.]+/g)) {
+					const term = m[0].toLowerCase();
+					tokens.push({ term, start: m.index!, end: m.index! + m[0].length });
+					if (term === "crème") {
+						tokens.push({ term: "cream", start: m.index!, end: m.index! + m[0].length, colocated: true });
+					}
+				}
+				return tokens;
+			});
+			db.exec(`
+				CREATE VIRTUAL TABLE docs USING fts5(title, body, tokenize = 'words');
+				INSERT INTO docs (rowid, title, body) VALUES
+					(1, 'Desserts', 'Café crème brûlée, with more crème on top.'),
+					(2, 'Drinks', 'Café au lait and a crème de menthe.'),
+					(3, 'Mains', 'Nothing sweet here.');
+			`);
+			assert.ok(reasons.includes(SQLiteFTS5TokenizeReasons.DOCUMENT));
+			const matches = searchFTS5(db, "docs", "cream", {
+				columns: ["title"],
+				highlight: { column: 1, open: "[", close: "]" },
+				snippet: { column: 1, open: "<", close: ">", ellipsis: "...", tokens: 3 },
+			});
+			assert.deepEqual(matches.map((m) => m.rowid), [1, 2]);
+			assert.ok(matches[0].rank < matches[1].rank);
+			assert.deepEqual(matches[0].values, ["Desserts"]);
+			// offsets of the non-ASCII text come back as whole characters
+			assert.equal(matches[0].highlight, "Café [crème] brûlée, with more [crème] on top.");
+			assert.equal(matches[1].snippet, "...a <crème> de...");
+			assert.deepEqual(searchFTS5(db, "docs", "title:drinks OR brûlée", { limit: 1, offset: 1 }).map((m) => m.rowid), [2]);
+			assert.ok(reasons.includes(SQLiteFTS5TokenizeReasons.QUERY));
+			assert.throws(() => db.exec("SELECT * FROM docs WHERE docs MATCH 'a'; CREATE VIRTUAL TABLE t2 USING fts5(x, tokenize = 'nope')"));
+		});
+	});
+
+	describe("R*Tree", () => {
+		it("should bulk load boxes and query them", async function() {
+			const sqlite = await initFullSQLite();
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE VIRTUAL TABLE boxes USING rtree(id, minX, maxX, minY, maxY)");
+			const rows = new Float64Array(100 * 5);
+			for (let i = 0; i < 100; i++) {
+				rows.set([i + 1, i, i + 0.5, -i, -i + 0.5], i * 5);
+			}
+			loadRTree(db, "boxes", rows, 2);
+			assert.equal(db.exec("SELECT count(*) FROM boxes")[0][0].value, "100");
+			const hits = db.exec("SELECT id FROM boxes WHERE maxX >= 10 AND minX <= 12 AND maxY >= -12 AND minY <= -10 ORDER BY id");
+			assert.deepEqual(hits.map((row) => row[0].value), ["11", "12", "13"]);
+			// a duplicate id fails the whole load
+			assert.throws(() => loadRTree(db, "boxes", new Float64Array([1000, 0, 1, 0, 1, 1, 0, 1, 0, 1]), 2), /UNIQUE/);
+			assert.equal(db.exec("SELECT count(*) FROM boxes")[0][0].value, "100");
+			assert.throws(() => loadRTree(db, "boxes", new Float64Array(4), 2));
+			for (const id of [NaN, Infinity, 2 ** 63, 1.5]) {
+				assert.throws(() => loadRTree(db, "boxes", new Float64Array([id, 0, 1, 0, 1]), 2), /64-bit integer/);
+			}
+			assert.equal(db.exec("SELECT count(*) FROM boxes")[0][0].value, "100");
+			db.exec("CREATE VIRTUAL TABLE shapes USING geopoly(name)");
+			db.exec("INSERT INTO shapes (_shape, name) VALUES ('[[0,0],[2,0],[2,2],[0,2],[0,0]]', 'square')");
+			assert.equal(db.exec("SELECT name FROM shapes WHERE geopoly_contains_point(_shape, 1, 1)")[0][0].value, "square");
+		});
+	});
+
+	describe("Vectors", () => {
+		it("should bind Float32Array vectors", async function() {
+			const db = await initDb();
+			const utils = db.utils;
+			db.prepare("SELECT ?, length(?)", (stmt) => {
+				const vector = new Float32Array([1.5, -2, 3.25]);
+				stmt.bindValues([vector, vector.subarray(1)]);
+				assert.ok(stmt.step());
+				assert.deepEqual(Array.from(stmt.columnFloat32Array(0)), [1.5, -2, 3.25]);
+				assert.equal(stmt.columnInt(1), 8);
+				// a view into the heap is bound without a copy
+				const ptr = utils.malloc(8);
+				const view = new Float32Array(db.exports.memory.buffer, ptr, 2);
+				view.set([4, 5]);
+				stmt.reset();
+				stmt.bindFloat32Array(1, view);
+				assert.ok(stmt.step());
+				assert.deepEqual(Array.from(stmt.columnFloat32Array(0)), [4, 5]);
+				stmt.reset();
+				utils.free(ptr);
+			});
+			db.close();
+		});
+
+		it("should search vectors by scan and with an IVF index", async function() {
+			const sqlite = await initFullSQLite();
+			const db = sqlite.open(":memory:");
+			const value = (sql: string, params: Float32Array[]) => {
+				const stmt = db.prepare(sql)!;
+				try {
+					stmt.bindValues(params);
+					stmt.step();
+					return stmt.columnValue(0);
+				} finally {
+					stmt.finalize();
+				}
+			};
+			const a = new Float32Array([1, 2, 3, 4, 5]);
+			const b = new Float32Array([5, 4, 3, 2, 1]);
+			assert.equal(value("SELECT vec_dot(?, ?)", [a, b]), 35);
+			assert.equal(value("SELECT vec_l2(?, ?)", [a, b]), Math.sqrt(40));
+			assert.ok(Math.abs((value("SELECT vec_cosine(?, ?)", [a, b]) as number) - 35 / 55) < 1e-6);
+			assert.throws(() => value("SELECT vec_dot(?, ?)", [a, b.subarray(1)]), /same length/);
+
+			let seed = 7;
+			const random = () => (seed = seed * 48271 % 0x7fffffff) / 0x7fffffff - 0.5;
+			const vectors = Array.from({ length: 2000 }, () => Float32Array.from({ length: 16 }, random));
+			db.exec("CREATE TABLE docs (id INTEGER PRIMARY KEY, embedding BLOB)");
+			db.exec("CREATE VIRTUAL TABLE items USING vec_ivf(dimensions=16, lists=16, metric=cosine)");
+			db.exec("BEGIN");
+			for (const table of ["docs(id, embedding)", "items(rowid, vector)"]) {
+				db.prepare(`INSERT INTO ${table} VALUES (?, ?)`, (stmt) => {
+					vectors.forEach((vector, i) => {
+						stmt.bindInt(1, i + 1);
+						stmt.bindFloat32Array(2, vector);
+						stmt.step();
+						stmt.reset();
+					});
+				});
+			}
+			db.exec("COMMIT");
+
+			const query = vectors[42];
+			const cosine = (v: Float32Array) => {
+				let dot = 0, nq = 0, nv = 0;
+				v.forEach((x, i) => { dot += x * query[i]; nq += query[i] * query[i]; nv += x * x; });
+				return 1 - dot / Math.sqrt(nq * nv);
+			};
+			const exact = vectors.map((v, i) => ({ rowid: i + 1, distance: cosine(v) })).sort((x, y) => x.distance - y.distance).slice(0, 5);
+			const ids = (matches: { rowid: number }[]) => matches.map((m) => m.rowid);
+			const scanned = searchVectors(db, "docs", "embedding", query, { k: 5, metric: "cosine" });
+			assert.deepEqual(ids(scanned), ids(exact));
+			assert.ok(Math.abs(scanned[1].distance - exact[1].distance) < 1e-6);
+			assert.throws(() => searchVectors(db, "docs", "embedding", a), /vec_topk\(\) found 64 bytes in row 1, the query has 20/);
+
+			// untrained, every row is in list -1
+			assert.deepEqual(ids(searchVectorIndex(db, "items", query, { k: 5 })), ids(exact));
+			db.exec("INSERT INTO items(items) VALUES ('train')");
+			assert.equal(db.exec("SELECT count(*) FROM items_centroids")[0][0].value, "16");
+			assert.equal(db.exec("SELECT count(*) FROM items_lists WHERE list = -1")[0][0].value, "0");
+			// probing every list is exact, fewer lists scan fewer rows
+			assert.deepEqual(ids(searchVectorIndex(db, "items", query, { k: 5, probes: 16 })), ids(exact));
+			const probed = searchVectorIndex(db, "items", query, { k: 5, probes: 2 });
+			assert.equal(probed.length, 5);
+			assert.equal(probed[0].rowid, 43);
+			db.exec("DELETE FROM items WHERE rowid = 43");
+			assert.notEqual(searchVectorIndex(db, "items", query, { k: 1 })[0].rowid, 43);
+			assert.equal(db.exec("SELECT count(*) FROM items")[0][0].value, "1999");
+			db.prepare("SELECT vector FROM items WHERE rowid = 7", (stmt) => {
+				assert.ok(stmt.step());
+				assert.deepEqual(stmt.columnFloat32Array(0), vectors[6]);
+			});
+			assert.throws(() => db.exec("INSERT INTO items(items) VALUES ('nope')"), /unknown vec_ivf command/);
+			assert.throws(() => db.exec("INSERT INTO items(vector) VALUES (x'00')"), /16 float32s/);
+			// a corrupted vector in the shadow table fails searches and training instead of being read past
+			db.exec("UPDATE items_lists SET vector = x'0000' WHERE id = 7");
+			assert.throws(() => searchVectorIndex(db, "items", query, { k: 5, probes: 16 }), /items has a vector of the wrong size in row 7/);
+			assert.throws(() => db.exec("INSERT INTO items(items) VALUES ('train')"), /items has a vector of the wrong size in row 7/);
+			db.close();
+		});
+	});
+
+	describe("Snapshot", () => {
+		it("should restore instances with template databases and statements", async function() {
+			const module = await modulePromise;
+			const sqlite = await SQLite.instantiate(module);
+			const db = sqlite.open(":memory:");
+			db.exec("CREATE TABLE kv (k TEXT PRIMARY KEY, v INTEGER); INSERT INTO kv VALUES ('a', 1)");
+			const stmt = db.prepare("SELECT v FROM kv WHERE k = ?")!;
+			const snapshot = SQLiteSnapshot.capture(module, sqlite, { databases: [db], statements: [stmt] });
+			assert.ok(snapshot.byteLength > 0);
+			const first = await snapshot.instantiate();
+			const second = snapshot.instantiate(false);
+			first.databases[0].exec("UPDATE kv SET v = 2");
+			for (const [restored, v] of [[first, 2], [second, 1]] as const) {
+				const s = restored.statements[0];
+				s.bindValues(["a"]);
+				assert.ok(s.step());
+				assert.equal(s.columnValue(0), v);
+				s.reset();
+			}
+			assert.equal(db.exec("SELECT v FROM kv")[0][0].value, "1");
+			const random = (db: typeof first.databases[0]) => db.exec("SELECT hex(randomblob(16))")[0][0].value;
+			assert.notEqual(random(first.databases[0]), random(second.databases[0]));
+		});
+	});
+
 	describe("Utilities", () => {
 		it("should handle noop checkError", async function() {
 			const sqlite = await initSQLite();